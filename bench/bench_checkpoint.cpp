@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include "checkpoint/snapshot.hpp"
+#include "orders/order_queue.hpp"
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    /// @brief Book of resting orders spread over a few hundred price levels per side.
+    void fill_book(orders::order_queue &book, int64_t count)
+    {
+        for (int64_t i = 0; i < count; ++i)
+        {
+            const bool is_buy = i % 2 == 0;
+            const double price = is_buy ? 100.0 - static_cast<double>(i % 500) * 0.01 : 100.01 + static_cast<double>(i % 500) * 0.01;
+            book.emplace(order_event{0, static_cast<order_id>(i + 1), 10, is_buy, price, order_type::Limit, order_flags::None,
+                                     std::chrono::system_clock::time_point{std::chrono::milliseconds{i}}});
+        }
+    }
+
+    /// @brief Snapshot a large resting book to memory.
+    void BM_BookSave(benchmark::State &state)
+    {
+        orders::order_queue book;
+        fill_book(book, state.range(0));
+        for (auto _ : state)
+        {
+            checkpoint::snapshot_writer out;
+            book.save(out);
+            benchmark::DoNotOptimize(out.bytes().data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BookSave)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    /// @brief Rebuild a large resting book, with its back index, from a snapshot in memory.
+    void BM_BookRestore(benchmark::State &state)
+    {
+        orders::order_queue book;
+        fill_book(book, state.range(0));
+        checkpoint::snapshot_writer out;
+        book.save(out);
+
+        for (auto _ : state)
+        {
+            checkpoint::snapshot_reader in{out.bytes()};
+            orders::order_queue restored;
+            restored.restore(in);
+            benchmark::DoNotOptimize(restored.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BookRestore)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    /// @brief Baseline, building the same book from scratch through emplace().
+    void BM_BookReplay(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            orders::order_queue book;
+            fill_book(book, state.range(0));
+            benchmark::DoNotOptimize(book.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BookReplay)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include "events/event.hpp"
+#include "events/event_queue.hpp"
+
+#include <queue>
+#include <string>
+
+using namespace engine::events;
+
+/**
+ * @brief Event layout prior to the compact representation, kept for comparison.
+ */
+namespace legacy
+{
+    struct market_event
+    {
+        std::string symbol_;
+        double price_;
+        double qty_;
+        int64_t timestamp_ms_;
+        bool is_buyer_match_;
+    };
+
+    struct order_event
+    {
+        std::string symbol_;
+        std::string order_id_;
+        int64_t quantity_;
+        bool is_buy_;
+        double price_;
+        order_type type_;
+        order_flags flags_;
+        std::chrono::system_clock::time_point timestamp_;
+        market_event trigger_;
+    };
+
+    struct fill_event
+    {
+        std::string symbol_;
+        std::string order_id_;
+        int64_t filled_qty_;
+        int64_t order_qty_;
+        bool is_buy_;
+        double fill_price_;
+        order_event originating_order_;
+        std::chrono::system_clock::time_point timestamp;
+    };
+
+    struct cancel_event
+    {
+        order_event originating_order_;
+        std::string reason_;
+        std::chrono::system_clock::time_point timestamp;
+    };
+
+    using event = std::variant<market_event, signal_event, order_event, fill_event, cancel_event>;
+} // namespace legacy
+
+namespace
+{
+    constexpr int64_t batch = 1024;
+
+    /// @brief Push then pop a fill cascade through the legacy deque backed queue.
+    void BM_LegacyFillCascade(benchmark::State &state)
+    {
+        std::queue<legacy::event> q;
+        const auto now = std::chrono::system_clock::now();
+        legacy::market_event tick{"BTCUSDT", 100.0, 1.0, 1, true};
+        legacy::order_event order{"BTCUSDT", "client-000001", 1, true, 100.0, order_type::Limit, order_flags::None, now, tick};
+
+        for (auto _ : state)
+        {
+            for (int64_t i = 0; i < batch; ++i)
+            {
+                q.push(legacy::fill_event{order.symbol_, order.order_id_, 1, 1, true, 100.0, order, now});
+            }
+            while (!q.empty())
+            {
+                auto ev = std::move(q.front());
+                q.pop();
+                benchmark::DoNotOptimize(ev);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * batch);
+        state.counters["bytes_per_event"] = static_cast<double>(sizeof(legacy::event));
+    }
+    BENCHMARK(BM_LegacyFillCascade);
+
+    /// @brief Push then pop the same cascade as compact events with payloads held by handle.
+    void BM_CompactFillCascade(benchmark::State &state)
+    {
+        event_queue q;
+        const auto now = std::chrono::system_clock::now();
+        market_event tick{0, 100.0, 1.0, 1, true};
+        order_event order{0, 1, 1, true, 100.0, order_type::Limit, order_flags::None, now, q.payloads().retain(tick)};
+        auto origin = q.payloads().retain(order);
+
+        for (auto _ : state)
+        {
+            for (int64_t i = 0; i < batch; ++i)
+            {
+                q.push(fill_event{order.symbol_, order.order_id_, 1, 1, true, 100.0, origin, now});
+            }
+            while (!q.empty())
+            {
+                auto ev = q.pop();
+                benchmark::DoNotOptimize(ev);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * batch);
+        state.counters["bytes_per_event"] = static_cast<double>(sizeof(event));
+    }
+    BENCHMARK(BM_CompactFillCascade);
+} // namespace
+
+BENCHMARK_MAIN();
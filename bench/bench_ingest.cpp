@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include "engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    struct owning_tick
+    {
+        std::string symbol;
+        double price;
+        double qty;
+        int64_t timestamp_ms;
+        bool is_buyer_match;
+    };
+
+    /// @brief Streamer returning owning ticks by value, the pre view path.
+    struct owning_streamer
+    {
+        std::vector<owning_tick> ticks;
+        size_t index = 0;
+
+        std::optional<owning_tick> next()
+        {
+            if (index < ticks.size())
+                return ticks[index++];
+            return std::nullopt;
+        }
+    };
+
+    struct idle_strategy
+    {
+        void on_market(const market_event &tick, event_queue &) { benchmark::DoNotOptimize(tick); }
+    };
+
+    struct idle_exec
+    {
+    };
+
+    template <typename Streamer>
+    struct ingest_engine : engine_base<ingest_engine<Streamer>, Streamer, idle_strategy, idle_exec, timing::sim_clock>
+    {
+        using engine_base<ingest_engine<Streamer>, Streamer, idle_strategy, idle_exec, timing::sim_clock>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    constexpr size_t tick_count = 1 << 16;
+
+    std::string symbol_of_length(size_t n) { return std::string(n, 'X'); }
+
+    void BM_IngestOwning(benchmark::State &state)
+    {
+        const auto symbol = symbol_of_length(static_cast<size_t>(state.range(0)));
+        owning_streamer streamer;
+        for (size_t i = 0; i < tick_count; ++i)
+        {
+            streamer.ticks.push_back({symbol, 100.0, 1.0, static_cast<int64_t>(i), false});
+        }
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ingest_engine<owning_streamer> engine{owning_streamer{streamer}, idle_strategy{}, portfolio::portfolio_manager{}, idle_exec{}};
+            state.ResumeTiming();
+            engine.run();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tick_count));
+    }
+    BENCHMARK(BM_IngestOwning)->Arg(6)->Arg(64);
+
+    /// @brief Per tick view streamer, tick_buffer minus next_batch.
+    struct view_only_streamer
+    {
+        ingest::tick_buffer buffer;
+
+        const ingest::tick_view *next_view() noexcept { return buffer.next_view(); }
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept { return buffer.symbol_name(id); }
+    };
+
+    void BM_IngestView(benchmark::State &state)
+    {
+        const auto symbol = symbol_of_length(static_cast<size_t>(state.range(0)));
+        ingest::tick_buffer buffer;
+        for (size_t i = 0; i < tick_count; ++i)
+        {
+            buffer.add(symbol, 100.0, 1.0, static_cast<int64_t>(i), false);
+        }
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ingest_engine<view_only_streamer> engine{view_only_streamer{buffer}, idle_strategy{}, portfolio::portfolio_manager{}, idle_exec{}};
+            state.ResumeTiming();
+            engine.run();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tick_count));
+    }
+    BENCHMARK(BM_IngestView)->Arg(6)->Arg(64);
+
+    void BM_IngestBatch(benchmark::State &state)
+    {
+        const auto symbol = symbol_of_length(static_cast<size_t>(state.range(0)));
+        ingest::tick_buffer buffer;
+        for (size_t i = 0; i < tick_count; ++i)
+        {
+            buffer.add(symbol, 100.0, 1.0, static_cast<int64_t>(i), false);
+        }
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ingest_engine<ingest::tick_buffer> engine{ingest::tick_buffer{buffer}, idle_strategy{}, portfolio::portfolio_manager{}, idle_exec{}};
+            state.ResumeTiming();
+            engine.run();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tick_count));
+    }
+    BENCHMARK(BM_IngestBatch)->Arg(6)->Arg(64);
+} // namespace
@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include "journal/journal_reader.hpp"
+#include "journal/journal_writer.hpp"
+
+#include <filesystem>
+
+using namespace engine::events;
+using namespace engine::journal;
+
+namespace
+{
+    const auto bench_path = std::filesystem::temp_directory_path() / "bench_journal.qej";
+
+    /// @brief Hot loop cost of journaling a tick, the writer thread drains in the background.
+    void BM_JournalAppend(benchmark::State &state)
+    {
+        journal_writer writer{bench_path};
+        writer.define_symbol(0, "BTCUSD");
+        int64_t t = 0;
+        for (auto _ : state)
+        {
+            writer.append(market_event{0, 100.0, 1.0, ++t, false});
+        }
+        writer.close();
+        state.SetItemsProcessed(state.iterations());
+        state.counters["stalls"] = static_cast<double>(writer.stalls());
+    }
+    BENCHMARK(BM_JournalAppend);
+
+    /// @brief Replay throughput from a cached journal.
+    void BM_JournalReplay(benchmark::State &state)
+    {
+        const auto count = state.range(0);
+        {
+            journal_writer writer{bench_path};
+            writer.define_symbol(0, "BTCUSD");
+            for (int64_t t = 0; t < count; ++t)
+            {
+                writer.append(market_event{0, 100.0, 1.0, t, false});
+            }
+        }
+
+        journal_reader reader{bench_path};
+        event ev;
+        for (auto _ : state)
+        {
+            reader.rewind();
+            while (reader.next(ev))
+            {
+                benchmark::DoNotOptimize(ev);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * count);
+        state.SetBytesProcessed(state.iterations() * count * static_cast<int64_t>(1 + sizeof(market_event)));
+        std::filesystem::remove(bench_path);
+    }
+    BENCHMARK(BM_JournalReplay)->Arg(1 << 20);
+} // namespace
@@ -0,0 +1,214 @@
+#include <benchmark/benchmark.h>
+
+#include "orders/id_index.hpp"
+#include "orders/order_queue.hpp"
+#include "streamer/buffers/revolving_ring_buffer.hpp"
+
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    /**
+     * @brief Baseline, the book order_queue used before price levels: one multiset per side
+     * ordered by price then timestamp, with a back index of iterators and the same ledger.
+     */
+    class multiset_book
+    {
+    public:
+        void emplace(const order_event &ev)
+        {
+            if (ev.is_buy_)
+            {
+                bid_index_[ev.order_id_] = bids_.emplace(ev);
+            }
+            else
+            {
+                ask_index_[ev.order_id_] = asks_.emplace(ev);
+            }
+        }
+
+        void inactive(order_id id)
+        {
+            if (auto it = bid_index_.find(id); it != bid_index_.end())
+            {
+                ledger_.emplace(*it->second);
+                bids_.erase(it->second);
+                bid_index_.erase(it);
+            }
+            else if (auto ask = ask_index_.find(id); ask != ask_index_.end())
+            {
+                ledger_.emplace(*ask->second);
+                asks_.erase(ask->second);
+                ask_index_.erase(ask);
+            }
+        }
+
+        const orders::order_state &best_bid(symbols::symbol_id) const noexcept { return *bids_.begin(); }
+        const orders::order_state &best_ask(symbols::symbol_id) const noexcept { return *asks_.begin(); }
+
+    private:
+        struct bid_cmp
+        {
+            bool operator()(const orders::order_state &lhs, const orders::order_state &rhs) const noexcept
+            {
+                if (lhs.order_.price_ != rhs.order_.price_)
+                {
+                    return lhs.order_.price_ > rhs.order_.price_;
+                }
+                return lhs.order_.timestamp_ < rhs.order_.timestamp_;
+            }
+        };
+
+        struct ask_cmp
+        {
+            bool operator()(const orders::order_state &lhs, const orders::order_state &rhs) const noexcept
+            {
+                if (lhs.order_.price_ != rhs.order_.price_)
+                {
+                    return lhs.order_.price_ < rhs.order_.price_;
+                }
+                return lhs.order_.timestamp_ < rhs.order_.timestamp_;
+            }
+        };
+
+        std::multiset<orders::order_state, bid_cmp> bids_;
+        std::multiset<orders::order_state, ask_cmp> asks_;
+        std::unordered_map<order_id, std::multiset<orders::order_state, bid_cmp>::iterator> bid_index_;
+        std::unordered_map<order_id, std::multiset<orders::order_state, ask_cmp>::iterator> ask_index_;
+        btc_stream::streamer::buffers::revolving_recency_buffer<orders::order_state> ledger_;
+    };
+
+    /// @brief Resting orders over 500 levels a side, cent ticks, in time order.
+    order_event make_order(order_id id, std::mt19937_64 &rng)
+    {
+        const bool is_buy = rng() % 2 == 0;
+        const auto level = static_cast<double>(rng() % 500) * 0.01;
+        return order_event{0, id, 10, is_buy, is_buy ? 100.0 - level : 100.01 + level, order_type::Limit, order_flags::None,
+                           std::chrono::system_clock::time_point{std::chrono::nanoseconds{id}}};
+    }
+
+    /// @brief Steady state churn: rest a new order and cancel a random resting one.
+    template <typename Book>
+    void BM_BookChurn(benchmark::State &state)
+    {
+        const auto resting = static_cast<order_id>(state.range(0));
+        std::mt19937_64 rng{42};
+        Book book;
+        std::vector<order_id> live(resting);
+        for (order_id id = 1; id <= resting; ++id)
+        {
+            book.emplace(make_order(id, rng));
+            live[id - 1] = id;
+        }
+
+        order_id next = resting + 1;
+        for (auto _ : state)
+        {
+            auto &slot = live[rng() % live.size()];
+            book.inactive(slot);
+            book.emplace(make_order(next, rng));
+            slot = next++;
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+    BENCHMARK(BM_BookChurn<multiset_book>)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+    BENCHMARK(BM_BookChurn<orders::order_queue>)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+
+    /// @brief Top of book activity: orders joining and leaving the best level, read after each.
+    template <typename Book>
+    void BM_BookTopOfBook(benchmark::State &state)
+    {
+        const auto resting = static_cast<order_id>(state.range(0));
+        std::mt19937_64 rng{42};
+        Book book;
+        for (order_id id = 1; id <= resting; ++id)
+        {
+            book.emplace(make_order(id, rng));
+        }
+
+        order_id next = resting + 1;
+        for (auto _ : state)
+        {
+            const auto id = next++;
+            book.emplace(order_event{0, id, 10, true, 100.0, order_type::Limit, order_flags::None,
+                                     std::chrono::system_clock::time_point{std::chrono::nanoseconds{id}}});
+            benchmark::DoNotOptimize(book.best_bid(0).order_.price_);
+            book.inactive(id);
+            benchmark::DoNotOptimize(book.best_ask(0).order_.price_);
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+    BENCHMARK(BM_BookTopOfBook<multiset_book>)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+    BENCHMARK(BM_BookTopOfBook<orders::order_queue>)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+
+    /// @brief Work one instrument's resting orders on its tick, in a book shared by 100 symbols.
+    void BM_BookSymbolWalk(benchmark::State &state)
+    {
+        const auto resting = static_cast<order_id>(state.range(0));
+        const bool per_symbol = state.range(1) != 0;
+        std::mt19937_64 rng{42};
+        orders::order_queue book;
+        for (order_id id = 1; id <= resting; ++id)
+        {
+            auto ev = make_order(id, rng);
+            ev.symbol_ = static_cast<symbols::symbol_id>(id % 100);
+            book.emplace(ev);
+        }
+
+        symbols::symbol_id symbol = 0;
+        for (auto _ : state)
+        {
+            size_t seen = 0;
+            auto count = [&](const orders::order_state &st)
+            {
+                seen += st.order_.symbol_ == symbol;
+                return true;
+            };
+            if (per_symbol)
+            {
+                book.for_each_pruned(symbol, count);
+            }
+            else
+            {
+                // Before per symbol books, every order was walked and filtered
+                book.for_each_pruned(count);
+            }
+            benchmark::DoNotOptimize(seen);
+            symbol = (symbol + 1) % 100;
+        }
+        state.SetLabel(per_symbol ? "per symbol" : "all symbols");
+    }
+    BENCHMARK(BM_BookSymbolWalk)->Args({100'000, 0})->Args({100'000, 1});
+
+    /// @brief Order ID index probes, half hits and half misses, over sparse live IDs.
+    template <typename Index>
+    void BM_OrderIndexLookup(benchmark::State &state)
+    {
+        const auto live = static_cast<size_t>(state.range(0));
+        std::mt19937_64 rng{42};
+        Index index;
+        std::vector<order_id> ids(live);
+        for (auto &id : ids)
+        {
+            id = rng() | 1; // odd IDs are live, even ones miss
+            index.try_emplace(id, static_cast<uint32_t>(id));
+        }
+
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            const auto id = ids[i % live] ^ (i & 1);
+            ++i;
+            benchmark::DoNotOptimize(index.find(id));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_OrderIndexLookup<std::unordered_map<order_id, uint32_t>>)->Arg(10'000)->Arg(1'000'000);
+    BENCHMARK(BM_OrderIndexLookup<orders::id_index<order_id, uint32_t>>)->Arg(10'000)->Arg(1'000'000);
+} // namespace
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "events/scheduled_queue.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace engine::events;
+
+namespace
+{
+    /// @brief Steady state hold model: pop the earliest event and schedule one in its place.
+    void BM_ScheduledQueueHold(benchmark::State &state)
+    {
+        const auto pending = static_cast<size_t>(state.range(0));
+        scheduled_queue q;
+
+        // Latencies between 1us and 1ms
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<uint64_t> dist{1'000, 1'000'000};
+        std::vector<uint64_t> delays(4096);
+        for (auto &d : delays)
+        {
+            d = dist(rng);
+        }
+
+        const event ev = market_event{0, 100.0, 1.0, 0, false};
+        for (size_t i = 0; i < pending; ++i)
+        {
+            q.push(delays[i % delays.size()], ev);
+        }
+
+        size_t i = 0;
+        event out;
+        for (auto _ : state)
+        {
+            q.pop(out);
+            q.push(q.now() + delays[i++ & (delays.size() - 1)], out);
+            benchmark::DoNotOptimize(out);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ScheduledQueueHold)->Arg(64)->Arg(4096)->Arg(262144);
+} // namespace
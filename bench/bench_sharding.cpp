@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "sharding/sharded_runner.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    /// @brief Per symbol indicator state with a fixed amount of work per tick.
+    struct indicator_strategy
+    {
+        void on_market(const market_event &tick, event_queue &)
+        {
+            if (tick.symbol_ >= ema_.size())
+            {
+                ema_.resize(tick.symbol_ + 1, tick.price_);
+            }
+            auto &ema = ema_[tick.symbol_];
+            for (int i = 0; i < 64; ++i)
+            {
+                ema += 0.01 * (tick.price_ - ema);
+            }
+            benchmark::DoNotOptimize(ema);
+        }
+
+        std::vector<double> ema_;
+    };
+
+    struct idle_exec
+    {
+    };
+
+    struct shard_engine : engine_base<shard_engine, sharding::shard_feed, indicator_strategy, idle_exec, timing::sim_clock>
+    {
+        using engine_base<shard_engine, sharding::shard_feed, indicator_strategy, idle_exec, timing::sim_clock>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    constexpr size_t tick_count = 1 << 18;
+    constexpr size_t symbol_count = 400;
+
+    void BM_ShardedThroughput(benchmark::State &state)
+    {
+        ingest::tick_buffer ticks;
+        for (size_t i = 0; i < tick_count; ++i)
+        {
+            ticks.add("SYM" + std::to_string(i % symbol_count), 100.0 + static_cast<double>(i % 7), 1.0, static_cast<int64_t>(i), false);
+        }
+
+        sharding::shard_config config;
+        config.shards = static_cast<size_t>(state.range(0));
+        for (size_t i = 0; i < config.shards; ++i)
+        {
+            // Core 0 is left to the router
+            config.cores.push_back(static_cast<int>(i + 1));
+        }
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ticks.rewind();
+            sharding::sharded_runner<shard_engine> runner{config, [](size_t, sharding::shard_feed feed)
+                                                          { return std::make_unique<shard_engine>(std::move(feed), indicator_strategy{}, portfolio::portfolio_manager{}, idle_exec{}); }};
+            state.ResumeTiming();
+            runner.run(ticks);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tick_count));
+    }
+    BENCHMARK(BM_ShardedThroughput)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
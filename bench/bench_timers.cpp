@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "timing/timer_wheel.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace engine;
+
+namespace
+{
+    /// @brief Delays between 1us and 1ms, a power of two count.
+    std::vector<uint64_t> make_delays()
+    {
+        std::mt19937_64 rng{42};
+        std::uniform_int_distribution<uint64_t> dist{1'000, 1'000'000};
+        std::vector<uint64_t> delays(4096);
+        for (auto &d : delays)
+        {
+            d = dist(rng);
+        }
+        return delays;
+    }
+
+    /// @brief Arm and cancel a timeout with N others pending, the order timeout pattern.
+    void BM_TimerWheelScheduleCancel(benchmark::State &state)
+    {
+        const auto pending = static_cast<size_t>(state.range(0));
+        const auto delays = make_delays();
+        timing::timer_wheel wheel{std::chrono::microseconds{1}};
+        for (size_t i = 0; i < pending; ++i)
+        {
+            wheel.schedule(delays[i % delays.size()]);
+        }
+
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            const auto id = wheel.schedule(delays[i++ & (delays.size() - 1)]);
+            benchmark::DoNotOptimize(wheel.cancel(id));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_TimerWheelScheduleCancel)->Arg(64)->Arg(4096)->Arg(262144);
+
+    /// @brief Steady state hold model: advance time, re-arming every timer that fires.
+    void BM_TimerWheelHold(benchmark::State &state)
+    {
+        const auto pending = static_cast<size_t>(state.range(0));
+        const auto delays = make_delays();
+        timing::timer_wheel wheel{std::chrono::microseconds{1}};
+        for (size_t i = 0; i < pending; ++i)
+        {
+            wheel.schedule(delays[i % delays.size()]);
+        }
+
+        // Steps of 10us fire a handful of timers each at the larger sizes
+        uint64_t now = 0;
+        size_t i = 0;
+        size_t fired = 0;
+        for (auto _ : state)
+        {
+            now += 10'000;
+            fired += wheel.advance(now, [&](events::timer_id, uint64_t, uint64_t due_ns)
+                                   { wheel.schedule(due_ns + delays[i++ & (delays.size() - 1)]); });
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(fired));
+    }
+    BENCHMARK(BM_TimerWheelHold)->Arg(64)->Arg(4096)->Arg(262144);
+} // namespace
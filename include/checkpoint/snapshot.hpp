@@ -0,0 +1,295 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine::checkpoint
+{
+    /**
+     * @brief Binary engine snapshot layout.
+     *
+     * A snapshot is a fixed header followed by the sections components write in order, each
+     * opened by a four character tag so a restore into a differently composed engine fails
+     * loudly instead of misreading. Values are stored as raw bytes and arrays as a count followed
+     * by their elements, so restoring a large book is a handful of bulk copies. Like journals,
+     * snapshots are only readable by a build with the same event layout, an engine records the
+     * size of its event type and a fingerprint of its event list in the header and checks both on
+     * restore.
+     */
+
+    /// @brief Magic bytes opening every snapshot.
+    inline constexpr std::array<char, 8> snapshot_magic{'Q', 'E', 'S', 'N', 'A', 'P', '0', '1'};
+
+    /// @brief Format version, bumped with every section layout change so older snapshots are
+    /// rejected rather than misread.
+    inline constexpr uint32_t format_version = 1;
+
+    /**
+     * @brief Leading snapshot header.
+     */
+    struct snapshot_header
+    {
+        std::array<char, 8> magic_{snapshot_magic}; ///< Identifies the file as a snapshot.
+        uint32_t version_{format_version};          ///< Format version.
+        uint32_t event_size_{0};                    ///< Layout check set by the engine, 0 for component only snapshots.
+        uint64_t event_layout_{0};                  ///< Event list fingerprint set by the engine, 0 for component only snapshots.
+    };
+
+    /// @brief Section tag from four characters.
+    constexpr uint32_t tag(const char (&name)[5]) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<uint8_t>(name[0])) |
+               static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8 |
+               static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16 |
+               static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24;
+    }
+
+    /**
+     * @brief Serialises component state into an in memory snapshot.
+     */
+    class snapshot_writer
+    {
+    public:
+        /// @brief Start a snapshot with its header.
+        snapshot_writer();
+
+        /**
+         * @brief Open a section.
+         * @param section Tag checked on restore, see tag().
+         */
+        void section(uint32_t section) { put(section); }
+
+        /**
+         * @brief Record the saving engine's event layout in the header.
+         * @param bytes Size of the engine's event type.
+         * @param fingerprint Fingerprint of its event list, see events::event_list::layout_fingerprint.
+         */
+        void set_event_layout(size_t bytes, uint64_t fingerprint) noexcept;
+
+        /**
+         * @brief Append a trivially copyable value.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void put(const T &value)
+        {
+            append(&value, sizeof(T));
+        }
+
+        /**
+         * @brief Append a count followed by the elements.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void put_span(std::span<const T> values)
+        {
+            put(static_cast<uint64_t>(values.size()));
+            append(values.data(), values.size_bytes());
+        }
+
+        /**
+         * @brief Append a length prefixed string.
+         */
+        void put_string(std::string_view value) { put_span(std::span<const char>{value.data(), value.size()}); }
+
+        /**
+         * @brief Reserve room for a further number of bytes, ahead of a large section.
+         */
+        void reserve(size_t bytes) { buffer_.reserve(buffer_.size() + bytes); }
+
+        /**
+         * @brief Snapshot bytes so far, header included.
+         */
+        std::span<const std::byte> bytes() const noexcept { return buffer_; }
+
+        /**
+         * @brief Write the snapshot to a file, replacing it.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void write_file(const std::filesystem::path &path) const;
+
+    private:
+        /// @brief Append raw bytes.
+        void append(const void *data, size_t size)
+        {
+            const auto at = buffer_.size();
+            buffer_.resize(at + size);
+            if (size != 0)
+            {
+                std::memcpy(buffer_.data() + at, data, size);
+            }
+        }
+
+        std::vector<std::byte> buffer_; ///< Header and sections.
+    };
+
+    /**
+     * @brief Reads component state back from a snapshot, in the order it was written.
+     *
+     * Every read is bounds checked, a truncated or mismatched snapshot throws std::runtime_error.
+     */
+    class snapshot_reader
+    {
+    public:
+        /**
+         * @brief Read a snapshot held in memory.
+         * @param bytes Snapshot bytes, copied.
+         */
+        explicit snapshot_reader(std::span<const std::byte> bytes);
+
+        /**
+         * @brief Read a snapshot file.
+         */
+        explicit snapshot_reader(const std::filesystem::path &path);
+
+        /**
+         * @brief Enter a section, checking its tag.
+         */
+        void section(uint32_t section);
+
+        /**
+         * @brief Check the snapshot was saved by an engine with this event layout.
+         * @param bytes Size of the engine's event type.
+         * @param fingerprint Fingerprint of its event list, see events::event_list::layout_fingerprint.
+         * @throws std::runtime_error if the recorded size or fingerprint differs.
+         */
+        void check_event_layout(size_t bytes, uint64_t fingerprint) const;
+
+        /**
+         * @brief Read a trivially copyable value.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void get(T &out)
+        {
+            std::memcpy(static_cast<void *>(&out), take(sizeof(T)), sizeof(T));
+        }
+
+        /**
+         * @brief Read a trivially copyable value.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T> && std::default_initializable<T>
+        T get()
+        {
+            T out;
+            get(out);
+            return out;
+        }
+
+        /**
+         * @brief Read an element count written by put_span().
+         */
+        size_t get_count() { return static_cast<size_t>(get<uint64_t>()); }
+
+        /**
+         * @brief Read an element count, checking the snapshot holds at least that many elements.
+         * @param element_size Smallest size an element occupies in the snapshot.
+         */
+        size_t get_count(size_t element_size)
+        {
+            const auto count = get_count();
+            if (element_size != 0 && count > remaining() / element_size)
+            {
+                truncated();
+            }
+            return count;
+        }
+
+        /**
+         * @brief View the elements of a span written by put_span(), valid for the reader lifetime.
+         *
+         * Elements are unaligned in the snapshot, copy them out with element().
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        const std::byte *get_span(size_t &count)
+        {
+            count = get_count(sizeof(T));
+            return take(count * sizeof(T));
+        }
+
+        /**
+         * @brief Read a span written by put_span() into a vector, replacing its contents.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void get_vector(std::vector<T> &out)
+        {
+            size_t count = 0;
+            const auto *data = get_span<T>(count);
+            out.resize(count);
+            if (count != 0)
+            {
+                std::memcpy(static_cast<void *>(out.data()), data, count * sizeof(T));
+            }
+        }
+
+        /**
+         * @brief Read a string written by put_string().
+         */
+        std::string get_string()
+        {
+            size_t count = 0;
+            const auto *data = get_span<char>(count);
+            return std::string{reinterpret_cast<const char *>(data), count};
+        }
+
+        /**
+         * @brief Copy out element i of a span returned by get_span().
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        static void element(const std::byte *data, size_t i, T &out) noexcept
+        {
+            std::memcpy(static_cast<void *>(&out), data + i * sizeof(T), sizeof(T));
+        }
+
+        /**
+         * @brief Bytes not yet read.
+         */
+        size_t remaining() const noexcept { return buffer_.size() - cursor_; }
+
+    private:
+        /// @brief Validate the header.
+        void check_header();
+
+        /// @brief Consume bytes, throwing if fewer remain.
+        const std::byte *take(size_t size)
+        {
+            if (size > remaining())
+            {
+                truncated();
+            }
+            const auto *at = buffer_.data() + cursor_;
+            cursor_ += size;
+            return at;
+        }
+
+        [[noreturn]] static void truncated();
+
+        std::vector<std::byte> buffer_; ///< Snapshot bytes.
+        size_t cursor_{0};              ///< Next byte to read.
+        uint32_t event_size_{0};        ///< Event size recorded in the header.
+        uint64_t event_layout_{0};      ///< Event list fingerprint recorded in the header.
+    };
+
+    /**
+     * @brief Component that can save its state into a snapshot and restore it.
+     */
+    template <typename T>
+    concept checkpointable = requires(const T &c, T &m, snapshot_writer &w, snapshot_reader &r) {
+        c.save(w);
+        m.restore(r);
+    };
+
+} // namespace engine::checkpoint
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "concurrency/thread_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace engine::concurrency
+{
+    /**
+     * @brief Idle strategies for loops waiting on work.
+     *
+     * A strategy provides idle(), called each time the loop finds no work, reset(), called once
+     * work arrives, and wake(), called from any thread after publishing work. Only blocking
+     * strategies act on wake(), the others poll and leave it empty.
+     */
+
+    /**
+     * @brief Spin on the CPU pause hint, lowest latency and a fully burnt core.
+     */
+    struct busy_spin_idle
+    {
+        void idle() noexcept { cpu_relax(); }
+        void reset() noexcept {}
+        void wake() noexcept {}
+    };
+
+    /**
+     * @brief Spin, then yield, then sleep with exponentially growing parks.
+     */
+    class backoff_idle
+    {
+    public:
+        /// @brief Backoff schedule.
+        struct config
+        {
+            uint32_t spins = 100;                       ///< Pause hints before yielding.
+            uint32_t yields = 100;                      ///< Yields before parking.
+            std::chrono::nanoseconds min_park{1'000};   ///< First park duration.
+            std::chrono::nanoseconds max_park{100'000}; ///< Park duration cap.
+        };
+
+        backoff_idle() = default;
+
+        /// @brief Construct with a custom schedule.
+        explicit backoff_idle(const config &cfg) noexcept
+            : config_(cfg), park_(cfg.min_park)
+        {
+        }
+
+        void idle() noexcept
+        {
+            if (count_ < config_.spins)
+            {
+                ++count_;
+                cpu_relax();
+            }
+            else if (count_ < config_.spins + config_.yields)
+            {
+                ++count_;
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(park_);
+                park_ = std::min(park_ * 2, config_.max_park);
+            }
+        }
+
+        void reset() noexcept
+        {
+            count_ = 0;
+            park_ = config_.min_park;
+        }
+
+        void wake() noexcept {}
+
+    private:
+        config config_{};                                 ///< Backoff schedule.
+        uint32_t count_{0};                               ///< Spins and yields so far this episode.
+        std::chrono::nanoseconds park_{config_.min_park}; ///< Next park duration.
+    };
+
+    /**
+     * @brief Sleep in the kernel until a producer calls wake(), on a futex.
+     *
+     * Every wake() bumps a sequence so a wake landing between the loop's empty poll and idle() is
+     * never lost, the syscall is only made while the waiter is asleep. Waits time out so the loop
+     * still notices stop and pause requests that don't wake it.
+     */
+    class blocking_idle
+    {
+    public:
+        blocking_idle() = default;
+
+        /// @brief Construct with a custom wait timeout.
+        explicit blocking_idle(std::chrono::nanoseconds timeout) noexcept
+            : timeout_(timeout)
+        {
+        }
+
+        /// @brief Owns an address waited on by the kernel.
+        blocking_idle(const blocking_idle &other) noexcept
+            : timeout_(other.timeout_)
+        {
+        }
+
+        blocking_idle &operator=(const blocking_idle &other) noexcept
+        {
+            timeout_ = other.timeout_;
+            return *this;
+        }
+
+        void idle() noexcept
+        {
+            const auto seq = seq_.load(std::memory_order_acquire);
+            if (seq != seen_)
+            {
+                // Woken since last idle, poll again before sleeping
+                seen_ = seq;
+                return;
+            }
+
+            sleeping_.store(true, std::memory_order_seq_cst);
+            wait(seq);
+            sleeping_.store(false, std::memory_order_relaxed);
+            seen_ = seq_.load(std::memory_order_acquire);
+        }
+
+        void reset() noexcept {}
+
+        void wake() noexcept
+        {
+            seq_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_seq_cst))
+            {
+#if defined(__linux__)
+                ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+            }
+        }
+
+        /**
+         * @brief Number of wake() calls, safe from any thread.
+         */
+        uint32_t wakes() const noexcept { return seq_.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief Block while the sequence still reads seq, or until the timeout.
+        void wait(uint32_t seq) noexcept
+        {
+#if defined(__linux__)
+            const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout_);
+            const timespec ts{static_cast<time_t>(secs.count()), static_cast<long>((timeout_ - secs).count())};
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&seq_), FUTEX_WAIT_PRIVATE, seq, &ts, nullptr, 0);
+#else
+            (void)seq;
+            std::this_thread::sleep_for(timeout_);
+#endif
+        }
+
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32 bit integer");
+
+        alignas(cache_line_size) std::atomic<uint32_t> seq_{0}; ///< Wake sequence, the futex word.
+        std::atomic<bool> sleeping_{false};                     ///< Waiter is in or about to enter the kernel.
+        uint32_t seen_{0};                                      ///< Sequence seen by the waiter.
+        std::chrono::nanoseconds timeout_{1'000'000};           ///< Longest single wait.
+    };
+
+    /**
+     * @brief Time spent idle by a loop, readable from any thread.
+     */
+    struct idle_counters
+    {
+        uint64_t idle_ns = 0;       ///< Total time between first idle() and the following reset().
+        uint64_t idle_episodes = 0; ///< Times the loop went idle.
+        uint64_t idle_calls = 0;    ///< Total idle() calls.
+    };
+
+    /**
+     * @brief Wraps an idle strategy, metering the time spent idle.
+     *
+     * The clock is read once when an idle episode starts and once when it ends, so the busy path
+     * only pays a branch in reset().
+     *
+     * @tparam Idle Idle strategy.
+     */
+    template <typename Idle>
+    class metered_idle
+    {
+    public:
+        metered_idle() = default;
+
+        /// @brief Meter a configured strategy.
+        explicit metered_idle(const Idle &idle)
+            : idle_(idle)
+        {
+        }
+
+        void idle() noexcept
+        {
+            if (!idling_)
+            {
+                idling_ = true;
+                since_ = std::chrono::steady_clock::now();
+                single_writer_add(episodes_, 1);
+            }
+            single_writer_add(calls_, 1);
+            idle_.idle();
+        }
+
+        void reset() noexcept
+        {
+            if (idling_) [[unlikely]]
+            {
+                idling_ = false;
+                const auto idle_for = std::chrono::steady_clock::now() - since_;
+                single_writer_add(idle_ns_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(idle_for).count()));
+                idle_.reset();
+            }
+        }
+
+        void wake() noexcept { idle_.wake(); }
+
+        /**
+         * @brief Idle counters, safe from any thread. Excludes a still open idle episode.
+         */
+        idle_counters counters() const noexcept
+        {
+            return {idle_ns_.load(std::memory_order_relaxed),
+                    episodes_.load(std::memory_order_relaxed),
+                    calls_.load(std::memory_order_relaxed)};
+        }
+
+        /**
+         * @brief Underlying strategy.
+         */
+        Idle &strategy() noexcept { return idle_; }
+
+        /**
+         * @brief Const underlying strategy.
+         */
+        const Idle &strategy() const noexcept { return idle_; }
+
+    private:
+        Idle idle_{};                                   ///< Wrapped strategy.
+        bool idling_{false};                            ///< Inside an idle episode.
+        std::chrono::steady_clock::time_point since_{}; ///< Start of the current episode.
+        std::atomic<uint64_t> idle_ns_{0};              ///< Completed idle time.
+        std::atomic<uint64_t> episodes_{0};             ///< Idle episodes started.
+        std::atomic<uint64_t> calls_{0};                ///< idle() calls.
+    };
+
+} // namespace engine::concurrency
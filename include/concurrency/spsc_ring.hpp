@@ -0,0 +1,145 @@
+#pragma once
+
+#include "concurrency/thread_utils.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace engine::concurrency
+{
+    /**
+     * @brief Bounded lock-free single producer single consumer ring.
+     *
+     * Producer and consumer state live on separate cache lines, and each side caches the other's
+     * index so the shared line is only touched when the ring looks full or empty. Failed pushes and
+     * pops are counted as producer stalls and consumer idle spins, for sizing the ring.
+     *
+     * @tparam T Trivially copyable element type.
+     */
+    template <typename T>
+    class spsc_ring
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "spsc_ring elements must be trivially copyable");
+
+    public:
+        /**
+         * @brief Construct a ring.
+         * @param capacity Maximum number of in flight elements, rounded up to a power of two.
+         */
+        explicit spsc_ring(size_t capacity)
+            : capacity_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+              mask_(capacity_ - 1),
+              buffer_(std::make_unique<T[]>(capacity_))
+        {
+        }
+
+        /// @brief Shared between threads by reference only.
+        spsc_ring(const spsc_ring &) = delete;
+        spsc_ring &operator=(const spsc_ring &) = delete;
+
+        /**
+         * @brief Publish an element. Producer thread only.
+         * @return False if the ring is full, counted as a producer stall.
+         */
+        bool try_push(const T &value) noexcept
+        {
+            const auto tail = producer_.tail_.load(std::memory_order_relaxed);
+            if (tail - producer_.cached_head_ == capacity_)
+            {
+                // Looks full, refresh view of consumer
+                producer_.cached_head_ = consumer_.head_.load(std::memory_order_acquire);
+                if (tail - producer_.cached_head_ == capacity_)
+                {
+                    single_writer_add(producer_.stalls_, 1);
+                    return false;
+                }
+            }
+            buffer_[tail & mask_] = value;
+            producer_.tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consume an element. Consumer thread only.
+         * @return False if the ring is empty, counted as a consumer idle spin.
+         */
+        bool try_pop(T &out) noexcept
+        {
+            const auto head = consumer_.head_.load(std::memory_order_relaxed);
+            if (head == consumer_.cached_tail_)
+            {
+                // Looks empty, refresh view of producer
+                consumer_.cached_tail_ = producer_.tail_.load(std::memory_order_acquire);
+                if (head == consumer_.cached_tail_)
+                {
+                    single_writer_add(consumer_.idle_spins_, 1);
+                    return false;
+                }
+            }
+            out = buffer_[head & mask_];
+            consumer_.head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Check whether the ring is empty. Exact from the consumer thread.
+         */
+        bool empty() const noexcept
+        {
+            return consumer_.head_.load(std::memory_order_acquire) == producer_.tail_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Approximate number of in flight elements, safe from any thread.
+         */
+        size_t size() const noexcept
+        {
+            const auto head = consumer_.head_.load(std::memory_order_acquire);
+            const auto tail = producer_.tail_.load(std::memory_order_acquire);
+            return tail >= head ? tail - head : 0;
+        }
+
+        /**
+         * @brief Get ring capacity.
+         */
+        size_t capacity() const noexcept { return capacity_; }
+
+        /**
+         * @brief Number of pushes that found the ring full. Safe from any thread.
+         */
+        uint64_t producer_stalls() const noexcept { return producer_.stalls_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Number of pops that found the ring empty. Safe from any thread.
+         */
+        uint64_t consumer_idle_spins() const noexcept { return consumer_.idle_spins_.load(std::memory_order_relaxed); }
+
+    private:
+        /// @brief State written by the producer.
+        struct alignas(cache_line_size) producer_state
+        {
+            std::atomic<size_t> tail_{0};     ///< Next write position.
+            size_t cached_head_{0};           ///< Last seen consumer position.
+            std::atomic<uint64_t> stalls_{0}; ///< Pushes that found the ring full.
+        };
+
+        /// @brief State written by the consumer.
+        struct alignas(cache_line_size) consumer_state
+        {
+            std::atomic<size_t> head_{0};         ///< Next read position.
+            size_t cached_tail_{0};               ///< Last seen producer position.
+            std::atomic<uint64_t> idle_spins_{0}; ///< Pops that found the ring empty.
+        };
+
+        const size_t capacity_;       ///< Ring capacity, power of two.
+        const size_t mask_;           ///< Index mask.
+        std::unique_ptr<T[]> buffer_; ///< Element storage.
+        producer_state producer_;     ///< Producer owned line.
+        consumer_state consumer_;     ///< Consumer owned line.
+    };
+
+} // namespace engine::concurrency
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace engine::concurrency
+{
+    /// @brief Cache line size assumed for padding shared state.
+    inline constexpr size_t cache_line_size = 64;
+
+    /**
+     * @brief Hint to the CPU that the caller is spin waiting.
+     */
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief Add to a counter only one thread writes, as a relaxed load and store rather than a
+     * locked read-modify-write. Other threads may read it at any time with a relaxed load.
+     *
+     * @param counter Counter, written by the calling thread alone.
+     * @param by Amount to add.
+     */
+    inline void single_writer_add(std::atomic<uint64_t> &counter, uint64_t by) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pin a thread to a single core.
+     *
+     * @param thread Native handle of the thread to pin.
+     * @param core Core index, negative leaves the thread unpinned.
+     * @return True if pinned, false if not requested or unsupported.
+     */
+    inline bool pin_to_core(std::thread::native_handle_type thread, int core) noexcept
+    {
+#if defined(__linux__)
+        if (core < 0)
+        {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<size_t>(core), &set);
+        return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#else
+        (void)thread;
+        (void)core;
+        return false;
+#endif
+    }
+
+} // namespace engine::concurrency
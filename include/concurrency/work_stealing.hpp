@@ -0,0 +1,200 @@
+#pragma once
+
+#include "concurrency/thread_utils.hpp"
+#include "errors/error_code.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace engine::concurrency
+{
+    /**
+     * @brief Range of job indices owned by one worker, stealable by the others.
+     *
+     * Both bounds live in one atomic word, so the owner taking from the front and thieves taking
+     * the back half each need a single CAS and no lock.
+     */
+    class alignas(cache_line_size) stealable_range
+    {
+    public:
+        /**
+         * @brief Hand the range a fresh [begin, end). Only while no other worker can steal it,
+         *        i.e. before workers start or by the owner once its range is empty.
+         */
+        void reset(uint32_t begin, uint32_t end) noexcept { bounds_.store(pack(begin, end), std::memory_order_release); }
+
+        /**
+         * @brief Take the front index. Owner.
+         * @return False if the range is empty.
+         */
+        bool pop(uint32_t &index) noexcept
+        {
+            auto cur = bounds_.load(std::memory_order_acquire);
+            while (begin_of(cur) < end_of(cur))
+            {
+                if (bounds_.compare_exchange_weak(cur, pack(begin_of(cur) + 1, end_of(cur)), std::memory_order_acq_rel))
+                {
+                    index = begin_of(cur);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Indices left, a snapshot that thieves use to pick a victim.
+         */
+        uint32_t size() const noexcept
+        {
+            const auto cur = bounds_.load(std::memory_order_relaxed);
+            return begin_of(cur) < end_of(cur) ? end_of(cur) - begin_of(cur) : 0;
+        }
+
+        /**
+         * @brief Take the back half. Any worker.
+         * @return False if the range is empty.
+         */
+        bool steal(uint32_t &begin, uint32_t &end) noexcept
+        {
+            auto cur = bounds_.load(std::memory_order_acquire);
+            while (begin_of(cur) < end_of(cur))
+            {
+                const auto take = (end_of(cur) - begin_of(cur) + 1) / 2;
+                const auto mid = end_of(cur) - take;
+                if (bounds_.compare_exchange_weak(cur, pack(begin_of(cur), mid), std::memory_order_acq_rel))
+                {
+                    begin = mid;
+                    end = end_of(cur);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        static constexpr uint64_t pack(uint32_t begin, uint32_t end) noexcept { return (uint64_t{begin} << 32) | end; }
+        static constexpr uint32_t begin_of(uint64_t bounds) noexcept { return static_cast<uint32_t>(bounds >> 32); }
+        static constexpr uint32_t end_of(uint64_t bounds) noexcept { return static_cast<uint32_t>(bounds); }
+
+        std::atomic<uint64_t> bounds_{0}; ///< Begin in the high half, end in the low half.
+    };
+
+    /**
+     * @brief Run fn(index, worker) for every index in [0, count) on a work stealing pool.
+     *
+     * Indices are split evenly across workers up front. A worker that runs out steals half of the
+     * largest remaining share it finds, so uneven jobs still keep every worker busy. The first job
+     * error stops workers claiming new jobs and is rethrown once all have joined.
+     *
+     * @param count Number of jobs.
+     * @param workers Number of threads, clamped to [1, count].
+     * @param fn Callable (size_t index, size_t worker).
+     */
+    template <typename Fn>
+    void parallel_for(size_t count, size_t workers, Fn &&fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count > UINT32_MAX)
+        {
+            errors::raise<std::length_error>("parallel_for job count exceeds 32 bits");
+        }
+        workers = std::clamp<size_t>(workers, 1, count);
+
+        auto ranges = std::make_unique<stealable_range[]>(workers);
+        for (size_t w = 0; w < workers; ++w)
+        {
+            ranges[w].reset(static_cast<uint32_t>(count * w / workers), static_cast<uint32_t>(count * (w + 1) / workers));
+        }
+
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+
+        auto drain = [&](size_t self)
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                uint32_t index;
+                if (ranges[self].pop(index))
+                {
+                    fn(static_cast<size_t>(index), self);
+                    continue;
+                }
+
+                // Own range empty, steal from the largest remaining share. A victim drained
+                // between the scan and the steal just means scanning again.
+                bool stole = false;
+                while (!stole)
+                {
+                    size_t victim = self;
+                    uint32_t largest = 0;
+                    for (size_t i = 1; i < workers; ++i)
+                    {
+                        const auto w = (self + i) % workers;
+                        if (const auto left = ranges[w].size(); left > largest)
+                        {
+                            victim = w;
+                            largest = left;
+                        }
+                    }
+                    if (victim == self)
+                    {
+                        return;
+                    }
+
+                    uint32_t begin;
+                    uint32_t end;
+                    if (ranges[victim].steal(begin, end))
+                    {
+                        ranges[self].reset(begin, end);
+                        stole = true;
+                    }
+                }
+            }
+        };
+
+        auto work = [&](size_t self)
+        {
+#if ENGINE_EXCEPTIONS
+            try
+            {
+                drain(self);
+            }
+            catch (...)
+            {
+                // First error wins, the rest of the pool drains out
+                if (!failed.exchange(true))
+                {
+                    error = std::current_exception();
+                }
+            }
+#else
+            drain(self);
+#endif
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(workers - 1);
+            for (size_t w = 1; w < workers; ++w)
+            {
+                threads.emplace_back(work, w);
+            }
+            work(0);
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+} // namespace engine::concurrency
@@ -1,15 +1,87 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <span>
 #include <thread>
 
+#include "checkpoint/snapshot.hpp"
+#include "concurrency/idle_strategy.hpp"
+#include "concurrency/spsc_ring.hpp"
+#include "concurrency/thread_utils.hpp"
+#include "errors/error_code.hpp"
 #include "events/event.hpp"
+#include "events/event_handlers.hpp"
 #include "events/event_queue.hpp"
+#include "events/scheduled_queue.hpp"
+#include "ingest/tick_view.hpp"
+#include "journal/journal_writer.hpp"
+#include "metrics/loop_metrics.hpp"
 #include "portfolio/portfolio_manager.hpp"
+#include "reactor/reactor.hpp"
+#include "symbols/symbol_registry.hpp"
+#include "timing/clock.hpp"
+#include "timing/timer_wheel.hpp"
 
 namespace engine
 {
 
+    /**
+     * @brief Configuration for the pipelined streamer thread.
+     */
+    struct pipeline_config
+    {
+        size_t ring_capacity = 1u << 16; ///< Ticks in flight between streamer and engine.
+        int streamer_core = -1;          ///< Core to pin the streamer thread to, negative leaves it unpinned.
+    };
+
+    /**
+     * @brief Back-pressure counters of the streamer to engine ring.
+     */
+    struct pipeline_counters
+    {
+        uint64_t producer_stalls = 0;     ///< Times the streamer found the ring full.
+        uint64_t consumer_idle_spins = 0; ///< Times the engine found the ring empty.
+        size_t ring_capacity = 0;         ///< Capacity of the ring.
+    };
+
+    /**
+     * @brief Simulated delivery delays between engine components.
+     */
+    struct latency_model
+    {
+        std::chrono::nanoseconds order_latency{0}; ///< Strategy to execution handler, applied to orders.
+        std::chrono::nanoseconds fill_latency{0};  ///< Execution handler back to portfolio, applied to fills and cancels.
+
+        /// @brief True if any delay is configured.
+        bool enabled() const noexcept { return order_latency.count() > 0 || fill_latency.count() > 0; }
+
+        /// @brief Delay in nanoseconds for an event, 0 for immediate delivery.
+        template <typename Event>
+        uint64_t delay_for(const Event &ev) const noexcept
+        {
+            return std::visit([this](const auto &e) -> uint64_t
+                              {
+                using T = std::decay_t<decltype(e)>;
+                if constexpr (std::is_same_v<T, events::order_event>)
+                {
+                    return static_cast<uint64_t>(order_latency.count());
+                }
+                else if constexpr (std::is_same_v<T, events::fill_event> || std::is_same_v<T, events::cancel_event>)
+                {
+                    return static_cast<uint64_t>(fill_latency.count());
+                }
+                else
+                {
+                    return 0;
+                } }, ev);
+        }
+    };
+
     /**
      * @brief CRTP base class for backtest/live engines
      *
@@ -19,11 +91,36 @@ namespace engine
      * @tparam Streamer Market data source.
      * @tparam Strategy Strategy type (implements on_market/on_signal).
      * @tparam ExecHandler Execution handler type.
+     * @tparam Clock Engine clock, real time for live or simulated for backtests.
+     * @tparam Events Event types carried by the engine, see events::event_list. Each event is
+     *                delivered to every component declaring a handler for it, in portfolio,
+     *                execution, strategy order. Handlers are detected at compile time, so a
+     *                component without one costs nothing.
+     * @tparam Idle How the loop waits while paused, while the streamer has no data and while the
+     *              pipeline ring is empty, see concurrency::busy_spin_idle, backoff_idle and
+     *              blocking_idle. Spins by default for the lowest wake latency, backoff_idle
+     *              trades some of it for a free core.
      */
-    template <typename Derived, typename Streamer, typename Strategy, typename ExecHandler>
+    template <typename Derived, typename Streamer, typename Strategy, typename ExecHandler,
+              typename Clock = timing::real_time_clock, typename Events = events::default_events,
+              typename Idle = concurrency::busy_spin_idle>
     class engine_base
     {
+        static_assert(Events::template contains<events::market_event>, "event list must include market_event");
+
     public:
+        /// @brief Variant over the engine's event list.
+        using event_type = typename Events::variant;
+
+        /// @brief Queue handed to component handlers.
+        using queue_type = events::basic_event_queue<event_type>;
+
+        /// @brief Events popped from the queue per batched dispatch.
+        static constexpr size_t drain_batch_size = 64;
+
+        /// @brief Ticks pulled per loop iteration from a batch streamer or the pipeline ring.
+        static constexpr size_t tick_batch_size = 256;
+
         /**
          * @brief Construct a new engine_base.
          * @param streamer Market data streamer.
@@ -40,64 +137,169 @@ namespace engine
               portfolio_manager_(std::move(portfolio_manager)),
               exec_handler_(std::move(exec_handler))
         {
+            // Sampled iterations convert cycles to nanoseconds, calibrate here rather than inside
+            // the first one
+            metrics::cycle_clock::calibrate();
         }
 
         /**
          * @brief Main engine loop.
+         *
+         * A streamer providing next_batch() is pulled a batch per loop iteration, so the loop
+         * bookkeeping and metrics hook run once per batch rather than once per tick.
          */
         void run()
         {
+            run_loop([this](std::span<events::market_event> out)
+                     { return poll_source(out); });
+        }
+
+        /**
+         * @brief Coroutine engine loop on a reactor.
+         *
+         * Runs the same iterations as run(), but awaits rather than spins when there is nothing to
+         * do: on the streamer's descriptor while it has no data and on a timer while paused, both
+         * bounded by idle_timeout so should_stop() is still polled. After each batch the loop
+         * yields, so other coroutines on the reactor, such as timers or a control channel, share
+         * the thread and may call the engine directly.
+         *
+         * An execution handler providing poll_fd() and on_readable(queue), e.g. a venue session
+         * receiving acknowledgements, is awaited by a second coroutine, with whatever it queues
+         * dispatched as it arrives. That coroutine is stopped when the loop ends, by should_stop() or
+         * by an error escaping it.
+         *
+         * @param r Reactor the loop is spawned on.
+         * @param idle_timeout Longest single wait.
+         */
+        reactor::task run_async(reactor::reactor &r, std::chrono::nanoseconds idle_timeout = std::chrono::milliseconds{1})
+        {
+            static_assert(reactor::pollable<Streamer>, "run_async needs a streamer providing poll_fd()");
             auto &self = derived();
-            size_t tick_count = 0;
 
-            // Check engine is running
+            // Stop the execution coroutine however the loop ends. Its descriptor may already
+            // have fired with it still queued, when cancel() finds no waiter, so it also checks
+            // the flag each time it wakes.
+            struct exec_stopper
+            {
+                engine_base *engine_;
+                reactor::reactor *r_;
+                ~exec_stopper()
+                {
+                    if constexpr (async_exec)
+                    {
+                        engine_->exec_stop_ = true;
+                        r_->cancel(engine_->exec_handler_.poll_fd());
+                    }
+                }
+            } stopper{this, &r};
+            if constexpr (async_exec)
+            {
+                exec_stop_ = false;
+                r.spawn(exec_loop(r));
+            }
+
+            size_t tick_count = 0;
+            auto poll = [this](std::span<events::market_event> out)
+            { return poll_source(out); };
             while (!self.should_stop())
             {
-                auto loop_start = std::chrono::high_resolution_clock::now();
+                const auto result = step(poll, tick_count);
+                if (result == step_result::stop)
+                {
+                    break;
+                }
+                if (result == step_result::ticks)
+                {
+                    co_await r.yield();
+                }
+                else if (result == step_result::empty)
+                {
+                    co_await r.readable(streamer_.poll_fd(), idle_timeout);
+                }
+                else
+                {
+                    co_await r.sleep_for(idle_timeout);
+                }
+            }
+        }
 
-                try
+        /**
+         * @brief Pipelined engine loop.
+         *
+         * The streamer is polled on its own (optionally pinned) thread and ticks are published to
+         * the engine thread through a bounded SPSC ring. Strategy, execution and portfolio still
+         * run on the calling thread, taking whatever the ring holds per loop iteration. Symbols are
+         * interned on the streamer thread, so the symbol registry must not be read until this
+         * returns.
+         *
+         * @param config Ring size and core placement.
+         */
+        void run_pipelined(const pipeline_config &config = {})
+        {
+            auto &self = derived();
+            pipeline_ = std::make_unique<concurrency::spsc_ring<events::market_event>>(config.ring_capacity);
+            auto &ring = *pipeline_;
+
+            // Set by the producer whenever the streamer reports no data
+            std::atomic<bool> exhausted{false};
+
+            // Joined on scope exit, including when the loop throws
+            std::jthread producer([&](std::stop_token stop)
+                                  {
+                events::market_event tick;
+                while (!stop.stop_requested())
                 {
-                    // Pause loop
-                    while (is_paused())
+                    if (!poll_streamer(tick))
                     {
+                        exhausted.store(true, std::memory_order_release);
                         std::this_thread::yield();
-                        if (self.should_stop())
-                            return;
+                        continue;
                     }
 
-                    // Poll streamer for next market event
-                    if (auto ev = poll_streamer())
+                    exhausted.store(false, std::memory_order_relaxed);
+                    while (!ring.try_push(tick))
                     {
-                        ++tick_count;
-                        handle_event(*ev);
-                    }
-                    else
-                    {
-                        // Decides to continue
-                        if (!self.handle_no_event())
-                        {
-                            break;
-                        }
+                        if (stop.stop_requested())
+                            return;
+                        concurrency::cpu_relax();
                     }
+                    idle_.wake();
+                } });
+            concurrency::pin_to_core(producer.native_handle(), config.streamer_core);
 
-                    // Drain queue
-                    while (!queue_.empty())
-                    {
-                        auto sub_ev = queue_.pop();
-                        handle_event(sub_ev);
-                    }
+            run_loop([&](std::span<events::market_event> out) -> size_t
+                     {
+                while (!ring.try_pop(out.front()))
+                {
+                    // Only report no event once the streamer has and everything it sent is consumed
+                    if (exhausted.load(std::memory_order_acquire) && ring.empty())
+                        return 0;
+                    if (self.should_stop())
+                        return 0;
+                    idle_.idle();
                 }
-                catch (const std::exception &ex)
+
+                // Take the rest of what is already published without waiting
+                size_t n = 1;
+                while (n < out.size() && ring.try_pop(out[n]))
                 {
-                    self.on_error(ex); // default rethrow
+                    ++n;
                 }
+                return n; });
+        }
 
-                // Log metrics
-                auto loop_end = std::chrono::high_resolution_clock::now();
-                self.on_loop_metrics(
-                    tick_count,
-                    std::chrono::duration_cast<std::chrono::nanoseconds>(loop_end - loop_start));
+        /**
+         * @brief Back-pressure counters of the current or last pipelined run.
+         *
+         * Safe to call from any thread while run_pipelined() is active.
+         */
+        pipeline_counters pipeline_stats() const noexcept
+        {
+            if (!pipeline_)
+            {
+                return {};
             }
+            return {pipeline_->producer_stalls(), pipeline_->consumer_idle_spins(), pipeline_->capacity()};
         }
 
         /**
@@ -132,6 +334,168 @@ namespace engine
             return exec_handler_;
         }
 
+        /**
+         * @brief Getter for const symbol registry, maps interned IDs back to names.
+         */
+        const symbols::symbol_registry &symbols() const noexcept
+        {
+            return symbols_;
+        }
+
+        /**
+         * @brief Getter for symbol registry, allows pre-interning a known universe.
+         */
+        symbols::symbol_registry &symbols() noexcept
+        {
+            return symbols_;
+        }
+
+        /**
+         * @brief Getter for const engine clock.
+         */
+        const Clock &clock() const noexcept
+        {
+            return clock_;
+        }
+
+        /**
+         * @brief Timers fired on the engine clock, for scheduling before a run.
+         *
+         * Each timer is delivered as an events::timer_event through the same dispatch as every
+         * other event, to components declaring on_timer(). Due times are on the engine clock, so
+         * in a backtest over sim_clock timers fire in tick time, before the first tick at or past
+         * their due time. Live, they fire on the first loop iteration after they fall due, so a
+         * blocking idle strategy bounds their lateness by its timeout. Handlers schedule through
+         * the queue they are given, see events::basic_event_queue::timers().
+         */
+        timing::timer_wheel &timers() noexcept
+        {
+            return queue_.timers();
+        }
+
+        /**
+         * @brief Getter for const timers.
+         */
+        const timing::timer_wheel &timers() const noexcept
+        {
+            return queue_.timers();
+        }
+
+        /**
+         * @brief Set the simulated latency model.
+         *
+         * With a non-zero model, orders reach the execution handler and fills or cancels reach the
+         * portfolio and strategy after the configured delay in simulated (tick) time, via a
+         * timestamp ordered scheduler instead of the FIFO queue.
+         *
+         * Scheduled events keep referencing their payloads by handle, and the payload store's
+         * rings keep the last payload_store::default_capacity ticks and orders. A delay long
+         * enough for that many to be retained meanwhile evicts the payload before delivery, and
+         * handlers then resolve the handle to nullptr, see stale_payloads().
+         */
+        void set_latency_model(const latency_model &model) noexcept
+        {
+            latency_ = model;
+        }
+
+        /**
+         * @brief Getter for latency model.
+         */
+        const latency_model &latency() const noexcept
+        {
+            return latency_;
+        }
+
+        /**
+         * @brief Scheduled events delivered with a payload handle that no longer resolves.
+         *
+         * Each one reached its handlers with the trigger tick or originating order evicted from
+         * the payload store while it waited out its latency, see set_latency_model().
+         */
+        uint64_t stale_payloads() const noexcept
+        {
+            return stale_payloads_;
+        }
+
+        /**
+         * @brief Built in loop latency histograms, snapshot safe from any thread.
+         */
+        const metrics::loop_metrics &metrics() const noexcept
+        {
+            return metrics_;
+        }
+
+        /**
+         * @brief Time one in every N loop iterations.
+         *
+         * Timed iterations feed the latency histograms and the on_loop_metrics() hook.
+         *
+         * @param every Sampling interval N, 1 times every iteration and 0 disables timing.
+         */
+        void set_metrics_sampling(uint32_t every) noexcept
+        {
+            metrics_.set_sampling(every);
+        }
+
+        /**
+         * @brief Error codes handlers have returned, by code.
+         *
+         * Handlers report failures without throwing by returning errors::errc, see
+         * events::deliver(). Codes other than ok are counted here and passed to on_error_code().
+         */
+        const errors::error_counters &error_counts() const noexcept
+        {
+            return errors_;
+        }
+
+        /**
+         * @brief Time the loop has spent idle, safe from any thread.
+         */
+        concurrency::idle_counters idle_stats() const noexcept
+        {
+            return idle_.counters();
+        }
+
+        /**
+         * @brief Idle strategy, for configuring it before a run.
+         */
+        Idle &idle_strategy() noexcept
+        {
+            return idle_.strategy();
+        }
+
+        /**
+         * @brief Wake the loop if it is blocked waiting for work.
+         *
+         * For streamers fed from another thread, call after publishing data. Safe from any thread,
+         * a no-op for polling idle strategies.
+         */
+        void wake() noexcept
+        {
+            idle_.wake();
+        }
+
+        /**
+         * @brief Record every dispatched event to a journal.
+         *
+         * Symbols interned so far are defined up front and later ones as they are first seen. Only
+         * core event types are journaled, each with the ticks, orders and reasons it references in
+         * the queue's payload store. The journal must outlive the run, nullptr detaches it.
+         *
+         * @param journal Journal to append to.
+         */
+        void attach_journal(journal::journal_writer *journal)
+        {
+            journal_ = journal;
+            if (journal_)
+            {
+                for (symbols::symbol_id id = 0; id < symbols_.size(); ++id)
+                {
+                    journal_->define_symbol(id, symbols_.name(id));
+                }
+            }
+        }
+
         /**
          * @brief Pause streaming.
          */
@@ -146,6 +510,7 @@ namespace engine
         void resume() noexcept
         {
             paused_.store(false, std::memory_order_relaxed);
+            idle_.wake();
         }
 
         /**
@@ -156,69 +521,545 @@ namespace engine
             return paused_.load(std::memory_order_relaxed);
         }
 
+        /**
+         * @brief Save the engine state, so a later restore() resumes exactly where this left off.
+         *
+         * Covers interned symbols, the clock, queued and scheduled events with their payloads,
+         * pending timers, simulated time and the portfolio. The execution handler, strategy and
+         * streamer are saved when they provide save() and restore(), see checkpoint::checkpointable,
+         * which for the streamer records its position rather than its data. Call between runs, never
+         * while a loop is active. Configuration such as the latency model or an attached journal is
+         * not saved, nor are ticks and events a run stopped short of after a handler error, which
+         * the streamer and queue have already passed. The size of event_type and the fingerprint of the event list are recorded in
+         * the snapshot header.
+         *
+         * @param out Snapshot to append to.
+         */
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            out.set_event_layout(sizeof(event_type), Events::layout_fingerprint);
+            out.section(checkpoint::tag("ENGN"));
+            symbols_.save(out);
+            feed_symbols_.save(out);
+            out.put(sim_now_);
+            if constexpr (checkpoint::checkpointable<Clock>)
+            {
+                clock_.save(out);
+            }
+            queue_.save(out);
+            scheduler_.save(out);
+            portfolio_manager_.save(out);
+            save_component(out, checkpoint::tag("EXEC"), exec_handler_);
+            save_component(out, checkpoint::tag("STRT"), strategy_);
+            save_component(out, checkpoint::tag("FEED"), streamer_);
+        }
+
+        /**
+         * @brief Replace the engine state with a saved one, see save().
+         *
+         * The snapshot must come from an engine of the same type, and the streamer must replay the
+         * same data it was saved over. Components are restored one after another, so if this throws
+         * the engine is left partly restored and must be restored again or discarded, not run.
+         *
+         * @param in Snapshot positioned at a save() of this engine type.
+         * @throws std::runtime_error if the snapshot is truncated or corrupt, from a different engine,
+         *         or from one whose event list differs in type count, sizes or alignments.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.check_event_layout(sizeof(event_type), Events::layout_fingerprint);
+            in.section(checkpoint::tag("ENGN"));
+            symbols_.restore(in);
+            feed_symbols_.restore(in);
+            in.get(sim_now_);
+            if constexpr (checkpoint::checkpointable<Clock>)
+            {
+                clock_.restore(in);
+            }
+            queue_.restore(in);
+            scheduler_.restore(in);
+            portfolio_manager_.restore(in);
+            restore_component(in, checkpoint::tag("EXEC"), exec_handler_);
+            restore_component(in, checkpoint::tag("STRT"), strategy_);
+            restore_component(in, checkpoint::tag("FEED"), streamer_);
+        }
+
+        /**
+         * @brief Save the engine state to a file, see save().
+         */
+        void save_checkpoint(const std::filesystem::path &path) const
+        {
+            checkpoint::snapshot_writer out;
+            save(out);
+            out.write_file(path);
+        }
+
+        /**
+         * @brief Restore the engine state from a file written by save_checkpoint().
+         */
+        void restore_checkpoint(const std::filesystem::path &path)
+        {
+            checkpoint::snapshot_reader in{path};
+            restore(in);
+        }
+
     protected:
-        /// Poll streamer and wrap into a market_event
-        std::optional<events::event> poll_streamer()
+        /// @brief Outcome of one loop iteration.
+        enum class step_result : uint8_t
         {
-            // Check streamer for data
-            if (auto tick = streamer_.next())
+            ticks,  ///< Handled at least one tick.
+            empty,  ///< Source had no data, the caller waits before the next iteration.
+            paused, ///< Engine is paused, the caller waits before the next iteration.
+            stop    ///< handle_no_event() ended the run.
+        };
+
+        /**
+         * @brief Generic engine loop over a market event source.
+         *
+         * Each iteration polls a batch of ticks and handles them in order, draining the queue after
+         * every tick. If a handler throws and on_error returns, the tick that threw is dropped and
+         * the next iteration resumes the batch at the tick after it, before polling again.
+         * Without exceptions there is no handler frame at all, failures are error codes returned
+         * by handlers, see error_counts().
+         * One in every N iterations is timed with the cycle clock, see set_metrics_sampling().
+         *
+         * @param poll Callable filling a span with the next ticks, returning how many it wrote, 0
+         *             when none are available.
+         */
+        template <typename Poll>
+        void run_loop(Poll &&poll)
+        {
+            auto &self = derived();
+            size_t tick_count = 0;
+
+            // Check engine is running
+            while (!self.should_stop())
             {
-                return events::market_event{
-                    std::move(tick->symbol),
-                    tick->price,
-                    tick->qty,
-                    tick->timestamp_ms,
-                    tick->is_buyer_match};
+                switch (step(poll, tick_count))
+                {
+                case step_result::ticks:
+                    break;
+                case step_result::empty:
+                case step_result::paused:
+                    idle_.idle();
+                    break;
+                case step_result::stop:
+                    return;
+                }
             }
-            return std::nullopt;
         }
 
-        /// Dispatch event to the correct component
-        void handle_event(events::event &ev)
+        /**
+         * @brief One loop iteration, leaving any wait to the caller.
+         * @param poll Source of ticks, see run_loop().
+         * @param tick_count Running tick count, advanced by the ticks handled.
+         */
+        template <typename Poll>
+        step_result step(Poll &poll, size_t &tick_count)
         {
-            // Get variant type and handle
-            std::visit([&](auto &e)
-                       {
-                using T = std::decay_t<decltype(e)>;
+            auto &self = derived();
+
+            // Only sampled iterations read the cycle counter
+            const bool sampled = metrics_.sample();
+            const uint64_t loop_start = sampled ? metrics::cycle_clock::now() : 0;
+            size_t handled = 0;
+            auto result = step_result::empty;
+            clock_.on_loop();
+            queue_.set_now(clock_.now());
 
-                if constexpr(std::is_same_v<T, events::market_event>)
+#if ENGINE_EXCEPTIONS
+            try
+            {
+#endif
+                if (is_paused())
                 {
-                    // Update portfolio with new market price
-                    portfolio_manager_.on_market(e.symbol_, e.price_, e.qty_);
+                    return step_result::paused;
+                }
 
-                    // Let execution handler re check resting orders
-                    exec_handler_.on_market(e, queue_);
+                // Timers due by now go ahead of the ticks
+                if (fire_timers())
+                {
+                    drain_queue();
+                }
 
-                    // Strategy reacts to the market
-                    strategy_.on_market(e, queue_);
+                // Poll source for next market events, once the last batch is done
+                if (batch_next_ == batch_end_)
+                {
+                    batch_next_ = 0;
+                    batch_end_ = poll(std::span{tick_batch_});
                 }
-                else if constexpr(std::is_same_v<T, events::signal_event>)
+                if (batch_next_ != batch_end_)
                 {
-                    strategy_.on_signal(e, queue_);
+                    result = step_result::ticks;
+                    idle_.reset();
+                    while (batch_next_ != batch_end_)
+                    {
+                        // Consumed before it is handled, so a tick that throws is not retried
+                        auto &tick = tick_batch_[batch_next_++];
+                        ++tick_count;
+                        ++handled;
+                        handle_tick(tick);
+                        drain_queue();
+                    }
                 }
-                else if constexpr(std::is_same_v<T, events::order_event>)
+                else
                 {
-                    exec_handler_.on_order(e, queue_);
+                    // Decides to continue
+                    if (!self.handle_no_event())
+                    {
+                        // Deliver anything still queued or in flight before stopping
+                        drain_queue();
+                        release_due(std::numeric_limits<uint64_t>::max());
+                        return step_result::stop;
+                    }
+                    drain_queue();
                 }
-                else if constexpr(std::is_same_v<T, events::fill_event>)
+#if ENGINE_EXCEPTIONS
+            }
+            catch (const std::exception &ex)
+            {
+                self.on_error(ex); // default rethrow
+            }
+#endif
+
+            // Log metrics
+            if (sampled)
+            {
+                const auto elapsed = metrics::cycle_clock::to_ns(metrics::cycle_clock::now() - loop_start);
+                metrics_.record(elapsed, handled);
+                self.on_loop_metrics(tick_count, std::chrono::nanoseconds{elapsed});
+            }
+            return result;
+        }
+
+        /// Advance engine time to a tick and dispatch it
+        void handle_tick(events::market_event &tick)
+        {
+            clock_.on_tick(tick);
+            queue_.set_now(clock_.now());
+            if (latency_.enabled())
+            {
+                // Deliver in flight events due before this tick first
+                advance_to(tick_time(tick));
+            }
+            if (fire_timers())
+            {
+                drain_queue();
+            }
+            // Known type, no variant round trip
+            dispatch(tick);
+        }
+
+        /// Queue a timer event for every timer due on the engine clock, returning how many
+        size_t fire_timers()
+        {
+            if constexpr (Events::template contains<events::timer_event>)
+            {
+                auto &timers = queue_.timers();
+                if (timers.empty()) [[likely]]
                 {
-                    portfolio_manager_.on_fill(e);
+                    return 0;
                 }
-                else if constexpr(std::is_same_v<T, events::cancel_event>)
+                const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_.now().time_since_epoch());
+                return timers.advance(static_cast<uint64_t>(now.count()), [this](events::timer_id id, uint64_t tag, uint64_t due_ns)
+                                      { queue_.push(events::timer_event{timing::time_point{std::chrono::nanoseconds{due_ns}}, id, tag}); });
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
+        /// Poll the streamer for the next ticks, a batch at a time if it supports it
+        size_t poll_source(std::span<events::market_event> out)
+        {
+            if constexpr (ingest::batch_streamer<Streamer>)
+            {
+                return poll_streamer_batch(out);
+            }
+            else
+            {
+                return poll_streamer(out.front()) ? 1 : 0;
+            }
+        }
+
+        /**
+         * @brief Poll the streamer into a market event.
+         *
+         * View streamers are read in place, with the symbol mapped by ID or looked up by
+         * string_view, so no owning string is built per tick. Owning streamers are interned here.
+         *
+         * @param out Receives the tick.
+         * @return False if the streamer had no data.
+         */
+        bool poll_streamer(events::market_event &out)
+        {
+            if constexpr (ingest::view_streamer<Streamer>)
+            {
+                const auto *tick = streamer_.next_view();
+                if (!tick)
                 {
-                    portfolio_manager_.on_cancel(e);
-                    strategy_.on_cancel(e);
+                    return false;
                 }
-            }, ev);
+                fill_tick(out, *tick);
+            }
+            else
+            {
+                // Check streamer for data
+                auto tick = streamer_.next();
+                if (!tick)
+                {
+                    return false;
+                }
+                fill_tick(out, *tick);
+            }
+            return true;
         }
 
-        /// Default error handler
-        void on_error(const std::exception &ex)
+        /**
+         * @brief Pull a batch of ticks from a batch streamer.
+         * @param out Receives the ticks.
+         * @return Number of ticks written, 0 if the streamer had no data.
+         */
+        size_t poll_streamer_batch(std::span<events::market_event> out)
         {
-            throw ex; // rethrow by default
+            const size_t n = streamer_.next_batch(std::span{view_batch_.data(), out.size()});
+            for (size_t i = 0; i < n; ++i)
+            {
+                fill_tick(out[i], view_batch_[i]);
+            }
+            return n;
+        }
+
+        /// Copy tick fields into a market event, resolving the symbol to an engine ID
+        template <typename Tick>
+        void fill_tick(events::market_event &out, const Tick &tick)
+        {
+            bool fresh = false;
+            symbols::symbol_id symbol;
+            if constexpr (std::is_integral_v<std::remove_cvref_t<decltype(tick.symbol)>>)
+            {
+                // Streamer local ID, named through the streamer on first sight
+                symbol = feed_symbols_.resolve(tick.symbol, symbols_, [this](symbols::symbol_id local)
+                                               { return std::string_view{streamer_.symbol_name(local)}; }, fresh);
+            }
+            else
+            {
+                const auto known = symbols_.size();
+                symbol = symbols_.intern(tick.symbol);
+                fresh = symbol == known;
+            }
+
+            if (fresh && journal_)
+            {
+                // First sight, define before any event using it is journaled
+                journal_->define_symbol(symbol, symbols_.name(symbol));
+            }
+
+            out.symbol_ = symbol;
+            out.price_ = tick.price;
+            out.qty_ = tick.qty;
+            out.timestamp_ms_ = tick.timestamp_ms;
+            out.is_buyer_match_ = tick.is_buyer_match;
         }
 
-        /// Metrics hook, overriden by derived
+        /// Drain queue, routing events through the scheduler when a latency model is set
+        void drain_queue()
+        {
+            // Events a handler error left popped but undelivered come before anything still queued
+            handle_batch();
+            if (!latency_.enabled())
+            {
+                // Drain queue in batches
+                while ((drain_end_ = queue_.pop_batch(drain_buffer_)) != 0)
+                {
+                    drain_next_ = 0;
+                    handle_batch();
+                }
+                return;
+            }
+
+            event_type ev;
+            while (queue_.try_pop(ev))
+            {
+                if (auto delay = latency_.delay_for(ev); delay != 0)
+                {
+                    scheduler_.push(sim_now_ + delay, ev);
+                }
+                else
+                {
+                    handle_event(ev);
+                }
+            }
+        }
+
+        /// Deliver scheduled events due at or before a simulated time, in timestamp order
+        void release_due(uint64_t until)
+        {
+            event_type ev;
+            while (scheduler_.pop_until(until, ev))
+            {
+                // Cascades are scheduled and stamped relative to the delivery time
+                sim_now_ = scheduler_.now();
+                queue_.set_now(timing::time_point{std::chrono::nanoseconds{sim_now_}});
+                if (has_stale_payload(ev)) [[unlikely]]
+                {
+                    ++stale_payloads_;
+                }
+                handle_event(ev);
+                drain_queue();
+            }
+        }
+
+        /// Advance simulated time, delivering anything due on the way
+        void advance_to(uint64_t now)
+        {
+            const auto clock_now = queue_.now();
+            release_due(now);
+            sim_now_ = now > sim_now_ ? now : sim_now_;
+            queue_.set_now(clock_now);
+        }
+
+        /// True if an event references a tick or order the payload store has since evicted
+        bool has_stale_payload(const event_type &ev) const noexcept
+        {
+            const auto &payloads = queue_.payloads();
+            return std::visit([&payloads](const auto &e)
+                              {
+                using T = std::decay_t<decltype(e)>;
+                if constexpr (std::is_same_v<T, events::order_event>)
+                {
+                    return e.trigger_ && !payloads.tick(e.trigger_);
+                }
+                else if constexpr (std::is_same_v<T, events::fill_event> || std::is_same_v<T, events::cancel_event>)
+                {
+                    return e.originating_order_ && !payloads.order(e.originating_order_);
+                }
+                else
+                {
+                    return false;
+                } }, ev);
+        }
+
+        /// Simulated time of a polled market event in nanoseconds
+        static uint64_t tick_time(const events::market_event &tick) noexcept
+        {
+            return static_cast<uint64_t>(tick.timestamp_ms_) * 1'000'000u;
+        }
+
+        /// Dispatch event to the correct component
+        void handle_event(event_type &ev)
+        {
+            // Get variant type and handle
+            std::visit([&](auto &e)
+                       { dispatch(e); }, ev);
+        }
+
+        /**
+         * @brief Dispatch the undelivered events of drain_buffer_ in order.
+         *
+         * Consecutive events of the same type are handled as a run, so the variant is visited once
+         * per run rather than once per event and the same handler stays hot in the cache. Each
+         * event is consumed before it is dispatched, so if a handler throws the next drain resumes
+         * at the event after it.
+         */
+        void handle_batch()
+        {
+            while (drain_next_ < drain_end_)
+            {
+                // Find end of run of same type
+                const auto kind = drain_buffer_[drain_next_].index();
+                size_t end = drain_next_ + 1;
+                while (end < drain_end_ && drain_buffer_[end].index() == kind)
+                {
+                    ++end;
+                }
+
+                std::visit([&](auto &first)
+                           {
+                    using T = std::decay_t<decltype(first)>;
+                    while (drain_next_ < end)
+                    {
+                        dispatch(*std::get_if<T>(&drain_buffer_[drain_next_++]));
+                    } }, drain_buffer_[drain_next_]);
+            }
+        }
+
+        /// Route a single typed event to the components handling it
+        template <typename T>
+        void dispatch(T &e)
+        {
+            if constexpr (events::default_events::contains<T>)
+            {
+                if (journal_)
+                {
+                    journal_->append(e, queue_.payloads());
+                }
+            }
+
+            // Each component gets the event only if it declares a handler for it, checks of
+            // handlers returning no code fold away
+            if (const auto ec = events::deliver(portfolio_manager_, e, queue_); ec != errors::errc::ok) [[unlikely]]
+            {
+                report_error(ec, e);
+            }
+            if (const auto ec = events::deliver(exec_handler_, e, queue_); ec != errors::errc::ok) [[unlikely]]
+            {
+                report_error(ec, e);
+            }
+            if (const auto ec = events::deliver(strategy_, e, queue_); ec != errors::errc::ok) [[unlikely]]
+            {
+                report_error(ec, e);
+            }
+        }
+
+        /// Count a handler's error code and pass it to the derived hook, kept out of line
+        template <typename T>
+        [[gnu::cold, gnu::noinline]] void report_error(errors::errc ec, const T &e)
+        {
+            errors_.record(ec);
+            derived().on_error_code(ec, event_type{e});
+        }
+
+        /// Await an execution handler's descriptor, dispatching what it queues, until stopped
+        reactor::task exec_loop(reactor::reactor &r)
+        {
+            while (co_await r.readable(exec_handler_.poll_fd()) != reactor::wait_result::cancelled && !exec_stop_)
+            {
+                clock_.on_loop();
+                queue_.set_now(clock_.now());
+#if ENGINE_EXCEPTIONS
+                try
+                {
+                    exec_handler_.on_readable(queue_);
+                    drain_queue();
+                }
+                catch (const std::exception &ex)
+                {
+                    derived().on_error(ex); // default rethrow
+                }
+#else
+                exec_handler_.on_readable(queue_);
+                drain_queue();
+#endif
+            }
+        }
+
+#if ENGINE_EXCEPTIONS
+        /// Default exception handler, called from within the catch block, rethrows the original
+        void on_error(const std::exception &)
+        {
+            throw;
+        }
+#endif
+
+        /// Error code hook, overriden by derived, codes are already counted in error_counts()
+        void on_error_code(errors::errc, const event_type &)
+        {
+            // empty
+        }
+
+        /// Metrics hook on sampled iterations, overriden by derived
         void on_loop_metrics(size_t, std::chrono::nanoseconds)
         {
             // empty
@@ -227,16 +1068,65 @@ namespace engine
         std::atomic<bool> paused_; ///< Atomic pause flag.
 
     private:
+        /// @brief Execution handler awaited by run_async(), see exec_loop().
+        static constexpr bool async_exec = reactor::pollable<ExecHandler> &&
+                                           requires(ExecHandler &e, queue_type &q) { e.on_readable(q); };
+
+        /// @brief Batch staging is only sized for batch streamers.
+        static constexpr size_t view_batch_size = ingest::batch_streamer<Streamer> ? tick_batch_size : 0;
+
+        /// @brief Save a component in its own section if it supports checkpoints.
+        template <typename Component>
+        static void save_component(checkpoint::snapshot_writer &out, uint32_t section, const Component &component)
+        {
+            if constexpr (checkpoint::checkpointable<Component>)
+            {
+                out.section(section);
+                component.save(out);
+            }
+        }
+
+        /// @brief Restore a component saved by save_component().
+        template <typename Component>
+        static void restore_component(checkpoint::snapshot_reader &in, uint32_t section, Component &component)
+        {
+            if constexpr (checkpoint::checkpointable<Component>)
+            {
+                in.section(section);
+                component.restore(in);
+            }
+        }
+
         /// Internal getter for derived.
         Derived &derived()
         {
             return static_cast<Derived &>(*this);
         }
-        Streamer streamer_;                              ///< Streamer object for market access.
-        Strategy strategy_;                              ///< Trading strategy implementation.
-        portfolio::portfolio_manager portfolio_manager_; ///< Portfolio manager.
-        ExecHandler exec_handler_;                       ///< Execution handler.
-        events::event_queue queue_;                      ///< Event queue.
+        Streamer streamer_;                                                      ///< Streamer object for market access.
+        Strategy strategy_;                                                      ///< Trading strategy implementation.
+        portfolio::portfolio_manager portfolio_manager_;                         ///< Portfolio manager.
+        ExecHandler exec_handler_;                                               ///< Execution handler.
+        queue_type queue_;                                                       ///< Event queue.
+        symbols::symbol_registry symbols_;                                       ///< Interned symbols seen by this engine.
+        std::unique_ptr<concurrency::spsc_ring<events::market_event>> pipeline_; ///< Streamer to engine ring when pipelined.
+        std::array<event_type, drain_batch_size> drain_buffer_{};                ///< Scratch for batched queue drains.
+        size_t drain_next_{0};                                                   ///< Next event of drain_buffer_ to dispatch.
+        size_t drain_end_{0};                                                    ///< Events popped into drain_buffer_.
+        std::array<events::market_event, tick_batch_size> tick_batch_{};         ///< Ticks polled this iteration.
+        size_t batch_next_{0};                                                   ///< Next tick of tick_batch_ to handle.
+        size_t batch_end_{0};                                                    ///< Ticks polled into tick_batch_.
+        std::array<ingest::tick_view, view_batch_size> view_batch_{};            ///< Staging for batch streamers.
+        latency_model latency_{};                                                ///< Simulated delivery delays.
+        events::basic_scheduled_queue<event_type> scheduler_;                    ///< Delayed events by simulated time.
+        uint64_t sim_now_{0};                                                    ///< Simulated time in nanoseconds.
+        Clock clock_;                                                            ///< Engine time source.
+        journal::journal_writer *journal_{nullptr};                              ///< Optional recorder of dispatched events.
+        ingest::symbol_map feed_symbols_;                                        ///< Streamer symbol IDs to engine IDs, for ID view streamers.
+        concurrency::metered_idle<Idle> idle_;                                   ///< Waits for work, metering idle time.
+        metrics::loop_metrics metrics_;                                          ///< Sampled loop latency.
+        errors::error_counters errors_;                                          ///< Error codes reported by handlers.
+        uint64_t stale_payloads_{0};                                             ///< Scheduled deliveries with an evicted payload.
+        bool exec_stop_{false};                                                  ///< Set when run_async() ends, see exec_loop().
     };
 
 } // namespace engine
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+/// @brief 1 when compiled with exceptions, 0 under -fno-exceptions.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define ENGINE_EXCEPTIONS 1
+#else
+#define ENGINE_EXCEPTIONS 0
+#endif
+
+namespace engine::errors
+{
+    /**
+     * @brief Failures the hot path reports by value instead of throwing.
+     *
+     * Handlers may return one of these, see events::deliver(), and the engine counts and forwards
+     * anything other than ok off the fast path.
+     */
+    enum class errc : uint8_t
+    {
+        ok,               ///< No error.
+        queue_empty,      ///< Pop from an empty event queue.
+        unknown_order,    ///< Order ID not resting in the book.
+        invalid_quantity, ///< Fill of zero or negative quantity.
+        overfill,         ///< Fills exceed the order quantity.
+        rejected,         ///< Component refused the event.
+        count_            ///< Number of codes, not an error.
+    };
+
+    /// @brief Number of error codes.
+    inline constexpr size_t errc_count = static_cast<size_t>(errc::count_);
+
+    /**
+     * @brief Short description of an error code.
+     */
+    constexpr std::string_view message(errc code) noexcept
+    {
+        switch (code)
+        {
+        case errc::ok:
+            return "ok";
+        case errc::queue_empty:
+            return "event queue empty";
+        case errc::unknown_order:
+            return "unknown order";
+        case errc::invalid_quantity:
+            return "invalid fill quantity";
+        case errc::overfill:
+            return "order overfilled";
+        case errc::rejected:
+            return "rejected";
+        case errc::count_:
+            break;
+        }
+        return "unknown error";
+    }
+
+    /**
+     * @brief Fixed size tally of reported errors, recording costs two stores and never allocates.
+     */
+    struct error_counters
+    {
+        std::array<uint64_t, errc_count> counts{}; ///< Reports by code, ok unused.
+        errc last{errc::ok};                       ///< Most recent report.
+
+        /// @brief Record a report.
+        void record(errc code) noexcept
+        {
+            ++counts[static_cast<size_t>(code)];
+            last = code;
+        }
+
+        /// @brief Reports of one code.
+        uint64_t count(errc code) const noexcept { return counts[static_cast<size_t>(code)]; }
+
+        /// @brief Reports of every code.
+        uint64_t total() const noexcept
+        {
+            uint64_t n = 0;
+            for (const auto c : counts)
+            {
+                n += c;
+            }
+            return n;
+        }
+    };
+
+    /**
+     * @brief Report an unrecoverable error, for setup and I/O paths rather than the hot path.
+     *
+     * Throws Exception when exceptions are enabled. Under -fno-exceptions the message is written to
+     * stderr and the process aborts.
+     *
+     * @tparam Exception Exception type thrown when exceptions are enabled.
+     * @param args Exception constructor arguments, the message first.
+     */
+    template <typename Exception, typename... Args>
+    [[noreturn, gnu::cold, gnu::noinline]] void raise(Args &&...args)
+    {
+#if ENGINE_EXCEPTIONS
+        throw Exception(std::forward<Args>(args)...);
+#else
+        const Exception ex(std::forward<Args>(args)...);
+        std::fprintf(stderr, "fatal: %s\n", ex.what());
+        std::abort();
+#endif
+    }
+
+} // namespace engine::errors
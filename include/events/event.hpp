@@ -1,16 +1,22 @@
 #pragma once
 
 #include <string>
-#include <memory>
+#include <type_traits>
 #include <variant>
 #include <chrono>
 
+#include "events/event_list.hpp"
+#include "events/order_id.hpp"
+#include "events/payload_ref.hpp"
+#include "events/timer_id.hpp"
+#include "symbols/symbol_registry.hpp"
+
 namespace engine::events
 {
     /**
      * @brief Enum representing order types.
      */
-    enum class order_type
+    enum class order_type : uint8_t
     {
         Market,     ///< Execute immediately at best available price
         Limit,      ///< Post to order book; executes at or better than limit price
@@ -43,11 +49,11 @@ namespace engine::events
      */
     struct market_event
     {
-        std::string symbol_;   ///< Trade symbol.
-        double price_;         ///< Trade price at the time of the tick.
-        double qty_;           ///< Quantity of the base asset traded.
-        int64_t timestamp_ms_; ///< Epoch timestamp of the trade in milliseconds.
-        bool is_buyer_match_;  ///< True if the buyer initiated the trade (i.e., aggressive buy).
+        symbols::symbol_id symbol_; ///< Interned trade symbol.
+        double price_;              ///< Trade price at the time of the tick.
+        double qty_;                ///< Quantity of the base asset traded.
+        int64_t timestamp_ms_;      ///< Epoch timestamp of the trade in milliseconds.
+        bool is_buyer_match_;       ///< True if the buyer initiated the trade (i.e., aggressive buy).
     };
 
     /**
@@ -58,74 +64,153 @@ namespace engine::events
         // Empty for now
     };
 
+    /// @brief Handles into the side payload store.
+    using tick_ref = payload_ref<market_event>;
+    using reason_ref = payload_ref<std::string>;
+
     /**
      * @brief Event representing an order submitted to the market.
      *
-     * Immutable: once created, these fields never change.
+     * Immutable by convention: once queued, these fields never change. Kept trivially copyable,
+     * the spawning tick lives in the payload store and is referenced by handle. Left unset, the
+     * timestamp is filled from the engine clock when the event is queued.
      */
     struct order_event final
     {
-        const std::string symbol_;                              ///< Symbol being traded
-        const std::string order_id_;                            ///< Unique order identifier
-        const int64_t quantity_;                                ///< Total requested quantity
-        const bool is_buy_;                                     ///< Buy = true, Sell = false
-        const double price_;                                    ///< Limit/stop price (ignored for pure Market)
-        const order_type type_;                                 ///< Market, Limit, Stop, StopLimit
-        const order_flags flags_;                               ///< Execution modifiers (IOC, FOK, GTC, etc.)
-        const std::chrono::system_clock::time_point timestamp_; ///< Time order was placed
-        const market_event trigger_;                            ///< Market event that spawned the order (traceability)
-
-        /// @brief Construct an immutable order event.
-        order_event(std::string symbol,
-                    std::string order_id,
+        int64_t quantity_{0};                                ///< Total requested quantity
+        double price_{0.0};                                  ///< Limit/stop price (ignored for pure Market)
+        std::chrono::system_clock::time_point timestamp_{};  ///< Time order was placed
+        order_id order_id_{invalid_order_id};                ///< Unique order identifier
+        symbols::symbol_id symbol_{symbols::invalid_symbol}; ///< Interned symbol being traded
+        tick_ref trigger_{};                                 ///< Market event that spawned the order (traceability)
+        bool is_buy_{false};                                 ///< Buy = true, Sell = false
+        order_type type_{order_type::Market};                ///< Market, Limit, Stop, StopLimit
+        order_flags flags_{order_flags::None};               ///< Execution modifiers (IOC, FOK, GTC, etc.)
+
+        order_event() noexcept = default;
+
+        /// @brief Construct an order event.
+        order_event(symbols::symbol_id symbol,
+                    order_id id,
                     int64_t quantity,
                     bool is_buy,
                     double price,
                     order_type type,
                     order_flags flags,
-                    std::chrono::system_clock::time_point ts = std::chrono::system_clock::now(),
-                    market_event trigger = {})
-            : symbol_(std::move(symbol)),
-              order_id_(std::move(order_id)),
-              quantity_(quantity),
-              is_buy_(is_buy),
+                    std::chrono::system_clock::time_point ts = {},
+                    tick_ref trigger = {}) noexcept
+            : quantity_(quantity),
               price_(price),
-              type_(type),
-              flags_(flags),
               timestamp_(ts),
-              trigger_(std::move(trigger))
+              order_id_(id),
+              symbol_(symbol),
+              trigger_(trigger),
+              is_buy_(is_buy),
+              type_(type),
+              flags_(flags)
         {
         }
     };
 
+    /// @brief Handle to an order held in the payload store.
+    using order_ref = payload_ref<order_event>;
+
     /**
      * @brief event representing a filled order (execution result).
+     *
+     * The originating order is referenced by handle rather than copied.
      */
     struct fill_event
     {
-        std::string symbol_;
-        std::string order_id_;
-        int64_t filled_qty_;
-        int64_t order_qty_;
-        bool is_buy_;
-        double fill_price_;
-        order_event originating_order_;
-        std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+        int64_t filled_qty_{0};                              ///< Quantity filled by this execution
+        int64_t order_qty_{0};                               ///< Total order size
+        double fill_price_{0.0};                             ///< Execution price
+        std::chrono::system_clock::time_point timestamp{};   ///< Time of fill
+        order_id order_id_{invalid_order_id};                ///< Order identifier
+        symbols::symbol_id symbol_{symbols::invalid_symbol}; ///< Interned symbol filled
+        order_ref originating_order_{};                      ///< Order that was filled
+        bool is_buy_{false};                                 ///< Buy = true, Sell = false
+
+        fill_event() noexcept = default;
+
+        /// @brief Construct a fill event.
+        fill_event(symbols::symbol_id symbol,
+                   order_id id,
+                   int64_t filled_qty,
+                   int64_t order_qty,
+                   bool is_buy,
+                   double fill_price,
+                   order_ref originating_order = {},
+                   std::chrono::system_clock::time_point ts = {}) noexcept
+            : filled_qty_(filled_qty),
+              order_qty_(order_qty),
+              fill_price_(fill_price),
+              timestamp(ts),
+              order_id_(id),
+              symbol_(symbol),
+              originating_order_(originating_order),
+              is_buy_(is_buy)
+        {
+        }
     };
 
     /**
      * @brief Event representing a cancelled order.
+     *
+     * The originating order and reason text are referenced by handle rather than copied.
      */
     struct cancel_event
     {
-        order_event originating_order_;
-        std::string reason_;
-        std::chrono::system_clock::time_point timestamp{std::chrono::system_clock::now()};
+        std::chrono::system_clock::time_point timestamp{};   ///< Time of cancel
+        order_id order_id_{invalid_order_id};                ///< Order identifier
+        symbols::symbol_id symbol_{symbols::invalid_symbol}; ///< Interned symbol of the order
+        order_ref originating_order_{};                      ///< Order that was cancelled
+        reason_ref reason_{};                                ///< Interned reason for cancel
+
+        cancel_event() noexcept = default;
+
+        /// @brief Construct a cancel event for an order.
+        cancel_event(const order_event &order,
+                     order_ref originating_order = {},
+                     reason_ref reason = {},
+                     std::chrono::system_clock::time_point ts = {}) noexcept
+            : timestamp(ts),
+              order_id_(order.order_id_),
+              symbol_(order.symbol_),
+              originating_order_(originating_order),
+              reason_(reason)
+        {
+        }
     };
 
     /**
-     * @brief Unified event type using std::variant.
+     * @brief Event representing a timer that fell due on the engine clock.
+     *
+     * Timers are scheduled on the queue's timer wheel, see basic_event_queue::timers(). The
+     * timestamp is the time the timer was due, which may be slightly before the engine time it
+     * is delivered at.
      */
-    using event = std::variant<market_event, signal_event, order_event, fill_event, cancel_event>;
+    struct timer_event
+    {
+        std::chrono::system_clock::time_point timestamp{}; ///< Time the timer was due
+        timer_id timer_id_{invalid_timer};                 ///< Timer that fired
+        uint64_t tag_{0};                                  ///< Value given when scheduling
+    };
+
+    /**
+     * @brief Core event types understood by the engine and its stock components.
+     *
+     * Appended types keep the journal record kinds of earlier ones.
+     */
+    using default_events = event_list<market_event, signal_event, order_event, fill_event, cancel_event, timer_event>;
+
+    /**
+     * @brief Unified event type over the core list.
+     */
+    using event = default_events::variant;
+
+    // Events are moved through queues by value, keep them small and memcpy-able
+    static_assert(std::is_trivially_copyable_v<event>, "events must be trivially copyable");
+    static_assert(sizeof(event) <= 64, "events must fit in a cache line");
 
 } // namespace engine::events
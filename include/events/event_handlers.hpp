@@ -0,0 +1,135 @@
+#pragma once
+
+#include "errors/error_code.hpp"
+#include "events/event.hpp"
+
+#include <type_traits>
+
+namespace engine::events
+{
+    /**
+     * @brief Names the component member that handles an event type.
+     *
+     * Each specialisation provides two callables, one passing the queue and one without, and each
+     * is only invocable when the component declares that member. Unspecialised types route to
+     * on_event(e, queue) or on_event(e), so custom events need no specialisation unless they
+     * want a dedicated member name.
+     *
+     * @tparam T Event type.
+     */
+    template <typename T>
+    struct handler_of
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_event(e, q))
+        { return c.on_event(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_event(e))
+        { return c.on_event(e); };
+    };
+
+    template <>
+    struct handler_of<market_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_market(e, q))
+        { return c.on_market(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_market(e))
+        { return c.on_market(e); };
+    };
+
+    template <>
+    struct handler_of<signal_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_signal(e, q))
+        { return c.on_signal(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_signal(e))
+        { return c.on_signal(e); };
+    };
+
+    template <>
+    struct handler_of<order_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_order(e, q))
+        { return c.on_order(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_order(e))
+        { return c.on_order(e); };
+    };
+
+    template <>
+    struct handler_of<fill_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_fill(e, q))
+        { return c.on_fill(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_fill(e))
+        { return c.on_fill(e); };
+    };
+
+    template <>
+    struct handler_of<cancel_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_cancel(e, q))
+        { return c.on_cancel(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_cancel(e))
+        { return c.on_cancel(e); };
+    };
+
+    template <>
+    struct handler_of<timer_event>
+    {
+        static constexpr auto with_queue = [](auto &c, auto &e, auto &q) -> decltype(c.on_timer(e, q))
+        { return c.on_timer(e, q); };
+        static constexpr auto without_queue = [](auto &c, auto &e) -> decltype(c.on_timer(e))
+        { return c.on_timer(e); };
+    };
+
+    /**
+     * @brief True if a component declares a handler for T, with or without the queue.
+     */
+    template <typename Component, typename T, typename Queue>
+    inline constexpr bool handles_v =
+        std::is_invocable_v<decltype(handler_of<T>::with_queue), Component &, T &, Queue &> ||
+        std::is_invocable_v<decltype(handler_of<T>::without_queue), Component &, T &>;
+
+    /**
+     * @brief Call a handler, passing on the error code it returns if it returns one.
+     */
+    template <typename Call>
+    inline errors::errc invoke_handler(Call &&call)
+    {
+        if constexpr (std::is_same_v<decltype(call()), errors::errc>)
+        {
+            return call();
+        }
+        else
+        {
+            call();
+            return errors::errc::ok;
+        }
+    }
+
+    /**
+     * @brief Call a component's handler for an event, compiling to nothing if it has none.
+     *
+     * The queue form is preferred when both are declared. A handler may report a failure by
+     * returning errors::errc instead of throwing, any other return type counts as errc::ok.
+     *
+     * @return Code returned by the handler, errc::ok if it returns none or there is no handler.
+     */
+    template <typename Component, typename T, typename Queue>
+    inline errors::errc deliver(Component &c, T &e, Queue &q)
+    {
+        if constexpr (std::is_invocable_v<decltype(handler_of<T>::with_queue), Component &, T &, Queue &>)
+        {
+            return invoke_handler([&]
+                                  { return handler_of<T>::with_queue(c, e, q); });
+        }
+        else if constexpr (std::is_invocable_v<decltype(handler_of<T>::without_queue), Component &, T &>)
+        {
+            return invoke_handler([&]
+                                  { return handler_of<T>::without_queue(c, e); });
+        }
+        else
+        {
+            return errors::errc::ok;
+        }
+    }
+
+} // namespace engine::events
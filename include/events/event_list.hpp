@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+namespace engine::events
+{
+    /**
+     * @brief Compile time list of the event types an engine carries.
+     *
+     * The engine and its queues are instantiated over the list, so an event type that isn't listed
+     * costs nothing, not even variant space.
+     *
+     * @tparam Ts Event types, each trivially copyable.
+     */
+    template <typename... Ts>
+    struct event_list
+    {
+        static_assert(sizeof...(Ts) > 0, "event list can't be empty");
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "events must be trivially copyable");
+
+        /// @brief Variant holding any listed event.
+        using variant = std::variant<Ts...>;
+
+        /// @brief True if T is listed.
+        template <typename T>
+        static constexpr bool contains = (std::is_same_v<T, Ts> || ...);
+
+        /// @brief Number of listed types.
+        static constexpr size_t size = sizeof...(Ts);
+
+        /**
+         * @brief FNV-1a hash of the type count and each type's size and alignment, in order.
+         *
+         * Lets persisted queues detect a different list whose variant happens to have the same size.
+         * Types matching in position, size and alignment can't be told apart.
+         */
+        static constexpr uint64_t layout_fingerprint = []
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            const auto mix = [&hash](uint64_t value)
+            {
+                hash ^= value;
+                hash *= 0x100000001b3ull;
+            };
+            mix(sizeof...(Ts));
+            ((mix(sizeof(Ts)), mix(alignof(Ts))), ...);
+            return hash;
+        }();
+    };
+
+    /**
+     * @brief Extend a list with further event types.
+     */
+    template <typename List, typename... Extra>
+    struct extend_events;
+
+    template <typename... Ts, typename... Extra>
+    struct extend_events<event_list<Ts...>, Extra...>
+    {
+        using type = event_list<Ts..., Extra...>;
+    };
+
+    /// @brief Event list with extra types appended.
+    template <typename List, typename... Extra>
+    using extend_events_t = typename extend_events<List, Extra...>::type;
+
+} // namespace engine::events
@@ -1,43 +1,281 @@
 #pragma once
 
+#include "errors/error_code.hpp"
 #include "event.hpp"
+#include "payload_store.hpp"
+#include "timing/timer_wheel.hpp"
 
-#include <queue>
-#include <memory>
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 namespace engine::events
 {
     /**
      * @brief A FIFO queue for managing event objects in the simulation.
+     *
+     * Backed by a growable power of two ring buffer. Capacity only ever grows, so once the queue
+     * has seen its peak depth (or was reserved up front) push and pop never allocate.
+     *
+     * @tparam Event Variant over the engine's event list.
      */
-    class event_queue
+    template <typename Event>
+    class basic_event_queue
     {
     public:
+        /// @brief Default initial ring capacity.
+        static constexpr size_t default_capacity = 1024;
+
+        /**
+         * @brief Construct a queue.
+         * @param capacity Initial ring capacity, rounded up to a power of two.
+         */
+        explicit basic_event_queue(size_t capacity = default_capacity)
+        {
+            grow(capacity);
+        }
+
         /**
          * @brief Push a new event onto the queue.
-         * @param ev A unique pointer to an event object.
+         *
+         * Events with a time_point timestamp (timestamp_ or timestamp) pushed unset are stamped
+         * with now().
+         *
+         * @param ev Event to enqueue.
          */
-        void push(event ev);
+        void push(const Event &ev)
+        {
+            if (size() == buffer_.size()) [[unlikely]]
+            {
+                grow(buffer_.size() * 2);
+            }
+            auto &slot = buffer_[tail_++ & mask_];
+            slot = ev;
+            stamp(slot);
+        }
 
         /**
          * @brief Pop the next event from the queue.
-         * @return A unique pointer to the next event.
-         * @note Assumes queue is not empty; call `empty()` before popping.
+         * @return The next event.
+         * @throws std::runtime_error if the queue is empty, aborts instead under -fno-exceptions.
+         */
+        Event pop()
+        {
+            Event ev;
+            if (!try_pop(ev)) [[unlikely]]
+            {
+                errors::raise<std::runtime_error>("Queue empty!");
+            }
+            return ev; // NRVO
+        }
+
+        /**
+         * @brief Pop the next event, reporting an empty queue by code.
+         * @param out Receives the next event if one is available.
+         * @return errc::ok, or errc::queue_empty.
+         */
+        errors::errc pop(Event &out) noexcept
+        {
+            return try_pop(out) ? errors::errc::ok : errors::errc::queue_empty;
+        }
+
+        /**
+         * @brief Pop the next event without throwing.
+         * @param out Receives the next event if one is available.
+         * @return True if an event was popped, false if the queue was empty.
+         */
+        bool try_pop(Event &out) noexcept
+        {
+            if (empty())
+            {
+                return false;
+            }
+            out = buffer_[head_++ & mask_];
+            return true;
+        }
+
+        /**
+         * @brief Pop up to out.size() events in FIFO order.
+         * @param out Destination for popped events.
+         * @return Number of events popped, 0 if the queue was empty.
          */
-        event pop();
+        size_t pop_batch(std::span<Event> out) noexcept
+        {
+            const auto n = std::min(out.size(), size());
+            // At most two contiguous segments either side of the wrap
+            const auto start = head_ & mask_;
+            const auto first = std::min(n, buffer_.size() - start);
+            std::copy_n(buffer_.begin() + static_cast<std::ptrdiff_t>(start), first, out.begin());
+            std::copy_n(buffer_.begin(), n - first, out.begin() + static_cast<std::ptrdiff_t>(first));
+            head_ += n;
+            return n;
+        }
 
         /**
          * @brief Check whether the queue is empty.
          * @return True if empty, false otherwise.
          */
-        bool empty() const;
+        bool empty() const noexcept { return head_ == tail_; }
 
         /**
          * @brief Get size of current queue.
          */
-        size_t size() const noexcept;
+        size_t size() const noexcept { return tail_ - head_; }
+
+        /**
+         * @brief Get current ring capacity.
+         */
+        size_t capacity() const noexcept { return buffer_.size(); }
+
+        /**
+         * @brief Ensure the ring can hold at least n events without allocating.
+         * @param n Required capacity, rounded up to a power of two.
+         */
+        void reserve(size_t n)
+        {
+            if (n > buffer_.size())
+            {
+                grow(n);
+            }
+        }
+
+        /**
+         * @brief Engine time used to stamp events, set by the engine from its clock.
+         */
+        std::chrono::system_clock::time_point now() const noexcept { return now_; }
+
+        /**
+         * @brief Set engine time used to stamp events.
+         */
+        void set_now(std::chrono::system_clock::time_point now) noexcept { now_ = now; }
+
+        /**
+         * @brief Side store for payloads referenced by queued events.
+         */
+        payload_store &payloads() noexcept { return payloads_; }
+
+        /**
+         * @brief Const side store getter.
+         */
+        const payload_store &payloads() const noexcept { return payloads_; }
+
+        /**
+         * @brief Timers the engine fires as timer_event on its clock, so handlers can schedule them.
+         */
+        timing::timer_wheel &timers() noexcept { return timers_; }
+
+        /**
+         * @brief Const timer wheel getter.
+         */
+        const timing::timer_wheel &timers() const noexcept { return timers_; }
+
+        /**
+         * @brief Save pending events in FIFO order, engine time, the payload store and timers.
+         */
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            static_assert(std::is_trivially_copyable_v<Event>, "snapshots copy events as raw bytes");
+            out.section(checkpoint::tag("EVTQ"));
+            out.put(now_);
+            out.put(static_cast<uint64_t>(size()));
+            for (size_t i = head_; i != tail_; ++i)
+            {
+                out.put(buffer_[i & mask_]);
+            }
+            payloads_.save(out);
+            timers_.save(out);
+        }
+
+        /**
+         * @brief Replace the queue with a saved one. Capacity is kept, growing if needed.
+         * @throws std::runtime_error if the section is truncated or holds an event of no known
+         *         alternative, checked before the queue is touched.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.section(checkpoint::tag("EVTQ"));
+            const auto now = in.get<std::chrono::system_clock::time_point>();
+            size_t count = 0;
+            const auto *data = in.get_span<Event>(count);
+            // A corrupt alternative index would make every later visit undefined
+            for (size_t i = 0; i < count; ++i)
+            {
+                Event ev;
+                checkpoint::snapshot_reader::element(data, i, ev);
+                if (ev.index() >= std::variant_size_v<Event>)
+                {
+                    errors::raise<std::runtime_error>("Corrupt snapshot, event queue");
+                }
+            }
+            now_ = now;
+            head_ = 0;
+            tail_ = 0;
+            reserve(count);
+            for (; tail_ < count; ++tail_)
+            {
+                checkpoint::snapshot_reader::element(data, tail_, buffer_[tail_]);
+            }
+            payloads_.restore(in);
+            timers_.restore(in);
+        }
 
     private:
-        std::queue<event> queue_;
+        /// @brief Fill in a missing timestamp from engine time.
+        void stamp(Event &ev) const noexcept
+        {
+            std::visit([this](auto &e)
+                       {
+                constexpr std::chrono::system_clock::time_point unset{};
+                if constexpr (requires { e.timestamp_ = unset; })
+                {
+                    if (e.timestamp_ == unset)
+                    {
+                        e.timestamp_ = now_;
+                    }
+                }
+                else if constexpr (requires { e.timestamp = unset; })
+                {
+                    if (e.timestamp == unset)
+                    {
+                        e.timestamp = now_;
+                    }
+                } }, ev);
+        }
+
+        /// @brief Reallocate ring to new capacity, unwrapping pending events to the front.
+        void grow(size_t capacity)
+        {
+            // Power of two so wrap is a mask
+            capacity = std::bit_ceil(capacity < 2 ? size_t{2} : capacity);
+
+            // Copy pending events to the front of the new ring
+            std::vector<Event> next(capacity);
+            const auto count = size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                next[i] = buffer_[(head_ + i) & mask_];
+            }
+
+            buffer_ = std::move(next);
+            mask_ = capacity - 1;
+            head_ = 0;
+            tail_ = count;
+        }
+
+        std::vector<Event> buffer_;                   ///< Ring storage, size is a power of two.
+        size_t mask_{0};                              ///< Index mask.
+        size_t head_{0};                              ///< Monotonic read position.
+        size_t tail_{0};                              ///< Monotonic write position.
+        std::chrono::system_clock::time_point now_{}; ///< Engine time for stamping.
+        payload_store payloads_;                      ///< Heavy payloads referenced by handle.
+        timing::timer_wheel timers_;                  ///< Timers pending on the engine clock.
     };
+
+    /// @brief Queue over the core event list.
+    using event_queue = basic_event_queue<event>;
+
 } // namespace engine::events
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::events
+{
+    /// @brief Engine wide numeric order identifier.
+    using order_id = uint64_t;
+
+    /// @brief Sentinel for an unassigned order ID, generators never issue it.
+    inline constexpr order_id invalid_order_id = 0;
+
+} // namespace engine::events
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::events
+{
+    /**
+     * @brief Typed handle to a payload held in the side payload store.
+     *
+     * Lets compact events reference heavy data (ticks, orders, reasons) without copying it.
+     * A default constructed handle references nothing.
+     *
+     * @tparam T Payload type referenced.
+     */
+    template <typename T>
+    struct payload_ref
+    {
+        uint32_t seq_{0}; ///< Store sequence number, 0 is null.
+
+        explicit operator bool() const noexcept { return seq_ != 0; }
+        friend bool operator==(payload_ref, payload_ref) noexcept = default;
+    };
+
+} // namespace engine::events
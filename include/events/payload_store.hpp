@@ -0,0 +1,166 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+#include "events/event.hpp"
+
+#include <bit>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::events
+{
+    /**
+     * @brief Side store for heavy event payloads referenced by handle.
+     *
+     * Ticks and orders are retained in fixed size revolving rings so compact events can point at
+     * them without copying. A handle stays valid until the ring wraps past it, after which lookups
+     * return nullptr. Cancel reasons are a small closed set and are interned for the store lifetime.
+     */
+    class payload_store
+    {
+    public:
+        /// @brief Default number of ticks and orders retained.
+        static constexpr size_t default_capacity = 1u << 16;
+
+        /**
+         * @brief Construct a store.
+         * @param capacity Entries retained per ring, rounded up to a power of two.
+         */
+        explicit payload_store(size_t capacity = default_capacity)
+            : ticks_(capacity), orders_(capacity)
+        {
+        }
+
+        /**
+         * @brief Retain a tick.
+         * @return Handle to the retained copy.
+         */
+        tick_ref retain(const market_event &tick) noexcept { return ticks_.retain(tick); }
+
+        /**
+         * @brief Retain an order.
+         * @return Handle to the retained copy.
+         */
+        order_ref retain(const order_event &order) noexcept { return orders_.retain(order); }
+
+        /**
+         * @brief Resolve a tick handle.
+         * @return Retained tick, or nullptr if null or already evicted.
+         */
+        const market_event *tick(tick_ref ref) const noexcept { return ticks_.get(ref); }
+
+        /**
+         * @brief Resolve an order handle.
+         * @return Retained order, or nullptr if null or already evicted.
+         */
+        const order_event *order(order_ref ref) const noexcept { return orders_.get(ref); }
+
+        /**
+         * @brief Intern a cancel reason.
+         * @param reason Reason text.
+         * @return Handle to the interned text.
+         */
+        reason_ref intern_reason(std::string_view reason);
+
+        /**
+         * @brief Resolve a reason handle.
+         * @return Reason text, empty if null.
+         */
+        std::string_view reason(reason_ref ref) const noexcept;
+
+        /**
+         * @brief Save retained payloads and interned reasons, so saved handles stay resolvable.
+         */
+        void save(checkpoint::snapshot_writer &out) const;
+
+        /**
+         * @brief Replace all payloads with a saved store, including its ring capacity.
+         */
+        void restore(checkpoint::snapshot_reader &in);
+
+    private:
+        /**
+         * @brief Power of two revolving ring of payloads keyed by sequence number.
+         */
+        template <typename T>
+        class payload_ring
+        {
+        public:
+            explicit payload_ring(size_t capacity)
+                : slots_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)), mask_(slots_.size() - 1)
+            {
+            }
+
+            payload_ref<T> retain(const T &value) noexcept
+            {
+                // Skip the null sequence on wrap
+                if (++next_ == 0)
+                {
+                    ++next_;
+                }
+                auto &slot = slots_[next_ & mask_];
+                slot.seq_ = next_;
+                slot.value_ = value;
+                return payload_ref<T>{next_};
+            }
+
+            const T *get(payload_ref<T> ref) const noexcept
+            {
+                if (!ref)
+                {
+                    return nullptr;
+                }
+                // Slot may have been overwritten since
+                const auto &slot = slots_[ref.seq_ & mask_];
+                return slot.seq_ == ref.seq_ ? &slot.value_ : nullptr;
+            }
+
+            void save(checkpoint::snapshot_writer &out) const
+            {
+                out.put(next_);
+                out.put_span(std::span{slots_});
+            }
+
+            void restore(checkpoint::snapshot_reader &in)
+            {
+                in.get(next_);
+                in.get_vector(slots_);
+                if (!std::has_single_bit(slots_.size()))
+                {
+                    errors::raise<std::runtime_error>("Corrupt snapshot payload ring");
+                }
+                mask_ = slots_.size() - 1;
+            }
+
+        private:
+            struct entry
+            {
+                uint32_t seq_{0}; ///< Sequence of the retained value.
+                T value_{};       ///< Retained value.
+            };
+
+            std::vector<entry> slots_; ///< Ring storage.
+            size_t mask_;              ///< Index mask.
+            uint32_t next_{0};         ///< Last issued sequence.
+        };
+
+        /// @brief Transparent hash so reason lookups by string_view don't allocate.
+        struct reason_hash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view sv) const noexcept { return std::hash<std::string_view>{}(sv); }
+        };
+
+        payload_ring<market_event> ticks_;                                                   ///< Retained ticks.
+        payload_ring<order_event> orders_;                                                   ///< Retained orders.
+        std::vector<std::string> reasons_;                                                   ///< Interned reasons, handle - 1 indexed.
+        std::unordered_map<std::string, uint32_t, reason_hash, std::equal_to<>> reason_ids_; ///< Reason to handle index.
+    };
+
+} // namespace engine::events
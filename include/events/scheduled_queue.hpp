@@ -0,0 +1,239 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+#include "event.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace engine::events
+{
+    /**
+     * @brief Discrete event scheduler ordered by simulated timestamp.
+     *
+     * Monotone radix heap: keys may never be scheduled before the last popped key, which always
+     * holds in a discrete event simulation. Push is O(1) and pop is amortised O(log range) with no
+     * comparisons between events. Looking at the earliest event without popping it leaves the
+     * buckets as they are, so an event scheduled afterwards may still fall before it. Events due at the same timestamp pop in push order. Bucket
+     * storage is retained, so the scheduler stops allocating once warmed up.
+     *
+     * @tparam Event Variant over the engine's event list.
+     */
+    template <typename Event>
+    class basic_scheduled_queue
+    {
+    public:
+        /**
+         * @brief Schedule an event.
+         * @param due Simulated timestamp in nanoseconds, clamped to now() if earlier.
+         * @param ev Event to deliver.
+         */
+        void push(uint64_t due, const Event &ev)
+        {
+            if (due < last_)
+            {
+                due = last_;
+            }
+            const auto b = bucket_of(due);
+            buckets_[b].push_back({due, ev});
+            if (b != 0 && next_ != unknown && due < next_)
+            {
+                next_ = due;
+            }
+            ++size_;
+        }
+
+        /**
+         * @brief Pop the earliest event if it is due.
+         * @param until Pop only events due at or before this timestamp.
+         * @param out Receives the event.
+         * @return True if an event was popped.
+         */
+        bool pop_until(uint64_t until, Event &out)
+        {
+            // Only an event that pops moves last_, the key pushes are clamped to
+            if (size_ == 0 || next_due() > until)
+            {
+                return false;
+            }
+            refill();
+            out = buckets_[0][head_++].ev_;
+            --size_;
+            return true;
+        }
+
+        /**
+         * @brief Pop the earliest event regardless of timestamp.
+         * @param out Receives the event.
+         * @return True if an event was popped.
+         */
+        bool pop(Event &out) { return pop_until(std::numeric_limits<uint64_t>::max(), out); }
+
+        /**
+         * @brief Timestamp of the earliest scheduled event, or max if empty.
+         */
+        uint64_t next_due() noexcept
+        {
+            if (head_ < buckets_[0].size())
+            {
+                return last_;
+            }
+            if (next_ == unknown)
+            {
+                // Bucket 0 is spent, the minimum is in the first non-empty bucket
+                for (size_t i = 1; i < buckets_.size() && next_ == unknown; ++i)
+                {
+                    for (const auto &e : buckets_[i])
+                    {
+                        next_ = e.due_ < next_ ? e.due_ : next_;
+                    }
+                }
+            }
+            return next_;
+        }
+
+        /**
+         * @brief Timestamp of the last popped event, the scheduler's notion of now.
+         */
+        uint64_t now() const noexcept { return last_; }
+
+        bool empty() const noexcept { return size_ == 0; }
+        size_t size() const noexcept { return size_; }
+
+        /**
+         * @brief Save the scheduled events and the scheduler's now().
+         */
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            static_assert(std::is_trivially_copyable_v<Event>, "snapshots copy events as raw bytes");
+            out.section(checkpoint::tag("SCHD"));
+            out.put(last_);
+            out.put(static_cast<uint64_t>(size_));
+            for (size_t i = head_; i < buckets_[0].size(); ++i)
+            {
+                out.put(buckets_[0][i]);
+            }
+            for (size_t b = 1; b < buckets_.size(); ++b)
+            {
+                for (const auto &e : buckets_[b])
+                {
+                    out.put(e);
+                }
+            }
+        }
+
+        /**
+         * @brief Replace the schedule with a saved one.
+         *
+         * Events are pushed back bucket by bucket, which keeps events due at the same time in
+         * their original order.
+         *
+         * @throws std::runtime_error if the section is truncated, or holds an event of no known
+         *         alternative or due before now(), checked before the schedule is touched.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.section(checkpoint::tag("SCHD"));
+            const auto last = in.get<uint64_t>();
+            size_t count = 0;
+            const auto *data = in.get_span<entry>(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                entry e{};
+                checkpoint::snapshot_reader::element(data, i, e);
+                if (e.due_ < last || e.ev_.index() >= std::variant_size_v<Event>)
+                {
+                    errors::raise<std::runtime_error>("Corrupt snapshot, scheduler");
+                }
+            }
+            for (auto &bucket : buckets_)
+            {
+                bucket.clear();
+            }
+            head_ = 0;
+            size_ = 0;
+            next_ = unknown;
+            last_ = last;
+            for (size_t i = 0; i < count; ++i)
+            {
+                entry e{};
+                checkpoint::snapshot_reader::element(data, i, e);
+                push(e.due_, e.ev_);
+            }
+        }
+
+    private:
+        struct entry
+        {
+            uint64_t due_; ///< Simulated delivery time.
+            Event ev_;     ///< Scheduled event.
+        };
+
+        /// @brief 0 for keys equal to last, else index of highest bit differing from last plus one.
+        size_t bucket_of(uint64_t key) const noexcept
+        {
+            return key == last_ ? 0 : static_cast<size_t>(std::bit_width(key ^ last_));
+        }
+
+        /**
+         * @brief Ensure bucket 0 holds the minimum, redistributing the first non-empty bucket.
+         * @return False if the heap is empty.
+         */
+        bool refill()
+        {
+            auto &front = buckets_[0];
+            if (head_ < front.size())
+            {
+                return true;
+            }
+            front.clear();
+            head_ = 0;
+
+            size_t i = 1;
+            while (i < buckets_.size() && buckets_[i].empty())
+            {
+                ++i;
+            }
+            if (i == buckets_.size())
+            {
+                return false;
+            }
+
+            // New minimum becomes last, every entry in the bucket lands strictly lower
+            auto &src = buckets_[i];
+            uint64_t min = std::numeric_limits<uint64_t>::max();
+            for (const auto &e : src)
+            {
+                min = e.due_ < min ? e.due_ : min;
+            }
+            last_ = min;
+            next_ = unknown;
+            for (const auto &e : src)
+            {
+                buckets_[bucket_of(e.due_)].push_back(e);
+            }
+            src.clear();
+            return true;
+        }
+
+        std::array<std::vector<entry>, 65> buckets_; ///< Buckets by highest differing bit.
+        /// @brief next_ when it must be found again, also the empty heap's next_due().
+        static constexpr uint64_t unknown = std::numeric_limits<uint64_t>::max();
+
+        uint64_t last_{0};                           ///< Last extracted minimum.
+        uint64_t next_{unknown};                     ///< Earliest due time outside bucket 0, if known.
+        size_t head_{0};                             ///< Read position in bucket 0, keeps ties FIFO.
+        size_t size_{0};                             ///< Scheduled event count.
+    };
+
+    /// @brief Scheduler over the core event list.
+    using scheduled_queue = basic_scheduled_queue<event>;
+
+} // namespace engine::events
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::events
+{
+    /// @brief Handle to a scheduled timer, stale once it has fired or been cancelled.
+    using timer_id = uint64_t;
+
+    /// @brief Sentinel for no timer, wheels never issue it.
+    inline constexpr timer_id invalid_timer = 0;
+
+} // namespace engine::events
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
 #include "orders/order_state.hpp"
 #include "orders/order_queue.hpp"
 #include "events/event.hpp"
 #include "events/event_queue.hpp"
 
+#include <string_view>
 #include <unordered_map>
 
 namespace engine
@@ -23,24 +26,41 @@ namespace engine
          * @param order Order event from strategy.
          * @param queue Event queue.
          */
+        template <typename Queue>
         void on_order(const events::order_event &order,
-                      events::event_queue &queue)
+                      Queue &queue)
         {
             // Dispatch to derived class
             derived()->on_order(order, queue);
         }
 
         /**
-         * @brief Lookup an order's state by its ID.
+         * @brief Lookup an order's state by its ID, resting or recently filled or cancelled.
          *
          * @param order_id Unique order identifier.
          * @return const order_state* Pointer to the order state if found,
-         *         or nullptr if no such order exists.
+         *         or nullptr if no such order exists or it has aged out of the ledger.
          */
-        const engine::orders::order_state *get_order(const std::string &order_id) const noexcept
+        const engine::orders::order_state *get_order(events::order_id order_id) const noexcept
         {
             auto ord = orders_.get(order_id);
-            return ord;
+            return ord ? ord : orders_.retired(order_id);
+        }
+
+        /**
+         * @brief Save tracked orders. Handlers with state of their own extend this and call it.
+         */
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            orders_.save(out);
+        }
+
+        /**
+         * @brief Restore tracked orders.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            orders_.restore(in);
         }
 
     protected:
@@ -54,21 +74,35 @@ namespace engine
          * @param filled_qty Filled portion of order.
          * @param exec_price Price of execution order.
          * @param queue Queue to add fill to.
-         * @param time_stamp Time stamp of order.
+         * @param time_stamp Time stamp of fill, defaults to engine clock time when queued.
+         * @return errc::ok, errc::invalid_quantity for a fill of zero or less, or errc::overfill once
+         *         fills exceed the order quantity. The fill is applied and emitted either way, the
+         *         code only reports it, and a handler may return it for the engine to count. A fill
+         *         for an order that already left the book is emitted but not applied, its final
+         *         state stays as retired, and is reported as errc::overfill if it completed or
+         *         errc::unknown_order if it was cancelled.
          */
-        void emit_fill(const events::order_event &order,
-                       int64_t filled_qty,
-                       double exec_price,
-                       events::event_queue &queue,
-                       std::chrono::system_clock::time_point time_stamp = std::chrono::system_clock::now())
+        template <typename Queue>
+        errors::errc emit_fill(const events::order_event &order,
+                               int64_t filled_qty,
+                               double exec_price,
+                               Queue &queue,
+                               std::chrono::system_clock::time_point time_stamp = {})
         {
             // Update order state
             auto st = orders_.get(order.order_id_);
             if (!st)
             {
+                // A late fill must not put a completed or cancelled order back in the book
+                if (const auto *done = orders_.retired(order.order_id_))
+                {
+                    push_fill(order, filled_qty, exec_price, queue, time_stamp);
+                    return done->filled_qty_ >= done->order_.quantity_ ? errors::errc::overfill
+                                                                       : errors::errc::unknown_order;
+                }
+
                 // First time we've seen this order
-                orders_.emplace({order});
-                st = orders_.get(order.order_id_);
+                st = &orders_.emplace(order);
             }
 
             // Update fill progress
@@ -84,22 +118,18 @@ namespace engine
                 st->avg_fill_price_ = 0.0; // guard for zero division
             }
 
+            auto result = filled_qty > 0 ? errors::errc::ok : errors::errc::invalid_quantity;
             if (st->filled_qty_ >= st->order_.quantity_)
             {
+                if (st->filled_qty_ > st->order_.quantity_) [[unlikely]]
+                {
+                    result = errors::errc::overfill;
+                }
                 orders_.inactive(st->order_.order_id_);
             }
 
-            events::fill_event fill{
-                order.symbol_,
-                order.order_id_,
-                filled_qty,
-                order.quantity_, // total order size
-                order.is_buy_,
-                exec_price,
-                order,
-                time_stamp};
-
-            queue.push(std::move(fill));
+            push_fill(order, filled_qty, exec_price, queue, time_stamp);
+            return result;
         }
 
         /**
@@ -108,23 +138,51 @@ namespace engine
          * @param order Order to cancel.
          * @param reason Reason for cancel.
          * @param queue Queue to add event to.
+         * @return errc::ok, or errc::unknown_order if the order was not resting, never seen or
+         *         already filled or cancelled. The cancel is emitted either way, and a handler may
+         *         return the code for the engine to count.
          */
-        void emit_cancel(const events::order_event &order, const std::string &reason, events::event_queue &queue) noexcept
+        template <typename Queue>
+        errors::errc emit_cancel(const events::order_event &order, std::string_view reason, Queue &queue) noexcept
         {
             // Make order inactive
-            orders_.inactive(order.order_id_);
+            const auto result = orders_.inactive(order.order_id_);
 
-            // Emit cancel
+            // Emit cancel, order and reason are held by the payload store
+            auto &payloads = queue.payloads();
             events::cancel_event cancel{
                 order,
-                reason};
+                payloads.retain(order),
+                payloads.intern_reason(reason)};
 
             queue.push(std::move(cancel));
+            return result;
         }
 
-        orders::order_queue orders_; ///< Order state tracking.
+        orders::order_queue orders_{orders::order_queue::ledger_capacity}; ///< Order state tracking, a book per symbol, with a full ledger for late fills.
 
     private:
+        /// @brief Push a fill event for an order, which the payload store retains.
+        template <typename Queue>
+        static void push_fill(const events::order_event &order,
+                              int64_t filled_qty,
+                              double exec_price,
+                              Queue &queue,
+                              std::chrono::system_clock::time_point time_stamp)
+        {
+            events::fill_event fill{
+                order.symbol_,
+                order.order_id_,
+                filled_qty,
+                order.quantity_, // total order size
+                order.is_buy_,
+                exec_price,
+                queue.payloads().retain(order),
+                time_stamp};
+
+            queue.push(std::move(fill));
+        }
+
         /// Internal getter for derived.
         Derived &derived()
         {
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "ingest/tick_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::ingest
+{
+    /**
+     * @brief Read only streamer over ticks and a symbol table owned elsewhere.
+     *
+     * Holds a position and two references, so any number of cursors can replay one dataset
+     * concurrently. The dataset must outlive the cursor and stay unmodified while it is read.
+     */
+    class tick_cursor
+    {
+    public:
+        /**
+         * @brief Construct a cursor at the first tick.
+         * @param ticks Ticks to replay.
+         * @param names Table naming the ticks' symbol IDs.
+         */
+        tick_cursor(std::span<const tick_view> ticks, const symbols::symbol_registry &names) noexcept
+            : ticks_(ticks), names_(&names)
+        {
+        }
+
+        /**
+         * @brief Next tick.
+         * @return Pointer into the dataset, or nullptr once exhausted.
+         */
+        const tick_view *next_view() noexcept
+        {
+            return cursor_ < ticks_.size() ? &ticks_[cursor_++] : nullptr;
+        }
+
+        /**
+         * @brief Copy out the next ticks.
+         * @param out Destination.
+         * @return Number of ticks copied, 0 once exhausted.
+         */
+        size_t next_batch(std::span<tick_view> out) noexcept
+        {
+            const auto n = std::min(out.size(), ticks_.size() - cursor_);
+            std::copy_n(ticks_.begin() + static_cast<std::ptrdiff_t>(cursor_), n, out.begin());
+            cursor_ += n;
+            return n;
+        }
+
+        /**
+         * @brief Name of a dataset symbol ID.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept { return names_->name(id); }
+
+        /**
+         * @brief Restart replay from the first tick.
+         */
+        void rewind() noexcept { cursor_ = 0; }
+
+        /**
+         * @brief Save the replay position. The dataset itself is not saved.
+         */
+        void save(checkpoint::snapshot_writer &out) const { out.put(static_cast<uint64_t>(cursor_)); }
+
+        /**
+         * @brief Resume replay at a saved position over the same dataset.
+         */
+        void restore(checkpoint::snapshot_reader &in) { cursor_ = std::min(in.get_count(), ticks_.size()); }
+
+        /**
+         * @brief Number of ticks in the dataset.
+         */
+        size_t size() const noexcept { return ticks_.size(); }
+
+    private:
+        std::span<const tick_view> ticks_;      ///< Shared ticks.
+        const symbols::symbol_registry *names_; ///< Shared symbol table.
+        size_t cursor_{0};                      ///< Next tick to hand out.
+    };
+
+    /**
+     * @brief In memory view streamer over a preloaded run of ticks.
+     *
+     * Ticks are stored fixed width with symbols interned into a local table, so replay hands out
+     * pointers into contiguous storage, or copies out whole batches. Suited to backtests over a dataset loaded up front.
+     */
+    class tick_buffer
+    {
+    public:
+        /**
+         * @brief Append a tick.
+         * @param symbol Trade symbol, interned locally.
+         */
+        void add(std::string_view symbol, double price, double qty, int64_t timestamp_ms, bool is_buyer_match)
+        {
+            ticks_.push_back({names_.intern(symbol), price, qty, timestamp_ms, is_buyer_match});
+        }
+
+        /**
+         * @brief Append everything a batch streamer provides, e.g. a journal replay.
+         * @param source Streamer to drain.
+         */
+        template <typename Source>
+            requires batch_streamer<Source>
+        void load(Source &source)
+        {
+            std::array<tick_view, 256> batch;
+            symbol_map local;
+            while (const size_t n = source.next_batch(std::span{batch}))
+            {
+                for (auto &tick : std::span{batch.data(), n})
+                {
+                    bool fresh = false;
+                    tick.symbol = local.resolve(tick.symbol, names_, [&source](symbols::symbol_id id)
+                                                { return std::string_view{source.symbol_name(id)}; }, fresh);
+                    ticks_.push_back(tick);
+                }
+            }
+        }
+
+        /**
+         * @brief Read only cursor sharing this buffer's storage, see tick_cursor.
+         */
+        tick_cursor cursor() const noexcept { return tick_cursor{ticks_, names_}; }
+
+        /**
+         * @brief Next tick.
+         * @return Pointer into the buffer, or nullptr once exhausted.
+         */
+        const tick_view *next_view() noexcept
+        {
+            return cursor_ < ticks_.size() ? &ticks_[cursor_++] : nullptr;
+        }
+
+        /**
+         * @brief Copy out the next ticks.
+         * @param out Destination.
+         * @return Number of ticks copied, 0 once exhausted.
+         */
+        size_t next_batch(std::span<tick_view> out) noexcept
+        {
+            const auto n = std::min(out.size(), ticks_.size() - cursor_);
+            std::copy_n(ticks_.begin() + static_cast<std::ptrdiff_t>(cursor_), n, out.begin());
+            cursor_ += n;
+            return n;
+        }
+
+        /**
+         * @brief Name of a local symbol ID.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept { return names_.name(id); }
+
+        /**
+         * @brief Restart replay from the first tick.
+         */
+        void rewind() noexcept { cursor_ = 0; }
+
+        /**
+         * @brief Save the replay position. Ticks are not saved, restore into a buffer loaded with the same data.
+         */
+        void save(checkpoint::snapshot_writer &out) const { out.put(static_cast<uint64_t>(cursor_)); }
+
+        /**
+         * @brief Resume replay at a saved position.
+         */
+        void restore(checkpoint::snapshot_reader &in) { cursor_ = std::min(in.get_count(), ticks_.size()); }
+
+        /**
+         * @brief Number of ticks held.
+         */
+        size_t size() const noexcept { return ticks_.size(); }
+
+    private:
+        std::vector<tick_view> ticks_;   ///< Fixed width ticks.
+        symbols::symbol_registry names_; ///< Local symbol table.
+        size_t cursor_{0};               ///< Next tick to hand out.
+    };
+
+} // namespace engine::ingest
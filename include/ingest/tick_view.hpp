@@ -0,0 +1,113 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "symbols/symbol_registry.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine::ingest
+{
+    /**
+     * @brief Fixed width tick a streamer can hand out by pointer.
+     *
+     * The symbol is the streamer's own dense ID, resolved to a name through symbol_name() only the
+     * first time the engine sees it.
+     */
+    struct tick_view
+    {
+        symbols::symbol_id symbol; ///< Streamer local symbol ID.
+        double price;              ///< Trade price at the time of the tick.
+        double qty;                ///< Quantity of the base asset traded.
+        int64_t timestamp_ms;      ///< Epoch timestamp of the trade in milliseconds.
+        bool is_buyer_match;       ///< True if the buyer initiated the trade (i.e., aggressive buy).
+    };
+
+    /**
+     * @brief Streamer handing out ticks by pointer into its own storage.
+     *
+     * next_view() returns a pointer to the next tick, or nullptr when none is available. The
+     * pointee only needs to stay valid until the following call. The tick exposes the same fields
+     * as an owning tick, with the symbol as a string_view or a streamer local symbol ID.
+     */
+    template <typename S>
+    concept view_streamer = requires(S &s) {
+        { s.next_view() } -> std::convertible_to<const void *>;
+        { s.next_view()->price } -> std::convertible_to<double>;
+        { s.next_view()->qty } -> std::convertible_to<double>;
+        { s.next_view()->timestamp_ms } -> std::convertible_to<int64_t>;
+        { s.next_view()->is_buyer_match } -> std::convertible_to<bool>;
+    };
+
+    /**
+     * @brief View streamer whose ticks carry a symbol ID, named on demand through symbol_name().
+     *
+     * Ingestion cost is then a table lookup per tick, independent of symbol length.
+     */
+    template <typename S>
+    concept id_view_streamer = view_streamer<S> && requires(S &s, symbols::symbol_id id) {
+        requires std::is_integral_v<std::remove_cvref_t<decltype(s.next_view()->symbol)>>;
+        { s.symbol_name(id) } -> std::convertible_to<std::string_view>;
+    };
+
+    /**
+     * @brief Streamer filling caller provided batches of fixed width ticks.
+     *
+     * next_batch() writes up to out.size() ticks and returns how many it wrote, 0 when none are
+     * available. Symbols are streamer local IDs named through symbol_name(), as for
+     * id_view_streamer.
+     */
+    template <typename S>
+    concept batch_streamer = requires(S &s, std::span<tick_view> out, symbols::symbol_id id) {
+        { s.next_batch(out) } -> std::convertible_to<size_t>;
+        { s.symbol_name(id) } -> std::convertible_to<std::string_view>;
+    };
+
+    /**
+     * @brief Translates streamer local symbol IDs to engine IDs.
+     *
+     * A flat table indexed by the streamer's ID, filled the first time each ID is seen.
+     */
+    class symbol_map
+    {
+    public:
+        /**
+         * @brief Engine ID for a streamer ID.
+         * @param local Streamer local ID.
+         * @param registry Engine registry, interned into on first sight.
+         * @param name Callable returning the name of local, called on first sight only.
+         * @param fresh Set true if the symbol was new to the registry.
+         */
+        template <typename Name>
+        symbols::symbol_id resolve(symbols::symbol_id local, symbols::symbol_registry &registry, Name &&name, bool &fresh)
+        {
+            if (local < ids_.size() && ids_[local] != symbols::invalid_symbol) [[likely]]
+            {
+                return ids_[local];
+            }
+            if (local >= ids_.size())
+            {
+                ids_.resize(static_cast<size_t>(local) + 1, symbols::invalid_symbol);
+            }
+            const auto known = registry.size();
+            ids_[local] = registry.intern(name(local));
+            fresh = ids_[local] == known;
+            return ids_[local];
+        }
+
+        /// @brief Save the translation table.
+        void save(checkpoint::snapshot_writer &out) const { out.put_span(std::span{ids_}); }
+
+        /// @brief Restore the translation table, valid alongside the registry it was saved with.
+        void restore(checkpoint::snapshot_reader &in) { in.get_vector(ids_); }
+
+    private:
+        std::vector<symbols::symbol_id> ids_; ///< Engine ID by streamer ID.
+    };
+
+} // namespace engine::ingest
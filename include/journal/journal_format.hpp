@@ -0,0 +1,155 @@
+#pragma once
+
+#include "events/event.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+namespace engine::journal
+{
+    /**
+     * @brief On disk layout of an event journal.
+     *
+     * A journal is a file header followed by variable length records, each a one byte kind and a
+     * payload. Event records use the variant index as kind and store the raw bytes of the
+     * alternative, so decoding is a single memcpy. Symbol records bind an ID to its name and always
+     * precede the first event that uses it, reason records do the same for interned cancel reasons.
+     * Ticks and orders an event references by handle are written as payload records, the handle's
+     * sequence and the raw payload, right before the event. A cleanly closed journal ends with an
+     * index record holding every symbol, every reason and the sparse timestamp index, followed by a
+     * fixed footer pointing at it.
+     *
+     * Raw layout makes a journal readable only by a build with the same event layout, which is
+     * checked through the header.
+     */
+
+    /// @brief Record kind for a tick referenced by the next event.
+    inline constexpr uint8_t tick_payload_record = 0xFB;
+
+    /// @brief Record kind for an order referenced by the next event.
+    inline constexpr uint8_t order_payload_record = 0xFC;
+
+    /// @brief Record kind for a cancel reason definition.
+    inline constexpr uint8_t reason_record = 0xFD;
+
+    /// @brief Record kind for a symbol definition.
+    inline constexpr uint8_t symbol_record = 0xFE;
+
+    /// @brief Record kind for the trailing index.
+    inline constexpr uint8_t index_record = 0xFF;
+
+    /// @brief Number of event kinds, one per variant alternative.
+    inline constexpr size_t event_kinds = std::variant_size_v<events::event>;
+    static_assert(event_kinds < tick_payload_record, "event kinds overlap reserved record kinds");
+
+    /// @brief Magic bytes opening every journal.
+    inline constexpr std::array<char, 8> file_magic{'Q', 'E', 'J', 'R', 'N', 'L', '0', '1'};
+
+    /// @brief Magic bytes closing a journal with an index.
+    inline constexpr std::array<char, 8> footer_magic{'Q', 'E', 'J', 'I', 'D', 'X', '0', '1'};
+
+    /// @brief Format version, bumped with every record layout change.
+    inline constexpr uint32_t format_version = 1;
+
+    /**
+     * @brief Leading file header.
+     */
+    struct file_header
+    {
+        std::array<char, 8> magic_{file_magic};      ///< Identifies the file as a journal.
+        uint32_t version_{format_version};           ///< Format version.
+        uint32_t event_size_{sizeof(events::event)}; ///< Layout check, journals are not portable across event layouts.
+    };
+
+    /**
+     * @brief Trailing footer of a cleanly closed journal.
+     */
+    struct file_footer
+    {
+        uint64_t index_offset_{0};                ///< Offset of the index record.
+        std::array<char, 8> magic_{footer_magic}; ///< Marks the footer as present.
+    };
+
+    /**
+     * @brief Sparse index entry, the offset of a record and its event time.
+     */
+    struct index_entry
+    {
+        int64_t time_ns_{0}; ///< Event time of the record in nanoseconds.
+        uint64_t offset_{0}; ///< Byte offset of the record.
+    };
+
+    /// @brief Symbol record payload ahead of the name bytes.
+    struct symbol_header
+    {
+        symbols::symbol_id id_{symbols::invalid_symbol}; ///< Symbol ID.
+        uint32_t length_{0};                             ///< Name length in bytes.
+    };
+
+    /// @brief Reason record payload ahead of the text bytes.
+    struct reason_header
+    {
+        uint32_t id_{0};     ///< Reason handle sequence.
+        uint32_t length_{0}; ///< Text length in bytes.
+    };
+
+    /// @brief Payload size of an event record by kind.
+    inline constexpr auto payload_sizes = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<size_t, event_kinds>{sizeof(std::variant_alternative_t<I, events::event>)...};
+    }(std::make_index_sequence<event_kinds>{});
+
+    /**
+     * @brief Event time used for indexing and seeking.
+     * @return Nanoseconds since epoch, or nullopt for events that carry no time.
+     */
+    inline std::optional<int64_t> event_time_ns(const events::event &ev) noexcept
+    {
+        constexpr auto ns = [](std::chrono::system_clock::time_point tp)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+        };
+        if (auto *m = std::get_if<events::market_event>(&ev))
+        {
+            return m->timestamp_ms_ * 1'000'000;
+        }
+        if (auto *o = std::get_if<events::order_event>(&ev))
+        {
+            return ns(o->timestamp_);
+        }
+        if (auto *f = std::get_if<events::fill_event>(&ev))
+        {
+            return ns(f->timestamp);
+        }
+        if (auto *c = std::get_if<events::cancel_event>(&ev))
+        {
+            return ns(c->timestamp);
+        }
+        if (auto *t = std::get_if<events::timer_event>(&ev))
+        {
+            return ns(t->timestamp);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Decode an event record payload.
+     * @param kind Record kind, must be below event_kinds.
+     * @param payload Start of the payload bytes.
+     * @param out Receives the event.
+     */
+    inline void decode_event(uint8_t kind, const std::byte *payload, events::event &out) noexcept
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            // Payload bytes are unaligned in the file, memcpy into the emplaced alternative
+            (void)((kind == I && (std::memcpy(&out.emplace<I>(), payload, payload_sizes[I]), true)) || ...);
+        }(std::make_index_sequence<event_kinds>{});
+    }
+
+} // namespace engine::journal
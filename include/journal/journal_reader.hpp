@@ -0,0 +1,197 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+#include "journal/journal_format.hpp"
+
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::journal
+{
+    /**
+     * @brief Memory mapped reader over an event journal.
+     *
+     * Records are decoded straight out of the mapping, so replay runs at memory bandwidth once the
+     * file is cached. Symbols and the sparse index come from the trailing index record when the
+     * journal was closed cleanly, otherwise they are rebuilt by one scan and a torn final record is
+     * ignored. Seeking assumes event times are non-decreasing, as stamped by the engine clock.
+     *
+     * The ticks and orders recorded with an event resolve through tick() and order() until the
+     * next event is read, reasons through reason() at any time.
+     */
+    class journal_reader
+    {
+    public:
+        /**
+         * @brief Map a journal.
+         * @param path Journal file path.
+         * @throws std::runtime_error if the file can't be mapped or isn't a journal of this layout.
+         */
+        explicit journal_reader(const std::filesystem::path &path);
+
+        /// @brief Unmaps the journal.
+        ~journal_reader();
+
+        /// @brief Owns a mapping, movable only.
+        journal_reader(journal_reader &&other) noexcept;
+        journal_reader &operator=(journal_reader &&other) noexcept;
+        journal_reader(const journal_reader &) = delete;
+        journal_reader &operator=(const journal_reader &) = delete;
+
+        /**
+         * @brief Decode the next event record, taking in the payloads recorded ahead of it and
+         * skipping definitions.
+         * @param out Receives the event.
+         * @return False at the end of the journal.
+         */
+        bool next(events::event &out) noexcept
+        {
+            tick_seq_ = 0;
+            order_seq_ = 0;
+            while (cursor_ < end_)
+            {
+                const auto kind = static_cast<uint8_t>(data_[cursor_]);
+                if (kind < event_kinds) [[likely]]
+                {
+                    decode_event(kind, data_ + cursor_ + 1, out);
+                    cursor_ += 1 + payload_sizes[kind];
+                    return true;
+                }
+                cursor_ = read_record(cursor_);
+            }
+            return false;
+        }
+
+        /**
+         * @brief Tick recorded with the last event read.
+         * @return Tick, or nullptr if the handle isn't the one recorded.
+         */
+        const events::market_event *tick(events::tick_ref ref) const noexcept
+        {
+            return ref && ref.seq_ == tick_seq_ ? &tick_ : nullptr;
+        }
+
+        /**
+         * @brief Order recorded with the last event read.
+         * @return Order, or nullptr if the handle isn't the one recorded.
+         */
+        const events::order_event *order(events::order_ref ref) const noexcept
+        {
+            return ref && ref.seq_ == order_seq_ ? &order_ : nullptr;
+        }
+
+        /**
+         * @brief Text of a recorded cancel reason.
+         * @return Text, empty if the handle was never defined.
+         */
+        std::string_view reason(events::reason_ref ref) const noexcept
+        {
+            return ref.seq_ < reasons_.size() ? std::string_view{reasons_[ref.seq_]} : std::string_view{};
+        }
+
+        /**
+         * @brief Position at the first event with a time at or after t.
+         *
+         * Jumps to the last index entry before t and scans forward from there, so at most one
+         * index stride is decoded.
+         *
+         * @param time_ns Target time in nanoseconds since epoch.
+         */
+        void seek(int64_t time_ns) noexcept;
+
+        /**
+         * @brief Position at the first record.
+         */
+        void rewind() noexcept { cursor_ = sizeof(file_header); }
+
+        /**
+         * @brief Save the read position.
+         */
+        void save(checkpoint::snapshot_writer &out) const { out.put(static_cast<uint64_t>(cursor_)); }
+
+        /**
+         * @brief Resume at a saved read position, only meaningful for the journal it was saved from.
+         * @throws std::runtime_error if the position lies outside this journal.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            const auto pos = in.get_count();
+            if (pos < sizeof(file_header) || pos > end_)
+            {
+                errors::raise<std::runtime_error>("Snapshot position outside journal");
+            }
+            cursor_ = pos;
+        }
+
+        /**
+         * @brief Name of a symbol recorded in the journal.
+         * @return Name, empty if the ID was never defined.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept
+        {
+            return id < symbols_.size() ? std::string_view{symbols_[id]} : std::string_view{};
+        }
+
+        /**
+         * @brief Number of symbols recorded.
+         */
+        size_t symbol_count() const noexcept { return symbols_.size(); }
+
+        /**
+         * @brief Sparse timestamp index.
+         */
+        std::span<const index_entry> index() const noexcept { return index_; }
+
+        /**
+         * @brief True if the journal was closed cleanly and carried its own index.
+         */
+        bool complete() const noexcept { return complete_; }
+
+    private:
+        /// @brief Load symbols and index from the trailing index record.
+        bool load_index() noexcept;
+
+        /// @brief Rebuild symbols and index by scanning every record.
+        void scan();
+
+        /**
+         * @brief Record a symbol name by ID.
+         * @return False if the ID is beyond any a journal of this size could define.
+         */
+        bool add_symbol(const symbol_header &header, const std::byte *name);
+
+        /**
+         * @brief Record a reason text by handle sequence.
+         * @return False if the sequence is beyond any a journal of this size could define.
+         */
+        bool add_reason(const reason_header &header, const std::byte *text);
+
+        /**
+         * @brief Take in the payload record at pos, or skip the definition there.
+         * @return Offset past it, or end_ if it isn't one.
+         */
+        size_t read_record(size_t pos) noexcept;
+
+        /// @brief Release the mapping.
+        void unmap() noexcept;
+
+        const std::byte *data_{nullptr};   ///< Mapped file.
+        size_t size_{0};                   ///< Mapped size.
+        size_t end_{0};                    ///< End of the records ahead of the index.
+        size_t cursor_{0};                 ///< Offset of the next record.
+        std::vector<std::string> symbols_; ///< Names by symbol ID.
+        std::vector<std::string> reasons_; ///< Reason texts by handle sequence.
+        std::vector<index_entry> index_;   ///< Sparse timestamp index.
+        events::market_event tick_{};      ///< Tick recorded with the last event.
+        events::order_event order_{};      ///< Order recorded with the last event.
+        uint32_t tick_seq_{0};             ///< Handle sequence of tick_, 0 if none.
+        uint32_t order_seq_{0};            ///< Handle sequence of order_, 0 if none.
+        bool complete_{false};             ///< Closed cleanly with an index record.
+    };
+
+} // namespace engine::journal
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "ingest/tick_view.hpp"
+#include "journal/journal_reader.hpp"
+
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace engine::journal
+{
+    /**
+     * @brief Tick replayed from a journal.
+     *
+     * The symbol views the reader's name table and stays valid for the streamer lifetime.
+     */
+    struct journal_tick
+    {
+        std::string_view symbol; ///< Trade symbol.
+        double price;            ///< Trade price at the time of the tick.
+        double qty;              ///< Quantity of the base asset traded.
+        int64_t timestamp_ms;    ///< Epoch timestamp of the trade in milliseconds.
+        bool is_buyer_match;     ///< True if the buyer initiated the trade (i.e., aggressive buy).
+    };
+
+    /**
+     * @brief Streamer replaying the market events of a journal.
+     *
+     * Only market events are replayed, everything downstream is regenerated by the engine so a
+     * deterministic strategy reproduces the recorded run. Ticks are handed out as views carrying
+     * the journal's symbol IDs, one at a time or in batches, so the engine ingests them without
+     * building strings.
+     */
+    class journal_streamer
+    {
+    public:
+        /**
+         * @brief Open a journal for replay.
+         * @param path Journal file path.
+         */
+        explicit journal_streamer(const std::filesystem::path &path)
+            : reader_(path)
+        {
+        }
+
+        /**
+         * @brief Next recorded tick.
+         * @return Tick, or nullopt once the journal is exhausted.
+         */
+        std::optional<journal_tick> next() noexcept
+        {
+            events::event ev;
+            while (reader_.next(ev))
+            {
+                if (auto *m = std::get_if<events::market_event>(&ev))
+                {
+                    return journal_tick{reader_.symbol_name(m->symbol_), m->price_, m->qty_, m->timestamp_ms_, m->is_buyer_match_};
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Next recorded tick as a view.
+         * @return Pointer valid until the next call, or nullptr once the journal is exhausted.
+         */
+        const ingest::tick_view *next_view() noexcept
+        {
+            events::event ev;
+            while (reader_.next(ev))
+            {
+                if (auto *m = std::get_if<events::market_event>(&ev))
+                {
+                    view_ = {m->symbol_, m->price_, m->qty_, m->timestamp_ms_, m->is_buyer_match_};
+                    return &view_;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Decode the next recorded ticks.
+         * @param out Destination.
+         * @return Number of ticks written, 0 once the journal is exhausted.
+         */
+        size_t next_batch(std::span<ingest::tick_view> out) noexcept
+        {
+            size_t n = 0;
+            events::event ev;
+            while (n < out.size() && reader_.next(ev))
+            {
+                if (auto *m = std::get_if<events::market_event>(&ev))
+                {
+                    out[n++] = {m->symbol_, m->price_, m->qty_, m->timestamp_ms_, m->is_buyer_match_};
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief Name of a journal symbol ID.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept { return reader_.symbol_name(id); }
+
+        /**
+         * @brief Skip to the first tick at or after a time.
+         * @param timestamp_ms Epoch time in milliseconds.
+         */
+        void seek(int64_t timestamp_ms) noexcept { reader_.seek(timestamp_ms * 1'000'000); }
+
+        /**
+         * @brief Save the replay position.
+         */
+        void save(checkpoint::snapshot_writer &out) const { reader_.save(out); }
+
+        /**
+         * @brief Resume replay at a saved position in the same journal.
+         */
+        void restore(checkpoint::snapshot_reader &in) { reader_.restore(in); }
+
+        /**
+         * @brief Underlying reader.
+         */
+        journal_reader &reader() noexcept { return reader_; }
+
+    private:
+        journal_reader reader_;    ///< Mapped journal.
+        ingest::tick_view view_{}; ///< Last tick handed out by next_view().
+    };
+
+} // namespace engine::journal
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "concurrency/spsc_ring.hpp"
+#include "events/payload_store.hpp"
+#include "journal/journal_format.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace engine::journal
+{
+    /**
+     * @brief Writer configuration.
+     */
+    struct writer_config
+    {
+        size_t ring_capacity = 1u << 16; ///< Records in flight between the hot loop and the writer thread.
+        size_t index_stride = 4096;      ///< Event records between sparse index entries.
+        size_t file_buffer = 1u << 20;   ///< Stdio buffer size for the journal file.
+    };
+
+    /**
+     * @brief Append-only binary event journal.
+     *
+     * The hot loop only copies each event into an SPSC ring, a background thread encodes records
+     * and writes them out. Appends must come from a single thread. Symbol definitions may come from
+     * any thread, but must be made before the first event referencing the symbol is appended.
+     *
+     * Payloads an event references by handle live in the appending thread's payload store, so
+     * they are resolved there, at append time, and travel through the ring as records of their own.
+     */
+    class journal_writer
+    {
+    public:
+        /**
+         * @brief Create or truncate a journal and start the writer thread.
+         * @param path Journal file path.
+         * @param config Ring, index and buffer sizes.
+         * @throws std::runtime_error if the file can't be opened.
+         */
+        explicit journal_writer(const std::filesystem::path &path, const writer_config &config = {});
+
+        /// @brief Flushes and closes the journal.
+        ~journal_writer();
+
+        /// @brief Owns a thread and a file.
+        journal_writer(const journal_writer &) = delete;
+        journal_writer &operator=(const journal_writer &) = delete;
+
+        /**
+         * @brief Append an event. Waits for the writer thread if the ring is full.
+         * @param ev Event to record.
+         */
+        void append(const events::event &ev) noexcept
+        {
+            push(entry{ev, 0, static_cast<uint8_t>(ev.index())});
+        }
+
+        /**
+         * @brief Append an event with the payloads it references.
+         *
+         * The tick of an order, the order of a fill or cancel and the reason of a cancel are
+         * resolved from the store and recorded alongside the event, those already evicted are not.
+         *
+         * @param ev Event to record.
+         * @param payloads Store the event's handles refer to.
+         */
+        void append(const events::event &ev, const events::payload_store &payloads)
+        {
+            std::visit([&](const auto &e)
+                       { append_payloads(e, payloads); }, ev);
+            append(ev);
+        }
+
+        /**
+         * @brief Bind a symbol ID to its name in the journal.
+         * @param id Interned symbol ID.
+         * @param name Symbol name.
+         */
+        void define_symbol(symbols::symbol_id id, std::string_view name);
+
+        /**
+         * @brief Drain pending events, write the index and close the file. Idempotent.
+         */
+        void close();
+
+        /**
+         * @brief False once a write has failed, the journal is incomplete.
+         */
+        bool ok() const noexcept { return !failed_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Number of appends that found the ring full.
+         */
+        uint64_t stalls() const noexcept { return ring_.producer_stalls(); }
+
+    private:
+        /**
+         * @brief Ring entry, an event or a payload of the event after it.
+         */
+        struct entry
+        {
+            events::event event_{}; ///< Event, or the payload as its alternative.
+            uint32_t seq_{0};       ///< Handle sequence of a payload.
+            uint8_t kind_{0};       ///< Record kind.
+        };
+
+        /// @brief Publish an entry, waiting for the writer thread if the ring is full.
+        void push(const entry &e) noexcept
+        {
+            while (!ring_.try_push(e)) [[unlikely]]
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        /// @brief Publish a resolved payload, nothing if it was evicted.
+        template <typename T>
+        void push_payload(uint8_t kind, uint32_t seq, const T *payload) noexcept
+        {
+            if (payload)
+            {
+                push(entry{*payload, seq, kind});
+            }
+        }
+
+        /// @brief Payloads of each event kind, none by default.
+        template <typename T>
+        void append_payloads(const T &, const events::payload_store &) noexcept
+        {
+        }
+
+        void append_payloads(const events::order_event &e, const events::payload_store &payloads) noexcept
+        {
+            push_payload(tick_payload_record, e.trigger_.seq_, payloads.tick(e.trigger_));
+        }
+
+        void append_payloads(const events::fill_event &e, const events::payload_store &payloads) noexcept
+        {
+            push_payload(order_payload_record, e.originating_order_.seq_, payloads.order(e.originating_order_));
+        }
+
+        void append_payloads(const events::cancel_event &e, const events::payload_store &payloads)
+        {
+            push_payload(order_payload_record, e.originating_order_.seq_, payloads.order(e.originating_order_));
+            if (e.reason_)
+            {
+                define_reason(e.reason_.seq_, payloads.reason(e.reason_));
+            }
+        }
+
+        /// @brief Queue a reason definition the first time its handle is appended. Appending thread only.
+        void define_reason(uint32_t id, std::string_view text);
+
+        /// @brief Writer thread body.
+        void run(std::stop_token stop);
+
+        /// @brief Write symbol and reason definitions made since the last call. Writer thread only.
+        void write_pending_definitions();
+
+        /// @brief Encode one event record. Writer thread only.
+        void write_event(const events::event &ev);
+
+        /// @brief Encode one payload record. Writer thread only.
+        void write_payload(const entry &e);
+
+        /// @brief Write the index record and footer. Writer thread only.
+        void write_index();
+
+        /// @brief Write raw bytes, tracking the file offset.
+        void write(const void *data, size_t size);
+
+        /// @brief Symbol or reason name pending a write.
+        struct name_def
+        {
+            uint32_t id_;      ///< Symbol ID or reason handle sequence.
+            std::string name_; ///< Symbol name or reason text.
+        };
+
+        concurrency::spsc_ring<entry> ring_;    ///< Hot loop to writer thread.
+        std::FILE *file_{nullptr};              ///< Journal file.
+        std::vector<char> file_buffer_;         ///< Stdio buffer.
+        size_t index_stride_;                   ///< Event records between index entries.
+        uint64_t offset_{0};                    ///< Bytes written so far.
+        uint64_t events_{0};                    ///< Event records written so far.
+        uint64_t payloads_at_{0};               ///< Offset of the payloads ahead of the next event.
+        bool payloads_open_{false};             ///< Payloads written since the last event.
+        std::vector<index_entry> index_;        ///< Sparse timestamp index.
+        std::vector<name_def> symbols_;         ///< Symbols written so far, repeated in the index record.
+        std::vector<name_def> reasons_;         ///< Reasons written so far, repeated in the index record.
+        std::vector<bool> reasons_defined_;     ///< Reason handles already queued, appending thread only.
+        std::mutex pending_mutex_;              ///< Guards pending_ and pending_reasons_.
+        std::vector<name_def> pending_;         ///< Symbols defined but not yet written.
+        std::vector<name_def> pending_reasons_; ///< Reasons defined but not yet written.
+        std::atomic<bool> failed_{false};       ///< Set on write error.
+        std::jthread thread_;                   ///< Writer thread, started last.
+    };
+
+} // namespace engine::journal
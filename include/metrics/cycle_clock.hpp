@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace engine::metrics
+{
+    /**
+     * @brief Cheap cycle counter for timing the engine loop.
+     *
+     * Reads the TSC where available, a few nanoseconds against the tens a steady_clock read can
+     * cost, and converts to nanoseconds with a ratio calibrated once per process against
+     * steady_clock. Elsewhere it falls back to steady_clock, counting nanoseconds directly.
+     *
+     * Calibration sleeps for about 10 ms, so callers timing a hot loop run calibrate() up front,
+     * as engine_base does on construction.
+     */
+    class cycle_clock
+    {
+    public:
+        /**
+         * @brief Current cycle count.
+         */
+        static uint64_t now() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch())
+                                             .count());
+#endif
+        }
+
+        /**
+         * @brief Calibrate now unless already done, blocking for the calibration window.
+         */
+        static void calibrate() noexcept { ns_per_cycle(); }
+
+        /**
+         * @brief Nanoseconds per cycle, calibrated on first call.
+         */
+        static double ns_per_cycle() noexcept;
+
+        /**
+         * @brief Convert a cycle delta to nanoseconds.
+         */
+        static uint64_t to_ns(uint64_t cycles) noexcept
+        {
+            return static_cast<uint64_t>(static_cast<double>(cycles) * ns_per_cycle());
+        }
+    };
+
+} // namespace engine::metrics
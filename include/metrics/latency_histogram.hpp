@@ -0,0 +1,135 @@
+#pragma once
+
+#include "concurrency/thread_utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine::metrics
+{
+    /**
+     * @brief Point in time copy of a latency_histogram, for computing percentiles.
+     */
+    class histogram_snapshot
+    {
+    public:
+        histogram_snapshot() = default;
+
+        /// @brief Construct from copied bucket counts.
+        histogram_snapshot(std::vector<uint64_t> counts, uint64_t total, uint64_t sum, uint64_t max) noexcept
+            : counts_(std::move(counts)), total_(total), sum_(sum), max_(max)
+        {
+        }
+
+        /**
+         * @brief Value at a quantile, to within the histogram's bucket precision.
+         * @param q Quantile in [0, 1].
+         * @return Upper bound of the bucket holding the quantile, capped at max(). 0 if empty.
+         */
+        uint64_t percentile(double q) const noexcept;
+
+        uint64_t p50() const noexcept { return percentile(0.50); }
+        uint64_t p99() const noexcept { return percentile(0.99); }
+        uint64_t p999() const noexcept { return percentile(0.999); }
+
+        /// @brief Largest recorded value.
+        uint64_t max() const noexcept { return max_; }
+
+        /// @brief Number of recorded values.
+        uint64_t count() const noexcept { return total_; }
+
+        /// @brief Mean of recorded values, 0 if empty.
+        double mean() const noexcept { return total_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(total_); }
+
+    private:
+        std::vector<uint64_t> counts_; ///< Bucket counts.
+        uint64_t total_{0};            ///< Sum of counts.
+        uint64_t sum_{0};              ///< Sum of values.
+        uint64_t max_{0};              ///< Largest value.
+    };
+
+    /**
+     * @brief Log-linear latency histogram, written by one thread and read by any.
+     *
+     * Values below 2^sub_bucket_bits land in exact buckets, above that each power of two is split
+     * into 2^(sub_bucket_bits - 1) linear buckets, bounding the relative error to about 3% over the
+     * full 64 bit range in fixed storage. Recording is a few relaxed stores with no locked
+     * instructions, snapshots read the counters without stopping the writer.
+     */
+    class latency_histogram
+    {
+    public:
+        /// @brief Bits of linear resolution.
+        static constexpr unsigned sub_bucket_bits = 6;
+
+        /// @brief Values recorded exactly.
+        static constexpr size_t linear_buckets = size_t{1} << sub_bucket_bits;
+
+        /// @brief Buckets per power of two above the linear range.
+        static constexpr size_t octave_buckets = linear_buckets / 2;
+
+        /// @brief Total buckets covering every uint64_t.
+        static constexpr size_t bucket_count = linear_buckets + (64 - sub_bucket_bits) * octave_buckets;
+
+        /**
+         * @brief Record a value. Writer thread only.
+         */
+        void record(uint64_t value) noexcept
+        {
+            concurrency::single_writer_add(counts_[index_of(value)], 1);
+            concurrency::single_writer_add(sum_, value);
+            if (value > max_.load(std::memory_order_relaxed))
+            {
+                max_.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Copy the current counts. Safe from any thread, never blocks the writer.
+         *
+         * Counters are read individually, so a snapshot taken mid record may be off by the one
+         * value being recorded.
+         */
+        histogram_snapshot snapshot() const;
+
+        /**
+         * @brief Bucket holding a value.
+         */
+        static constexpr size_t index_of(uint64_t value) noexcept
+        {
+            if (value < linear_buckets)
+            {
+                return static_cast<size_t>(value);
+            }
+            const auto shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits;
+            const auto top = static_cast<size_t>(value >> shift);
+            return linear_buckets + (shift - 1) * octave_buckets + (top - octave_buckets);
+        }
+
+        /**
+         * @brief Largest value landing in a bucket.
+         */
+        static constexpr uint64_t upper_bound(size_t index) noexcept
+        {
+            if (index < linear_buckets)
+            {
+                return index;
+            }
+            const auto k = index - linear_buckets;
+            const auto shift = static_cast<unsigned>(k / octave_buckets) + 1;
+            const auto top = static_cast<uint64_t>(octave_buckets + k % octave_buckets);
+            return ((top + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, bucket_count> counts_{}; ///< Count per bucket.
+        std::atomic<uint64_t> sum_{0};                             ///< Sum of recorded values.
+        std::atomic<uint64_t> max_{0};                             ///< Largest recorded value.
+    };
+
+} // namespace engine::metrics
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "metrics/cycle_clock.hpp"
+#include "metrics/latency_histogram.hpp"
+
+#include <cstdint>
+
+namespace engine::metrics
+{
+    /**
+     * @brief Built in latency metrics of the engine loop.
+     *
+     * One in every N loop iterations is timed with the cycle clock. Timed iterations that handled
+     * ticks are recorded into an iteration histogram and, divided across the ticks handled, a per
+     * tick histogram. Idle iterations are timed for the metrics hook only, so waiting never skews
+     * the histograms. Histograms can be snapshotted from any thread while the loop runs.
+     */
+    class loop_metrics
+    {
+    public:
+        /**
+         * @brief Set how often iterations are timed.
+         * @param every Time one in every iterations, 1 times all of them and 0 disables timing.
+         */
+        void set_sampling(uint32_t every) noexcept
+        {
+            every_ = every;
+            countdown_ = every;
+        }
+
+        /**
+         * @brief Sampling interval.
+         */
+        uint32_t sampling() const noexcept { return every_; }
+
+        /**
+         * @brief Decide whether to time the current iteration. Loop thread only.
+         */
+        bool sample() noexcept
+        {
+            if (every_ == 0 || --countdown_ != 0)
+            {
+                return false;
+            }
+            countdown_ = every_;
+            return true;
+        }
+
+        /**
+         * @brief Record a timed iteration. Loop thread only.
+         * @param ns Iteration duration.
+         * @param ticks Ticks handled by the iteration, 0 skips recording.
+         */
+        void record(uint64_t ns, size_t ticks) noexcept
+        {
+            if (ticks == 0)
+            {
+                return;
+            }
+            iteration_ns_.record(ns);
+            tick_ns_.record(ns / ticks);
+        }
+
+        /**
+         * @brief Durations of timed iterations that handled ticks, in nanoseconds.
+         */
+        const latency_histogram &iteration_ns() const noexcept { return iteration_ns_; }
+
+        /**
+         * @brief Iteration durations spread over their ticks, in nanoseconds.
+         */
+        const latency_histogram &tick_ns() const noexcept { return tick_ns_; }
+
+    private:
+        uint32_t every_{1};              ///< Sampling interval.
+        uint32_t countdown_{1};          ///< Iterations until the next sample.
+        latency_histogram iteration_ns_; ///< Per iteration latency.
+        latency_histogram tick_ns_;      ///< Per tick latency.
+    };
+
+} // namespace engine::metrics
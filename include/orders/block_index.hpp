@@ -0,0 +1,195 @@
+#pragma once
+
+#include "orders/id_index.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine::orders
+{
+    /**
+     * @brief Map from integer IDs issued in runs, each aligned block of consecutive IDs held
+     * together and indexed directly.
+     *
+     * An id_index maps a block number to a pooled block of values, and an ID's low bits pick its
+     * value within the block, so order_id_generator's sequential IDs fill one block before moving
+     * to the next. Inserting and erasing the newest orders touches one block that stays in cache,
+     * and the id_index only sees a new key once per block. A lookup of an arbitrary ID costs the
+     * block's id_index probe and one direct read.
+     *
+     * A block is released to a free list, and reused last in first out, once its last ID is
+     * erased. IDs scattered at random cost a block each, so keys should come in runs, as order
+     * IDs do.
+     *
+     * Pointers to values are invalidated by any insert or erase.
+     *
+     * @tparam Value Mapped type, default constructible.
+     * @tparam BlockBits Log2 of the IDs per block, at most 6.
+     */
+    template <typename Value, unsigned BlockBits = 6>
+    class block_index
+    {
+        static_assert(BlockBits <= 6, "a block's occupancy must fit 64 bits");
+
+    public:
+        /// @brief Getters.
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        /**
+         * @brief Hash of an ID's block, to pass to lookups when an ID is reused.
+         */
+        size_t hash(uint64_t id) const noexcept { return blocks_.hash(id >> BlockBits); }
+
+        /**
+         * @brief Value of an ID.
+         * @return Pointer to the value, or nullptr if absent.
+         */
+        Value *find(uint64_t id) noexcept { return find(id, hash(id)); }
+
+        /**
+         * @brief Value of an ID with its precomputed hash().
+         */
+        Value *find(uint64_t id, size_t h) noexcept
+        {
+            const auto *at = blocks_.find(id >> BlockBits, h);
+            return at && pool_[*at].holds(id) ? &pool_[*at].values_[offset(id)] : nullptr;
+        }
+
+        /**
+         * @brief Const lookup, see find().
+         */
+        const Value *find(uint64_t id) const noexcept { return find(id, hash(id)); }
+
+        /**
+         * @brief Const lookup with a precomputed hash().
+         */
+        const Value *find(uint64_t id, size_t h) const noexcept
+        {
+            const auto *at = blocks_.find(id >> BlockBits, h);
+            return at && pool_[*at].holds(id) ? &pool_[*at].values_[offset(id)] : nullptr;
+        }
+
+        /**
+         * @brief Whether an ID is present.
+         */
+        bool contains(uint64_t id) const noexcept { return find(id) != nullptr; }
+
+        /**
+         * @brief Insert a value for an ID if it is absent.
+         * @param id ID.
+         * @param args Value initializers.
+         * @return Pointer to the ID's value and whether it was inserted.
+         */
+        template <typename... Args>
+        std::pair<Value *, bool> try_emplace(uint64_t id, Args &&...args)
+        {
+            auto [at, added] = blocks_.try_emplace(id >> BlockBits, 0u);
+            if (added)
+            {
+                *at = acquire();
+            }
+            auto &b = pool_[*at];
+            auto &value = b.values_[offset(id)];
+            if (b.holds(id))
+            {
+                return {&value, false};
+            }
+            b.used_ |= bit(id);
+            value = Value{std::forward<Args>(args)...};
+            ++size_;
+            return {&value, true};
+        }
+
+        /**
+         * @brief Remove an ID.
+         * @return False if it was absent.
+         */
+        bool erase(uint64_t id) noexcept { return erase(id, hash(id)); }
+
+        /**
+         * @brief Remove an ID with its precomputed hash().
+         */
+        bool erase(uint64_t id, size_t h) noexcept
+        {
+            const auto *at = blocks_.find(id >> BlockBits, h);
+            if (!at || !pool_[*at].holds(id))
+            {
+                return false;
+            }
+            auto &b = pool_[*at];
+            b.used_ &= ~bit(id);
+            --size_;
+            if (b.used_ == 0)
+            {
+                // Last ID of the block, hand it back for the next block to start
+                free_.push_back(*at);
+                blocks_.erase(id >> BlockBits, h);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Make room for a number of sequential IDs without growing.
+         */
+        void reserve(size_t count)
+        {
+            const auto blocks = (count >> BlockBits) + 1;
+            blocks_.reserve(blocks);
+            pool_.reserve(blocks);
+        }
+
+        /**
+         * @brief Remove every entry, keeping capacity.
+         */
+        void clear() noexcept
+        {
+            blocks_.clear();
+            pool_.clear();
+            free_.clear();
+            size_ = 0;
+        }
+
+    private:
+        /// @brief IDs per block.
+        static constexpr uint64_t block_size = uint64_t{1} << BlockBits;
+
+        /**
+         * @brief Values of one aligned block of IDs.
+         */
+        struct block
+        {
+            uint64_t used_{0};                       ///< Bit per ID present.
+            std::array<Value, block_size> values_{}; ///< Values by ID offset.
+
+            bool holds(uint64_t id) const noexcept { return (used_ & bit(id)) != 0; }
+        };
+
+        static size_t offset(uint64_t id) noexcept { return static_cast<size_t>(id & (block_size - 1)); }
+        static uint64_t bit(uint64_t id) noexcept { return uint64_t{1} << offset(id); }
+
+        /// @brief Empty block, the last released if any.
+        uint32_t acquire()
+        {
+            if (!free_.empty())
+            {
+                const auto at = free_.back();
+                free_.pop_back();
+                return at;
+            }
+            pool_.emplace_back();
+            // Room for every block to be free, so erase never allocates
+            free_.reserve(pool_.capacity());
+            return static_cast<uint32_t>(pool_.size() - 1);
+        }
+
+        id_index<uint64_t, uint32_t> blocks_; ///< Pooled block by block number.
+        std::vector<block> pool_;             ///< Blocks, in use or free.
+        std::vector<uint32_t> free_;          ///< Released blocks, reused last first.
+        size_t size_{0};                      ///< IDs present.
+    };
+
+} // namespace engine::orders
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "events/order_id.hpp"
+#include "orders/id_index.hpp"
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace engine::orders
+{
+    /**
+     * @brief Bidirectional map between client string order IDs and engine order IDs.
+     *
+     * Used only at the boundary, when orders come in from or are reported to an external
+     * client. Everything inside the engine works on the numeric ID.
+     *
+     * Both directions are flat id_index tables. Client IDs are looked up by string_view without
+     * building a string, and a gateway holding a client ID across several calls can hash it
+     * once with hash() and pass it to the overloads taking a hash.
+     */
+    class client_id_map
+    {
+    public:
+        /**
+         * @brief Bind a client ID to an engine ID.
+         * @param client_id Client string ID.
+         * @param id Engine order ID.
+         * @return False if either side is already bound.
+         */
+        bool bind(std::string_view client_id, events::order_id id);
+
+        /**
+         * @brief Look up engine ID by client ID.
+         * @return Engine ID, or invalid_order_id if unbound.
+         */
+        events::order_id find(std::string_view client_id) const noexcept;
+
+        /**
+         * @brief Look up engine ID by client ID and its precomputed hash().
+         * @return Engine ID, or invalid_order_id if unbound.
+         */
+        events::order_id find(std::string_view client_id, size_t hash) const noexcept;
+
+        /**
+         * @brief Hash of a client ID, for the lookups taking one.
+         */
+        size_t hash(std::string_view client_id) const noexcept { return by_client_.hash(client_id); }
+
+        /**
+         * @brief Look up client ID by engine ID.
+         * @return Client ID, or empty if unbound.
+         */
+        std::string_view client(events::order_id id) const noexcept;
+
+        /**
+         * @brief Remove a binding by engine ID.
+         */
+        void erase(events::order_id id) noexcept;
+
+        /**
+         * @brief Number of bindings.
+         */
+        size_t size() const noexcept { return by_id_.size(); }
+
+    private:
+        /// @brief Transparent hash so lookups by string_view don't allocate.
+        struct client_hash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view sv) const noexcept { return std::hash<std::string_view>{}(sv); }
+        };
+
+        id_index<std::string, events::order_id, client_hash> by_client_; ///< Client to engine ID.
+        id_index<events::order_id, std::string> by_id_;                  ///< Engine to client ID.
+    };
+
+} // namespace engine::orders
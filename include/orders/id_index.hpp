@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace engine::orders
+{
+    /**
+     * @brief Flat open addressing map from IDs, Robin Hood probing with backward shift erase.
+     *
+     * Entries sit inline in one power of two array. An insert that finds a richer entry, one
+     * closer to its home slot, takes its place and carries it on, so probe lengths stay short
+     * and even, and a miss ends as soon as it meets an entry closer to home than itself. Each
+     * slot keeps the low 32 bits of the key's hash, compared before the key and used to rehash
+     * on growth without touching the keys.
+     *
+     * std::hash of an integer is the identity, so hashes are mixed before picking a home slot.
+     * Left unmixed, the dense blocks order_id_generator issues pack into long runs that churn
+     * has to shift along.
+     *
+     * Lookups are heterogeneous when Hash declares is_transparent, and every lookup takes an
+     * optional precomputed hash from hash(), so a caller holding a key across several lookups
+     * hashes it once.
+     *
+     * Pointers to values are invalidated by any insert or erase.
+     *
+     * @tparam Key Key type, default constructible.
+     * @tparam Value Mapped type, default constructible.
+     * @tparam Hash Hasher.
+     * @tparam KeyEqual Key comparison, transparent by default.
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<>>
+    class id_index
+    {
+    public:
+        /// @brief Getters.
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return slots_.size(); }
+
+        /**
+         * @brief Hash of a key as lookups use it, to pass to them when a key is reused.
+         */
+        template <typename K>
+        size_t hash(const K &key) const noexcept
+        {
+            // Fibonacci mix, its high half becomes the fragment and home slot
+            return static_cast<size_t>((static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        /**
+         * @brief Value of a key.
+         * @return Pointer to the value, or nullptr if absent.
+         */
+        template <typename K>
+        Value *find(const K &key) noexcept { return find(key, hash(key)); }
+
+        /**
+         * @brief Value of a key with its precomputed hash().
+         */
+        template <typename K>
+        Value *find(const K &key, size_t h) noexcept
+        {
+            const auto i = locate(key, h);
+            return i != npos ? &slots_[i].value_ : nullptr;
+        }
+
+        /**
+         * @brief Const lookup, see find().
+         */
+        template <typename K>
+        const Value *find(const K &key) const noexcept { return find(key, hash(key)); }
+
+        /**
+         * @brief Const lookup with a precomputed hash().
+         */
+        template <typename K>
+        const Value *find(const K &key, size_t h) const noexcept
+        {
+            const auto i = locate(key, h);
+            return i != npos ? &slots_[i].value_ : nullptr;
+        }
+
+        /**
+         * @brief Whether a key is present.
+         */
+        template <typename K>
+        bool contains(const K &key) const noexcept { return locate(key, hash(key)) != npos; }
+
+        /**
+         * @brief Insert a value for a key if it is absent.
+         * @param key Key, converted to Key on insert.
+         * @param args Value initializers.
+         * @return Pointer to the key's value and whether it was inserted.
+         */
+        template <typename K, typename... Args>
+        std::pair<Value *, bool> try_emplace(K &&key, Args &&...args)
+        {
+            const auto h = hash(key);
+            if (const auto i = locate(key, h); i != npos)
+            {
+                return {&slots_[i].value_, false};
+            }
+            return {insert_new(slot{Key(std::forward<K>(key)), Value{std::forward<Args>(args)...}, 1, fragment(h)}), true};
+        }
+
+        /**
+         * @brief Insert a value for a key, replacing any it had.
+         * @return The key's value.
+         */
+        template <typename K>
+        Value &insert_or_assign(K &&key, Value value)
+        {
+            const auto h = hash(key);
+            if (const auto i = locate(key, h); i != npos)
+            {
+                return slots_[i].value_ = std::move(value);
+            }
+            return *insert_new(slot{Key(std::forward<K>(key)), std::move(value), 1, fragment(h)});
+        }
+
+        /**
+         * @brief Remove a key.
+         * @return False if it was absent.
+         */
+        template <typename K>
+        bool erase(const K &key) noexcept { return erase(key, hash(key)); }
+
+        /**
+         * @brief Remove a key with its precomputed hash().
+         */
+        template <typename K>
+        bool erase(const K &key, size_t h) noexcept
+        {
+            auto i = locate(key, h);
+            if (i == npos)
+            {
+                return false;
+            }
+
+            // Shift the run after it back a slot, leaving no tombstone
+            for (auto next = (i + 1) & mask_; slots_[next].dist_ > 1; next = (next + 1) & mask_)
+            {
+                slots_[i] = std::move(slots_[next]);
+                --slots_[i].dist_;
+                i = next;
+            }
+            slots_[i] = slot{};
+            --size_;
+            return true;
+        }
+
+        /**
+         * @brief Make room for a number of entries without growing.
+         */
+        void reserve(size_t count)
+        {
+            size_t cap = min_capacity;
+            while (cap - cap / 8 < count)
+            {
+                cap *= 2;
+            }
+            if (cap > slots_.size())
+            {
+                rehash(cap);
+            }
+        }
+
+        /**
+         * @brief Remove every entry, keeping capacity.
+         */
+        void clear() noexcept
+        {
+            for (auto &s : slots_)
+            {
+                s = slot{};
+            }
+            size_ = 0;
+        }
+
+    private:
+        /// @brief Smallest table allocated.
+        static constexpr size_t min_capacity = 8;
+
+        /// @brief No slot.
+        static constexpr size_t npos = ~size_t{0};
+
+        /**
+         * @brief Inline entry.
+         */
+        struct slot
+        {
+            Key key_{};        ///< Entry key.
+            Value value_{};    ///< Entry value.
+            uint32_t dist_{0}; ///< One plus the distance from its home slot, 0 when empty.
+            uint32_t frag_{0}; ///< Low 32 bits of the key's hash.
+        };
+
+        /// @brief Hash bits kept in a slot.
+        static uint32_t fragment(size_t h) noexcept { return static_cast<uint32_t>(h); }
+
+        /// @brief Home slot of a hash fragment.
+        size_t home(uint32_t frag) const noexcept { return static_cast<size_t>(frag) & mask_; }
+
+        /// @brief Slot holding a key, or npos.
+        template <typename K>
+        size_t locate(const K &key, size_t h) const noexcept
+        {
+            if (size_ == 0)
+            {
+                return npos;
+            }
+            const auto frag = fragment(h);
+            uint32_t dist = 1;
+            for (auto i = home(frag);; i = (i + 1) & mask_, ++dist)
+            {
+                const auto &s = slots_[i];
+                // An empty slot or a richer entry ends the run the key would be in
+                if (s.dist_ < dist)
+                {
+                    return npos;
+                }
+                if (s.frag_ == frag && KeyEqual{}(s.key_, key))
+                {
+                    return i;
+                }
+            }
+        }
+
+        /// @brief Place an entry known to be absent, growing first if the table is full.
+        Value *insert_new(slot &&entry)
+        {
+            if (size_ + 1 > slots_.size() - slots_.size() / 8)
+            {
+                rehash(slots_.empty() ? min_capacity : slots_.size() * 2);
+            }
+            ++size_;
+            return &slots_[place(std::move(entry))].value_;
+        }
+
+        /// @brief Robin Hood placement, returning the slot the entry landed in.
+        size_t place(slot &&entry) noexcept
+        {
+            auto placed = npos;
+            for (auto i = home(entry.frag_);; i = (i + 1) & mask_, ++entry.dist_)
+            {
+                auto &s = slots_[i];
+                if (s.dist_ == 0)
+                {
+                    s = std::move(entry);
+                    return placed != npos ? placed : i;
+                }
+                if (s.dist_ < entry.dist_)
+                {
+                    // Take the richer entry's slot and carry it on
+                    std::swap(s, entry);
+                    if (placed == npos)
+                    {
+                        placed = i;
+                    }
+                }
+            }
+        }
+
+        /// @brief Move every entry into a table of a new power of two capacity.
+        void rehash(size_t cap)
+        {
+            std::vector<slot> old(cap);
+            old.swap(slots_);
+            mask_ = cap - 1;
+            for (auto &s : old)
+            {
+                if (s.dist_ != 0)
+                {
+                    s.dist_ = 1;
+                    place(std::move(s));
+                }
+            }
+        }
+
+        std::vector<slot> slots_; ///< Table, a power of two in size.
+        size_t mask_{0};          ///< Capacity minus one.
+        size_t size_{0};          ///< Entries.
+    };
+
+} // namespace engine::orders
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace engine::orders
+{
+    /**
+     * @brief Positions in a ring of retired orders by order ID.
+     *
+     * Linear probing over a fixed table twice the ring's size. Each slot packs a ring position
+     * with 16 bits of the ID's hash, which also pick its home slot, so a slot is 4 bytes and the
+     * table of a 1024 entry ring fits in 8 KB. IDs aren't stored, a candidate is confirmed by
+     * reading the ID back from the ring entry it points at, which the caller supplies. Erase
+     * shifts the run after it back, leaving no tombstone.
+     *
+     * Only the ring's newest entry for an ID is indexed. The ring must erase a position before
+     * overwriting it, so every position indexed still holds the ID it was indexed under.
+     *
+     * @tparam Key ID type, hashed with std::hash.
+     * @tparam Capacity Ring size, at most 2^15.
+     */
+    template <typename Key, size_t Capacity>
+    class ledger_index
+    {
+        static_assert(Capacity > 0 && Capacity <= (size_t{1} << 15), "ring positions and home slots must fit the slot's bits");
+
+    public:
+        /// @brief No position.
+        static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Ring position of an ID's newest entry.
+         * @param id_at Callable giving the ID held at a ring position.
+         * @return The position, or npos if the ID has none.
+         */
+        template <typename IdAt>
+        uint32_t find(const Key &id, IdAt &&id_at) const noexcept
+        {
+            const auto frag = fragment(id);
+            for (auto i = home(frag); table_[i] != 0; i = (i + 1) & mask)
+            {
+                if (frag_of(table_[i]) == frag && id_at(pos_of(table_[i])) == id)
+                {
+                    return pos_of(table_[i]);
+                }
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Point an ID at a ring position, replacing any older position it had.
+         * @param id_at Callable giving the ID held at a ring position.
+         */
+        template <typename IdAt>
+        void assign(const Key &id, uint32_t pos, IdAt &&id_at) noexcept
+        {
+            const auto frag = fragment(id);
+            auto i = home(frag);
+            for (; table_[i] != 0; i = (i + 1) & mask)
+            {
+                if (frag_of(table_[i]) == frag && id_at(pos_of(table_[i])) == id)
+                {
+                    break;
+                }
+            }
+            table_[i] = pack(frag, pos);
+        }
+
+        /**
+         * @brief Drop a ring position about to be overwritten, if it is its ID's newest entry.
+         * @param id ID held at the position.
+         */
+        void erase(const Key &id, uint32_t pos) noexcept
+        {
+            const auto entry = pack(fragment(id), pos);
+            auto i = home(frag_of(entry));
+            for (; table_[i] != entry; i = (i + 1) & mask)
+            {
+                if (table_[i] == 0)
+                {
+                    return;
+                }
+            }
+
+            // Shift back every later entry of the run whose home lies at or before the gap
+            for (auto next = (i + 1) & mask; table_[next] != 0; next = (next + 1) & mask)
+            {
+                const auto from_home = (next - home(frag_of(table_[next]))) & mask;
+                if (from_home >= ((next - i) & mask))
+                {
+                    table_[i] = table_[next];
+                    i = next;
+                }
+            }
+            table_[i] = 0;
+        }
+
+        /**
+         * @brief Remove every entry.
+         */
+        void clear() noexcept { table_.fill(0); }
+
+    private:
+        /// @brief Table size, a power of two at least twice the ring's.
+        static constexpr size_t slots = std::bit_ceil(Capacity * 2);
+        static constexpr size_t mask = slots - 1;
+
+        /// @brief Hash bits kept in a slot, mixed as id_index mixes them.
+        static uint32_t fragment(const Key &id) noexcept
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(std::hash<Key>{}(id)) * 0x9E3779B97F4A7C15ull) >> 48);
+        }
+
+        /// @brief Slot with a fragment and a position, 0 is kept for empty.
+        static uint32_t pack(uint32_t frag, uint32_t pos) noexcept { return frag << 16 | (pos + 1); }
+        static uint32_t frag_of(uint32_t slot) noexcept { return slot >> 16; }
+        static uint32_t pos_of(uint32_t slot) noexcept { return (slot & 0xffff) - 1; }
+        static size_t home(uint32_t frag) noexcept { return static_cast<size_t>(frag) & mask; }
+
+        std::array<uint32_t, slots> table_{}; ///< Packed slots, 0 when empty.
+    };
+
+} // namespace engine::orders
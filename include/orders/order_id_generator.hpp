@@ -0,0 +1,121 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+#include "events/order_id.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace engine::orders
+{
+    /**
+     * @brief Lock-free order ID generator shareable across strategy threads.
+     *
+     * Each thread claims a block of IDs with a single atomic fetch_add and then issues IDs from it
+     * with plain increments, so the shared counter is touched once per block. IDs are unique per
+     * generator and increasing per thread, but not globally ordered across threads.
+     *
+     * A checkpoint saves the first unclaimed ID, so a restored generator never reissues an ID
+     * the saved run handed out. IDs left in blocks threads had claimed are skipped.
+     */
+    class order_id_generator
+    {
+    public:
+        /// @brief Default number of IDs claimed per thread at a time.
+        static constexpr uint64_t default_block_size = 4096;
+
+        /**
+         * @brief Construct a generator.
+         * @param block_size IDs claimed per thread at a time.
+         * @param first First ID issued, must not be invalid_order_id.
+         */
+        explicit order_id_generator(uint64_t block_size = default_block_size,
+                                    events::order_id first = 1) noexcept
+            : block_size_(block_size == 0 ? 1 : block_size),
+              next_block_(first == events::invalid_order_id ? 1 : first),
+              serial_(next_serial())
+        {
+        }
+
+        /// @brief Shared by reference, threads cache ranges against this instance.
+        order_id_generator(const order_id_generator &) = delete;
+        order_id_generator &operator=(const order_id_generator &) = delete;
+
+        /**
+         * @brief Issue the next ID for the calling thread.
+         */
+        events::order_id next() noexcept
+        {
+            auto &range = local_range();
+            if (range.serial_ != serial_ || range.next_ == range.end_) [[unlikely]]
+            {
+                // Claim a fresh block from the shared counter
+                range.serial_ = serial_;
+                range.next_ = next_block_.fetch_add(block_size_, std::memory_order_relaxed);
+                range.end_ = range.next_ + block_size_;
+            }
+            return range.next_++;
+        }
+
+        /**
+         * @brief First ID of the next block to be claimed, every ID issued so far is below it.
+         */
+        events::order_id next_unclaimed() const noexcept { return next_block_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Save the first unclaimed ID.
+         */
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            out.section(checkpoint::tag("OIDS"));
+            out.put(next_unclaimed());
+        }
+
+        /**
+         * @brief Resume issuing at a saved generator's first unclaimed ID. Not concurrent with next().
+         *
+         * Blocks threads hold are dropped, so every thread claims afresh.
+         */
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.section(checkpoint::tag("OIDS"));
+            const auto next = in.get<events::order_id>();
+            if (next == events::invalid_order_id)
+            {
+                errors::raise<std::runtime_error>("Corrupt snapshot order IDs");
+            }
+            next_block_.store(next, std::memory_order_relaxed);
+            serial_ = next_serial();
+        }
+
+    private:
+        /// @brief Block of IDs owned by one thread.
+        struct thread_range
+        {
+            uint64_t serial_{0};       ///< Generator the range was claimed from.
+            events::order_id next_{0}; ///< Next ID to issue.
+            events::order_id end_{0};  ///< One past the last ID of the block.
+        };
+
+        /// @brief Calling thread's cached range. One cache per thread, a thread alternating between generators reclaims blocks.
+        static thread_range &local_range() noexcept
+        {
+            thread_local thread_range range;
+            return range;
+        }
+
+        /// @brief Unique serial per generator so a reused address never inherits a stale range.
+        static uint64_t next_serial() noexcept
+        {
+            static std::atomic<uint64_t> serial{1};
+            return serial.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const uint64_t block_size_;                ///< IDs claimed per block.
+        std::atomic<events::order_id> next_block_; ///< First ID of the next unclaimed block.
+        uint64_t serial_;                          ///< Instance serial, renewed on restore.
+    };
+
+} // namespace engine::orders
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "orders/order_state.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace engine::orders
+{
+    /// @brief Handle to a pooled order, stable until it is released.
+    using order_handle = uint32_t;
+
+    /// @brief Sentinel for no order.
+    inline constexpr order_handle invalid_order_handle = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Slab of order states shared by every book of an order_queue.
+     *
+     * An order is constructed in place once, when it is acquired, and every book and index refers
+     * to it by a 32 bit handle from then on, never by copy. Released slots are threaded onto a
+     * free list and reused last in first out, so an insert after a release gets a slot still in
+     * cache, and once the pool has seen its peak of live orders nothing allocates.
+     *
+     * Slots live in fixed chunks of a power of two, so addresses survive growth and a handle
+     * splits into its chunk and offset with a shift and a mask rather than a deque's division.
+     *
+     * Each slot also carries the links of the book level its order rests at, so a book is only
+     * its levels and ladders and its orders are the pool's.
+     */
+    class order_pool
+    {
+    public:
+        /**
+         * @brief Pooled order with its book links.
+         */
+        struct slot
+        {
+            order_state state_;                       ///< Order and fill progress.
+            order_handle prev_{invalid_order_handle}; ///< Earlier order at the level.
+            order_handle next_{invalid_order_handle}; ///< Later order at the level, or next free slot.
+            uint32_t level_{0};                       ///< Level holding the order.
+        };
+
+        /**
+         * @brief Place an order in a free slot, growing the slab if there is none.
+         * @return Handle to the order, unlinked from any book.
+         */
+        order_handle acquire(order_state &&state)
+        {
+            // Reuse a released slot before growing the slab
+            order_handle h = free_;
+            if (h != invalid_order_handle)
+            {
+                auto &s = node(h);
+                free_ = s.next_;
+                std::destroy_at(&s.state_);
+                std::construct_at(&s.state_, std::move(state));
+                s.next_ = invalid_order_handle;
+            }
+            else
+            {
+                // A chunk is reserved whole and never grows past it, so its slots never move
+                h = static_cast<order_handle>(capacity_++);
+                if ((h & chunk_mask) == 0)
+                {
+                    chunks_.emplace_back().reserve(chunk_size);
+                }
+                chunks_.back().push_back(slot{std::move(state)});
+            }
+            ++size_;
+            return h;
+        }
+
+        /**
+         * @brief Return an order's slot to the free list.
+         * @param h Handle returned by acquire(), invalid afterwards.
+         */
+        void release(order_handle h) noexcept
+        {
+            auto &s = node(h);
+            s.prev_ = invalid_order_handle;
+            s.next_ = free_;
+            free_ = h;
+            --size_;
+        }
+
+        /**
+         * @brief Order by handle, the address is stable until it is released.
+         */
+        order_state &at(order_handle h) noexcept { return node(h).state_; }
+
+        /**
+         * @brief Const order by handle.
+         */
+        const order_state &at(order_handle h) const noexcept { return node(h).state_; }
+
+        /**
+         * @brief Slot by handle, for the book linking it.
+         */
+        slot &node(order_handle h) noexcept { return chunks_[h >> chunk_bits][h & chunk_mask]; }
+
+        /**
+         * @brief Const slot by handle.
+         */
+        const slot &node(order_handle h) const noexcept { return chunks_[h >> chunk_bits][h & chunk_mask]; }
+
+        /// @brief Getters.
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return capacity_; }
+
+    private:
+        /// @brief Slots per chunk.
+        static constexpr uint32_t chunk_bits = 10;
+        static constexpr uint32_t chunk_size = uint32_t{1} << chunk_bits;
+        static constexpr uint32_t chunk_mask = chunk_size - 1;
+
+        std::vector<std::vector<slot>> chunks_;   ///< Slab, each chunk reserved to chunk_size.
+        size_t capacity_{0};                      ///< Slots constructed across every chunk.
+        order_handle free_{invalid_order_handle}; ///< Free list of released slots.
+        size_t size_{0};                          ///< Orders acquired and not released.
+    };
+
+} // namespace engine::orders
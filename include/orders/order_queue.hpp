@@ -1,72 +1,55 @@
 #pragma once
 
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+#include "orders/block_index.hpp"
+#include "orders/ledger_index.hpp"
+#include "orders/order_pool.hpp"
 #include "orders/order_state.hpp"
-#include "streamer/buffers/revolving_ring_buffer.hpp"
+#include "orders/price_level_book.hpp"
 
-#include <set>
-#include <unordered_map>
-#include <queue>
-#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace engine::orders
 {
     /**
-     * @brief Custom queue for orders. Uses custom comparators for bids and asks and a back index
-     * to maintain O(1) insert and erase.
+     * @brief Resting orders by instrument, with a back index for O(1) lookup, insert and erase.
+     *
+     * Each interned symbol has its own price_level_book, best price first and time priority
+     * within a price, held in a flat array indexed by symbol ID. A handler working a market event
+     * only walks the book of that event's symbol.
+     *
+     * The back index holds IDs in aligned blocks, see block_index, so the run of sequential IDs
+     * a strategy issues is inserted and erased within one block in cache.
+     *
+     * Every order lives once in an order_pool shared by the books, which reference it by handle.
+     * An order leaving its book has its final state copied into a bounded ledger of recent history
+     * and its slot released at once, so the pool's free list hands the same warm slot to the next
+     * insert. The ledger is indexed by a small table of ring positions, see ledger_index, which
+     * stays in cache beside the books. Its depth is set at construction and is 0 by default, so a
+     * bare book pays nothing for history it never reads. Execution handlers keep a full ledger to
+     * recognise late fills, see execution_engine_base.
+     *
+     * Books compare prices in ticks of their instrument's tick size, set through set_tick_size()
+     * and tick_scale::default_tick_size otherwise. Order and fill prices stay doubles and are
+     * converted where they meet a book.
      */
     class order_queue
     {
-    private:
-        /**
-         * @brief Comparator for buy orders. Orders by higher price and timestamp as tiebreaker.
-         */
-        struct bid_cmp
-        {
-            bool operator()(const order_state &lhs, const order_state &rhs) const noexcept
-            {
-                // Compare by order
-                const auto &o1 = lhs.order_;
-                const auto &o2 = rhs.order_;
-                if (o1.price_ != o2.price_)
-                {
-                    return o1.price_ > o2.price_;
-                }
-                // Tie break on timestamp
-                return o1.timestamp_ < o2.timestamp_; // earliest first
-            }
-        };
+    public:
+        /// @brief Most orders a ledger keeps once they leave their book.
+        static constexpr size_t ledger_capacity = 1024;
 
         /**
-         * @brief Comparator for ask orders. Orders by lower price and timestamp as tiebreaker.
+         * @brief Empty queue.
+         * @param ledger_depth Orders kept in the ledger, none by default.
+         * @throws std::invalid_argument if the depth exceeds ledger_capacity.
          */
-        struct ask_cmp
-        {
-            bool operator()(const order_state &lhs, const order_state &rhs) const noexcept
-            {
-                // Compare by order
-                const auto &o1 = lhs.order_;
-                const auto &o2 = rhs.order_;
-                if (o1.price_ != o2.price_)
-                {
-                    return o1.price_ < o2.price_;
-                }
-                // Tie break on timestamp
-                return o1.timestamp_ < o2.timestamp_; // earliest first
-            }
-        };
-
-        /// @brief Ordered set aliases for different book types.
-        using bid_container = std::multiset<order_state, bid_cmp>;
-        using ask_container = std::multiset<order_state, ask_cmp>;
-        /// @brief Aliases for iterators.
-        using bid_iterator = bid_container::iterator;
-        using ask_iterator = ask_container::iterator;
-        /// @brief Alias for historical ledger.
-        using historical_container = btc_stream::streamer::buffers::revolving_recency_buffer<order_state>;
+        explicit order_queue(size_t ledger_depth = 0);
 
-    public:
         /// @brief Default destructor, resources are already RAII compliant.
-        order_queue() = default;
         ~order_queue() = default;
         /// @brief No copies, but allow moves.
         order_queue(const order_queue &) = delete;
@@ -75,50 +58,169 @@ namespace engine::orders
         order_queue &operator=(order_queue &&) = default;
 
         /// @brief Getters.
-        const bid_container &bids() noexcept { return bids_; }
-        const ask_container &asks() noexcept { return asks_; }
-        size_t size() const noexcept { return bids_.size() + asks_.size(); }
-        bool empty() const noexcept { return bids_.empty() && asks_.empty(); }
-        const order_state &best_bid() const noexcept { return *bids_.begin(); };
-        const order_state &best_ask() const noexcept { return *asks_.begin(); };
-        const historical_container &ledger() const noexcept { return historical_ledger_; }
+        size_t size() const noexcept { return index_.size(); }
+        bool empty() const noexcept { return index_.empty(); }
+        size_t ledger_size() const noexcept { return ledger_.size(); }
+        size_t ledger_depth() const noexcept { return ledger_depth_; }
+
+        /**
+         * @brief Book of one instrument.
+         * @return Pointer to the book, or nullptr if no order for the symbol ever rested.
+         */
+        const price_level_book *book(symbols::symbol_id symbol) const noexcept
+        {
+            const auto slot = slot_of(symbol);
+            return slot < books_.size() ? books_[slot].get() : nullptr;
+        }
+
+        /**
+         * @brief Resting orders of one instrument.
+         */
+        size_t size(symbols::symbol_id symbol) const noexcept
+        {
+            const auto *b = book(symbol);
+            return b ? b->size() : 0;
+        }
+
+        /**
+         * @brief First order at an instrument's best bid, which must exist.
+         */
+        const order_state &best_bid(symbols::symbol_id symbol) const noexcept { return books_[slot_of(symbol)]->best_bid(); }
+
+        /**
+         * @brief First order at an instrument's best ask, which must exist.
+         */
+        const order_state &best_ask(symbols::symbol_id symbol) const noexcept { return books_[slot_of(symbol)]->best_ask(); }
+
+        /**
+         * @brief Set an instrument's tick size, before any of its orders rest.
+         * @param symbol Instrument.
+         * @param tick_size Smallest price increment, positive and finite.
+         */
+        void set_tick_size(symbols::symbol_id symbol, double tick_size);
 
         /**
          * @brief Emplaces or replaces new order state.
          * @param state Order state.
+         * @return The resting state, as get() would return it.
          */
-        void emplace(order_state &&state);
+        order_state &emplace(order_state &&state);
 
         /**
          * @brief Convenience overload to construct from event.
          * @param ev Order event.
          */
-        void emplace(const events::order_event &ev) noexcept { return emplace(order_state{ev}); }
+        order_state &emplace(const events::order_event &ev) { return emplace(order_state{ev}); }
 
         /**
-         * @brief Gets order by ID. Uses const cast to remove constness, ordering remains in tact as
-         * member constness of ordering keys are enforced in struct definition.
+         * @brief Gets order by ID. Fill progress may be updated in place, the order itself is
+         * immutable so its place in the book is unaffected.
          * @param id Order id to get.
-         * @return Pointer to constant order state, or nullptr.
+         * @return Pointer to order state, stable while the order rests, or nullptr.
          */
-        order_state *get(const std::string &id) noexcept;
+        order_state *get(events::order_id id) noexcept;
 
         /**
          * @brief Const getter.
          * @param id Order id to get.
          * @return Pointer to constant order state, or nullptr.
          */
-        const order_state *get(const std::string &id) const noexcept;
+        const order_state *get(events::order_id id) const noexcept;
 
         /**
-         * @brief Inactivates and deletes order state from queue.
+         * @brief Inactivates order state, moving it from its book to the ledger.
          * @param id Order id to remove.
+         * @return errc::ok, or errc::unknown_order if the order was not resting.
+         */
+        errors::errc inactive(events::order_id id) noexcept;
+
+        /**
+         * @brief Final state of an order that left its book, while the ledger still holds it.
+         * @param id Order id.
+         * @return Pointer to the state, or nullptr if the order is resting or was never seen or
+         *         has aged out of the ledger.
          */
-        void inactive(const std::string &id) noexcept;
+        const order_state *retired(events::order_id id) const noexcept;
 
         /**
-         * @brief Iteration ergonomic helper for processing both bids and asks. Iteration
-         * is pruned by callable success.
+         * @brief Visit the ledger, oldest first.
+         * @param fn Callable taking const order_state&.
+         */
+        template <typename Fn>
+        void for_each_retired(Fn &&fn) const
+        {
+            for (size_t i = 0; i < ledger_.size(); ++i)
+            {
+                fn(ledger_[(ledger_head_ + i) % ledger_.size()]);
+            }
+        }
+
+        /**
+         * @brief Save resting orders with their fill progress, book by book in book order, and
+         * each book's tick size, then the ledger. Every slot is saved, with or without a book.
+         */
+        void save(checkpoint::snapshot_writer &out) const;
+
+        /**
+         * @brief Replace resting orders with saved ones.
+         *
+         * Orders arrive in book order, so each lands at the tail of its level and the rebuild is
+         * linear in orders. The ledger of inactive orders is replaced by the saved one, keeping
+         * only its newest entries if this queue's ledger is shallower. The queue is rebuilt aside and only replaced once the whole section has been read.
+         *
+         * @throws std::runtime_error if the section is truncated, holds an invalid tick size, or an
+         *         order filed under another symbol's book, on the wrong side or twice.
+         */
+        void restore(checkpoint::snapshot_reader &in);
+
+        /**
+         * @brief Walk one instrument's bids then asks, each side pruned by callable success.
+         *
+         * Only the instrument's own book is touched, whatever else rests.
+         *
+         * @tparam Fn Callable type, must except order state and return bool.
+         *
+         * @param symbol Instrument to walk.
+         * @param fn Callable.
+         */
+        template <typename Fn>
+        void for_each_pruned(symbols::symbol_id symbol, Fn &&fn)
+        {
+            const auto slot = slot_of(symbol);
+            if (slot < books_.size() && books_[slot])
+            {
+                books_[slot]->for_each(true, fn);
+                books_[slot]->for_each(false, fn);
+            }
+        }
+
+        /**
+         * @brief Walk one instrument's orders on a side that a trade at a price would reach.
+         *
+         * The price is converted to the book's ticks once, and the walk stops at the first
+         * level beyond it, see price_level_book::for_each_crossing().
+         *
+         * @tparam Fn Callable type, must except order state and return bool.
+         *
+         * @param symbol Instrument to walk.
+         * @param is_buy Side to walk, bids for a trade at or below their price.
+         * @param price Trade price.
+         * @param fn Callable.
+         */
+        template <typename Fn>
+        void for_each_crossing(symbols::symbol_id symbol, bool is_buy, double price, Fn &&fn)
+        {
+            const auto slot = slot_of(symbol);
+            if (slot < books_.size() && books_[slot])
+            {
+                auto &b = *books_[slot];
+                b.for_each_crossing(is_buy, b.scale().to_ticks(price), fn);
+            }
+        }
+
+        /**
+         * @brief Iteration ergonomic helper for processing both bids and asks of every
+         * instrument, book by book. Iteration is pruned by callable success per side.
          * 
          * @tparam Fn Callable type, must except order state and return bool.
          * 
@@ -126,22 +228,55 @@ namespace engine::orders
          */
         template <typename Fn>
         void for_each_pruned(Fn&& fn) {
-            for (auto& b : bids_)
-            {
-                if(!fn(b)) break;
-            }
-            for (auto& a : asks_)
+            for (auto &b : books_)
             {
-                if(!fn(a)) break;
+                if (b)
+                {
+                    b->for_each(true, fn);
+                    b->for_each(false, fn);
+                }
             }
         }
 
     private:
-        std::unordered_map<std::string, bid_iterator> bid_index_;  // Bids back index
-        std::unordered_map<std::string, ask_iterator> asks_index_; // Asks back index
-        bid_container bids_;                                       // Ordered Bids set
-        ask_container asks_;                                       // Ordered Asks set
-        historical_container historical_ledger_;                   // Historical ledgers
+        /**
+         * @brief Where an order rests.
+         */
+        struct location
+        {
+            uint32_t slot_;                   ///< Book slot, see slot_of().
+            price_level_book::handle handle_; ///< Order within the book.
+        };
+
+        /// @brief Book slot of a symbol, orders without one share slot 0 rather than failing.
+        static size_t slot_of(symbols::symbol_id symbol) noexcept
+        {
+            return symbol == symbols::invalid_symbol ? 0 : static_cast<size_t>(symbol) + 1;
+        }
+
+        /// @brief Book for a slot, created on first use.
+        price_level_book &book_at(size_t slot);
+
+        /// @brief Rebuild one side of a restored book and its back index, each order checked to belong to the slot and side.
+        void restore_side(checkpoint::snapshot_reader &in, price_level_book &book, uint32_t slot, bool is_buy);
+
+        /// @brief Copy the state of an order that left its book into the ledger, overwriting the oldest if full.
+        void retire(const order_state &state) noexcept;
+
+        /// @brief Order id held at a ledger position, for the ledger index to confirm a match.
+        auto ledger_id() const noexcept
+        {
+            return [this](uint32_t at) noexcept
+            { return ledger_[at].order_.order_id_; };
+        }
+
+        std::unique_ptr<order_pool> pool_{std::make_unique<order_pool>()}; // Every order, boxed so books' pointers survive moves
+        block_index<location> index_;                                      // Back index into the books
+        std::vector<std::unique_ptr<price_level_book>> books_;             // Books by slot, boxed so addresses survive growth
+        std::vector<order_state> ledger_;                                  // Ring of retired order states
+        size_t ledger_head_{0};                                            // Oldest ledger entry once the ring is full
+        size_t ledger_depth_{0};                                           // Ring size, 0 keeps no ledger
+        ledger_index<events::order_id, ledger_capacity> retired_;          // Ledger positions by order id
     };
 
 } // namespace engine::orders
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "orders/id_index.hpp"
+#include "orders/order_pool.hpp"
+#include "orders/tick_price.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine::orders
+{
+    /**
+     * @brief Resting orders of one book, grouped into price levels.
+     *
+     * Each side is a ladder, a contiguous array of its price levels ordered worst to best, so the
+     * best level is the last one and reached in O(1). Each level holds an intrusive FIFO of orders
+     * in time priority. Orders live in an order_pool, which may be shared by several books, and
+     * levels in a pool of their own, both recycled through free lists, so once the book has seen
+     * its peak depth nothing allocates.
+     *
+     * Levels are keyed by integer price ticks of the book's tick_scale, converted once when an
+     * order is inserted, and found through a flat id_index per side, which like the ladders keeps
+     * its capacity as levels come and go. Inserting at an existing level and erasing by handle
+     * are O(1). Only adding or dropping a level touches the ladder, a binary search and a shift
+     * of entries, which are few and cheap near the top of the book where activity concentrates.
+     */
+    class price_level_book
+    {
+    public:
+        /// @brief Handle to a resting order, its order_pool handle.
+        using handle = order_handle;
+
+        /// @brief Sentinel for no order.
+        static constexpr handle npos = invalid_order_handle;
+
+        /**
+         * @brief Construct an empty book.
+         * @param pool Pool holding the book's orders, must outlive the book.
+         * @param scale Tick size prices are keyed by.
+         */
+        explicit price_level_book(order_pool &pool, tick_scale scale = tick_scale{}) noexcept
+            : pool_(&pool), scale_(scale)
+        {
+        }
+
+        /**
+         * @brief Place an order in the pool and rest it.
+         * @param state Order state, its side and price in ticks place it in the book.
+         * @return Handle to the resting order.
+         */
+        handle insert(order_state &&state) { return link(pool_->acquire(std::move(state))); }
+
+        /**
+         * @brief Rest a pooled order behind every order at its price with an earlier or equal
+         * timestamp.
+         * @param h Unlinked order of the book's pool.
+         * @return The handle.
+         */
+        handle link(handle h);
+
+        /**
+         * @brief Remove a resting order and release it to the pool.
+         * @param h Handle returned by insert(), invalid afterwards.
+         */
+        void erase(handle h) noexcept
+        {
+            unlink(h);
+            pool_->release(h);
+        }
+
+        /**
+         * @brief Remove a resting order, leaving it in the pool for the caller to release.
+         */
+        void unlink(handle h) noexcept;
+
+        /**
+         * @brief Resting order by handle, the address is stable until it is released.
+         */
+        order_state &at(handle h) noexcept { return pool_->at(h); }
+
+        /**
+         * @brief Const resting order by handle.
+         */
+        const order_state &at(handle h) const noexcept { return pool_->at(h); }
+
+        /**
+         * @brief Remove every order, releasing it to the pool and keeping level capacity.
+         */
+        void clear() noexcept;
+
+        /// @brief Getters.
+        size_t size() const noexcept { return bid_count_ + ask_count_; }
+        bool empty() const noexcept { return size() == 0; }
+        size_t bid_count() const noexcept { return bid_count_; }
+        size_t ask_count() const noexcept { return ask_count_; }
+        size_t bid_levels() const noexcept { return bid_ladder_.size(); }
+        size_t ask_levels() const noexcept { return ask_ladder_.size(); }
+        const tick_scale &scale() const noexcept { return scale_; }
+
+        /**
+         * @brief Best bid in ticks, the book must hold a bid.
+         */
+        price_ticks best_bid_ticks() const noexcept { return bid_ladder_.back().ticks_; }
+
+        /**
+         * @brief Best ask in ticks, the book must hold an ask.
+         */
+        price_ticks best_ask_ticks() const noexcept { return ask_ladder_.back().ticks_; }
+
+        /**
+         * @brief First order at the best bid, the book must hold a bid.
+         */
+        const order_state &best_bid() const noexcept { return pool_->at(levels_[bid_ladder_.back().level_].head_); }
+
+        /**
+         * @brief First order at the best ask, the book must hold an ask.
+         */
+        const order_state &best_ask() const noexcept { return pool_->at(levels_[ask_ladder_.back().level_].head_); }
+
+        /**
+         * @brief Visit one side in priority order, best price first and time priority within it.
+         *
+         * The callback may erase the order it is given and any order at another level. Levels
+         * it empties are skipped and none is visited twice.
+         *
+         * @param is_buy Side to visit.
+         * @param fn Callable taking order_state&, returning false to stop.
+         * @return False if fn stopped the walk.
+         */
+        template <typename Fn>
+        bool for_each(bool is_buy, Fn &&fn)
+        {
+            const auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+            for (auto i = ladder.size(); i > 0;)
+            {
+                --i;
+                const auto ticks = ladder[i].ticks_;
+                if (!visit_level(ladder[i].level_, fn))
+                {
+                    return false;
+                }
+                i = rung_at(is_buy, i, ticks);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Visit the orders of one side a trade at a price would reach, in priority order.
+         *
+         * Bids at or above the price and asks at or below it, compared in ticks, so the walk
+         * stops at the first level beyond the price without visiting its orders. The callback
+         * may erase orders as for for_each().
+         *
+         * @param is_buy Side to visit.
+         * @param ticks Trade price in ticks.
+         * @param fn Callable taking order_state&, returning false to stop.
+         * @return False if fn stopped the walk.
+         */
+        template <typename Fn>
+        bool for_each_crossing(bool is_buy, price_ticks ticks, Fn &&fn)
+        {
+            const auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+            for (auto i = ladder.size(); i > 0;)
+            {
+                --i;
+                if (is_buy ? ladder[i].ticks_ < ticks : ladder[i].ticks_ > ticks)
+                {
+                    break;
+                }
+                const auto at = ladder[i].ticks_;
+                if (!visit_level(ladder[i].level_, fn))
+                {
+                    return false;
+                }
+                i = rung_at(is_buy, i, at);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Const side walk, see for_each().
+         */
+        template <typename Fn>
+        bool for_each(bool is_buy, Fn &&fn) const
+        {
+            const auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+            for (auto step = ladder.rbegin(); step != ladder.rend(); ++step)
+            {
+                for (auto h = levels_[step->level_].head_; h != npos; h = pool_->node(h).next_)
+                {
+                    if (!fn(std::as_const(*pool_).at(h)))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+    private:
+        /**
+         * @brief Pooled price level.
+         */
+        struct price_level
+        {
+            handle head_{npos};    ///< First order in time priority, or next free level.
+            handle tail_{npos};    ///< Last order in time priority.
+            price_ticks ticks_{0}; ///< Level price.
+        };
+
+        /**
+         * @brief Ladder entry, price kept inline so searches stay in the contiguous array.
+         */
+        struct rung
+        {
+            price_ticks ticks_{0}; ///< Level price.
+            uint32_t level_{0};    ///< Pooled level.
+        };
+
+        /// @brief Visit a level's orders in time priority, returning false if fn stopped.
+        template <typename Fn>
+        bool visit_level(uint32_t level, Fn &fn)
+        {
+            for (auto h = levels_[level].head_; h != npos;)
+            {
+                // Read ahead so the callback may erase the order it is given
+                const auto next = pool_->node(h).next_;
+                if (!fn(pool_->at(h)))
+                {
+                    return false;
+                }
+                h = next;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Ladder index of a price just visited at an index, or of the first better price if
+         * its level was dropped, so a walk resumes below it however the ladder shifted meanwhile.
+         */
+        size_t rung_at(bool is_buy, size_t at, price_ticks ticks) const noexcept;
+
+        /// @brief Level for a price, added to the ladder if missing.
+        uint32_t find_or_add_level(bool is_buy, price_ticks ticks);
+
+        /// @brief Drop an empty level from its ladder and pool.
+        void drop_level(bool is_buy, uint32_t level) noexcept;
+
+        order_pool *pool_;                           ///< Orders, shared with other books.
+        std::vector<price_level> levels_;            ///< Level pool.
+        std::vector<rung> bid_ladder_;               ///< Bid levels by ascending price, best last.
+        std::vector<rung> ask_ladder_;               ///< Ask levels by descending price, best last.
+        id_index<price_ticks, uint32_t> bid_levels_; ///< Bid level by price.
+        id_index<price_ticks, uint32_t> ask_levels_; ///< Ask level by price.
+        tick_scale scale_;                           ///< Tick size levels are keyed by.
+        uint32_t free_level_{npos};                  ///< Free list of dropped levels.
+        size_t bid_count_{0};                        ///< Resting bids.
+        size_t ask_count_{0};                        ///< Resting asks.
+    };
+
+} // namespace engine::orders
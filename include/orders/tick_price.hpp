@@ -0,0 +1,60 @@
+#pragma once
+
+#include "errors/error_code.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace engine::orders
+{
+    /// @brief Price as a whole number of an instrument's ticks.
+    using price_ticks = int64_t;
+
+    /**
+     * @brief Converts one instrument's prices between doubles and ticks.
+     *
+     * Books key and compare prices in ticks, so equal displayed prices always land on the same
+     * level and comparisons are integer ones. Doubles are converted once, where they enter or
+     * leave a book, and prices off the tick grid round to the nearest tick.
+     */
+    class tick_scale
+    {
+    public:
+        /// @brief Default tick size, fine enough for any crypto quote.
+        static constexpr double default_tick_size = 1e-8;
+
+        /**
+         * @brief Construct a scale.
+         * @param tick_size Smallest price increment, positive and finite.
+         */
+        explicit tick_scale(double tick_size = default_tick_size)
+            : tick_size_(tick_size), per_unit_(1.0 / tick_size)
+        {
+            if (!(tick_size > 0.0) || !std::isfinite(tick_size))
+            {
+                errors::raise<std::invalid_argument>("tick size must be positive and finite");
+            }
+        }
+
+        /**
+         * @brief Price in ticks, rounded to the nearest tick.
+         */
+        price_ticks to_ticks(double price) const noexcept { return std::llround(price * per_unit_); }
+
+        /**
+         * @brief Price of a tick count.
+         */
+        double to_price(price_ticks ticks) const noexcept { return static_cast<double>(ticks) * tick_size_; }
+
+        /**
+         * @brief Smallest price increment.
+         */
+        double tick_size() const noexcept { return tick_size_; }
+
+    private:
+        double tick_size_; ///< Smallest price increment.
+        double per_unit_;  ///< Ticks per unit of price.
+    };
+
+} // namespace engine::orders
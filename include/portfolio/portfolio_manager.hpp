@@ -1,11 +1,12 @@
 #pragma once
 
+#include "checkpoint/snapshot.hpp"
 #include "events/event.hpp"
 #include "portfolio/position_state.hpp"
+#include "symbols/symbol_registry.hpp"
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace engine::portfolio
 {
@@ -27,17 +28,23 @@ namespace engine::portfolio
 
         /**
          * @brief Handle a fill_event (executed trade).
-         * @param fill The fill to apply to the portfolio.
+         * @param fill The fill to apply to the portfolio, ignored if its symbol is invalid_symbol.
          */
         void on_fill(const engine::events::fill_event &fill) noexcept;
 
         /**
          * @brief Handle a MarketEvent (price update).
-         * @param symbol The asset symbol (e.g., BTCUSD).
+         * @param symbol Interned asset symbol, updates for invalid_symbol are ignored.
          * @param price The current market price of the asset.
-         * @param price The current market quantity of the asset.
+         * @param qty The current market quantity of the asset.
          */
-        void on_market(const std::string &symbol, double price, double qty) noexcept;
+        void on_market(symbols::symbol_id symbol, double price, double qty) noexcept;
+
+        /**
+         * @brief Handle a market event.
+         * @param tick Market event.
+         */
+        void on_market(const engine::events::market_event &tick) noexcept { on_market(tick.symbol_, tick.price_, tick.qty_); }
 
         /**
          * @brief Handles cancel event (cancelled orders).
@@ -68,10 +75,10 @@ namespace engine::portfolio
         /**
          * @brief Gets specified position.
          *
-         * @param symbol Position symbol to get.
+         * @param symbol Interned position symbol to get.
          * @return Retrieved position.
          */
-        const position_state &position(const std::string &symbol) const noexcept;
+        const position_state &position(symbols::symbol_id symbol) const noexcept;
 
         /**
          * @brief Gets trade log.
@@ -81,18 +88,18 @@ namespace engine::portfolio
         /**
          * @brief Get last market price.
          *
-         * @param symbol Market to check.
+         * @param symbol Interned market to check.
          * @return If symbol doesn't exist will return 0.0.
          */
-        double last_price(const std::string &symbol) const noexcept;
+        double last_price(symbols::symbol_id symbol) const noexcept;
 
         /**
          * @brief Get last market quantity.
          *
-         * @param symbol Market to check.
+         * @param symbol Interned market to check.
          * @return If symbol doesn't exist will return 0.0.
          */
-        double last_quantity(const std::string &symbol) const noexcept;
+        double last_quantity(symbols::symbol_id symbol) const noexcept;
 
         /**
          * @brief Get cancel count.
@@ -102,17 +109,42 @@ namespace engine::portfolio
         /**
          * @brief Get const ref to canceled order ids.
          */
-        const std::vector<std::string>& cancelled_order_ids() const noexcept {return cancelled_order_ids_; }
+        const std::vector<engine::events::order_id>& cancelled_order_ids() const noexcept {return cancelled_order_ids_; }
+
+        /**
+         * @brief Save cash, positions, market prices and the trade and cancel logs.
+         */
+        void save(checkpoint::snapshot_writer &out) const;
+
+        /**
+         * @brief Replace all state with a saved portfolio.
+         */
+        void restore(checkpoint::snapshot_reader &in);
 
     private:
+        /**
+         * @brief Per symbol state, stored densely by interned symbol ID.
+         */
+        struct symbol_slot
+        {
+            position_state position{}; ///< Current position.
+            double market_price{0.0};  ///< Last known market price.
+            double market_qty{0.0};    ///< Last known market quantity.
+            bool has_market{false};    ///< True once a market price has been seen.
+        };
+
+        /// @brief Get slot for symbol, growing the table on first sight, or nullptr for invalid_symbol.
+        symbol_slot *slot(symbols::symbol_id symbol);
+
+        /// @brief Get slot for symbol, or nullptr if never seen.
+        const symbol_slot *find_slot(symbols::symbol_id symbol) const noexcept;
+
         double cash_;                                               ///< Available cash balance in the account (after trades and fees).
         double realized_pnl_;                                       ///< Total realized profit and loss across all positions.
         double commission_rate_;                                    ///< Commission fee rate applied to each trade (e.g. 0.001 = 0.1%).
-        std::unordered_map<std::string, position_state> positions_; ///< Current open positions keyed by symbol.
-        std::unordered_map<std::string, double> market_prices_;     ///< Last known market price per symbol.
-        std::unordered_map<std::string, double> market_quantities;  ///< Last known market quantity per symbol.
+        std::vector<symbol_slot> symbols_;                          ///< Positions and market state indexed by symbol ID.
         std::vector<engine::events::fill_event> trade_log_;         ///< Log of trades across the portfolio.
-        std::vector<std::string> cancelled_order_ids_;              ///< Log of cancelled order ids.
+        std::vector<engine::events::order_id> cancelled_order_ids_; ///< Log of cancelled order ids.
         size_t cancel_count_;                                       ///< Count of cancelled orders.
     };
 
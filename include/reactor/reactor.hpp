@@ -0,0 +1,252 @@
+#pragma once
+
+#include "reactor/task.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <vector>
+
+namespace engine::reactor
+{
+    /// @brief Clock reactor deadlines are measured on.
+    using clock = std::chrono::steady_clock;
+
+    /// @brief How an await on a reactor ended.
+    enum class wait_result : uint8_t
+    {
+        ready,    ///< The descriptor became readable, or the timer expired.
+        timeout,  ///< The deadline passed first.
+        cancelled ///< cancel() was called on the descriptor.
+    };
+
+    /**
+     * @brief Source the reactor can wait on, readable whenever it has data.
+     */
+    template <typename S>
+    concept pollable = requires(const S &s) {
+        { s.poll_fd() } -> std::convertible_to<int>;
+    };
+
+    /**
+     * @brief Registration of one suspended coroutine, stored in the awaiting coroutine's frame.
+     */
+    struct waiter
+    {
+        std::coroutine_handle<> handle_{};                       ///< Coroutine to resume.
+        clock::time_point deadline_{clock::time_point::max()};   ///< Wake up time, max for none.
+        int fd_{-1};                                             ///< Descriptor waited on, negative for a plain timer.
+        size_t heap_index_{std::numeric_limits<size_t>::max()}; ///< Position in the timer heap, max if absent.
+        wait_result result_{wait_result::ready};                 ///< Set when resumed.
+    };
+
+    /**
+     * @brief Single threaded epoll reactor resuming coroutines on readiness and timers.
+     *
+     * Descriptors are waited on one shot, timers in a heap backed by one timerfd, and stop() is
+     * signalled through an eventfd so it can be called from any thread. Waiters live in the
+     * awaiting coroutines' frames and the reactor's tables keep their capacity, so in steady state
+     * an await allocates nothing. At most one coroutine may wait on a descriptor at a time.
+     *
+     * Linux only.
+     */
+    class reactor
+    {
+    public:
+        /**
+         * @brief Awaitable readiness of a descriptor, with an optional deadline.
+         */
+        struct readable_awaiter
+        {
+            reactor &owner_; ///< Reactor waited on.
+            waiter waiter_;  ///< Registration.
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { owner_.arm(waiter_, h); }
+            wait_result await_resume() const noexcept { return waiter_.result_; }
+        };
+
+        /**
+         * @brief Awaitable deadline.
+         */
+        struct timer_awaiter
+        {
+            reactor &owner_; ///< Reactor waited on.
+            waiter waiter_;  ///< Registration.
+
+            bool await_ready() const noexcept { return waiter_.deadline_ <= clock::now(); }
+            void await_suspend(std::coroutine_handle<> h) { owner_.arm(waiter_, h); }
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief Awaitable handing the thread to the other runnable coroutines.
+         */
+        struct yield_awaiter
+        {
+            reactor &owner_; ///< Reactor yielded to.
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { owner_.ready_.push_back(h); }
+            void await_resume() const noexcept {}
+        };
+
+        reactor();
+        ~reactor();
+
+        /// @brief Owns descriptors and coroutine frames.
+        reactor(const reactor &) = delete;
+        reactor &operator=(const reactor &) = delete;
+
+        /**
+         * @brief Take ownership of a task, first resumed by the next run().
+         */
+        void spawn(task t);
+
+        /**
+         * @brief Resume coroutines until every spawned task has finished or stop() is called.
+         *
+         * The first exception to escape a task stops the loop and is rethrown. Finished frames are
+         * destroyed before returning, unfinished ones stay suspended for the next run().
+         */
+        void run();
+
+        /**
+         * @brief Make run() return after the coroutines currently runnable. Safe from any thread.
+         */
+        void stop() noexcept;
+
+        /**
+         * @brief Wait until a descriptor is readable.
+         * @param fd Descriptor, registered with epoll on first use.
+         * @param timeout Longest wait, max for none.
+         */
+        readable_awaiter readable(int fd, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) noexcept
+        {
+            readable_awaiter a{*this, {}};
+            a.waiter_.fd_ = fd;
+            a.waiter_.deadline_ = deadline_after(timeout);
+            return a;
+        }
+
+        /**
+         * @brief Wait until a time.
+         */
+        timer_awaiter sleep_until(clock::time_point deadline) noexcept
+        {
+            timer_awaiter a{*this, {}};
+            a.waiter_.deadline_ = deadline;
+            return a;
+        }
+
+        /**
+         * @brief Wait for a duration.
+         */
+        timer_awaiter sleep_for(std::chrono::nanoseconds duration) noexcept { return sleep_until(deadline_after(duration)); }
+
+        /**
+         * @brief Resume again after the other runnable coroutines and any ready descriptors.
+         */
+        yield_awaiter yield() noexcept { return {*this}; }
+
+        /**
+         * @brief Resume the coroutine waiting on a descriptor with wait_result::cancelled.
+         * @return False if nothing was waiting on it.
+         */
+        bool cancel(int fd) noexcept;
+
+        /**
+         * @brief Number of spawned tasks that have not finished.
+         */
+        size_t live_tasks() const noexcept { return live_; }
+
+    private:
+        friend struct task::final_awaiter;
+
+        /// @brief Deadline a duration from now, saturating to none.
+        static clock::time_point deadline_after(std::chrono::nanoseconds d) noexcept
+        {
+            const auto now = clock::now();
+            return d >= clock::time_point::max() - now ? clock::time_point::max() : now + std::chrono::duration_cast<clock::duration>(d);
+        }
+
+        /// @brief Register a waiter for its descriptor and/or deadline.
+        void arm(waiter &w, std::coroutine_handle<> h);
+
+        /// @brief Unregister a waiter and queue it for resumption.
+        void fire(waiter &w, wait_result result) noexcept;
+
+        /// @brief Called by a finishing task.
+        void finished(task::handle_type h) noexcept;
+
+        /// @brief Wait for events and fire what is due.
+        /// @param timeout_ms Longest wait, negative to block, 0 to only collect what is pending.
+        void poll_events(int timeout_ms);
+
+        /// @brief Fire expired timers and rearm the timerfd.
+        void expire_timers();
+
+        /// @brief Arm the timerfd for the earliest deadline.
+        void rearm_timer() noexcept;
+
+        void heap_push(waiter &w);
+        void heap_erase(waiter &w) noexcept;
+        void heap_sift_up(size_t i) noexcept;
+        void heap_sift_down(size_t i) noexcept;
+
+        int epoll_fd_{-1};                                       ///< Readiness queue.
+        int timer_fd_{-1};                                       ///< Fires at the earliest deadline.
+        int wake_fd_{-1};                                        ///< Signalled by stop().
+        std::vector<waiter *> io_;                               ///< Waiter by descriptor.
+        std::vector<bool> registered_;                           ///< Descriptors added to epoll, some maybe closed since.
+        std::vector<waiter *> timers_;                           ///< Min heap by deadline.
+        clock::time_point armed_{clock::time_point::max()};      ///< Deadline the timerfd is set to.
+        std::vector<std::coroutine_handle<>> ready_;             ///< Coroutines to resume next.
+        std::vector<std::coroutine_handle<>> running_;           ///< Coroutines being resumed.
+        std::vector<task::handle_type> tasks_;                   ///< Owned frames.
+        size_t live_{0};                                         ///< Unfinished tasks.
+        std::exception_ptr error_;                               ///< First task exception.
+        std::atomic<bool> stop_{false};                          ///< Set by stop().
+    };
+
+    /**
+     * @brief Cross thread wakeup on an eventfd, e.g. for a control channel or a producer thread.
+     *
+     * notify() from any thread makes fd() readable until consume() is called.
+     */
+    class event_signal
+    {
+    public:
+        event_signal();
+        ~event_signal();
+
+        /// @brief Owns a descriptor.
+        event_signal(const event_signal &) = delete;
+        event_signal &operator=(const event_signal &) = delete;
+
+        /**
+         * @brief Make the descriptor readable. Safe from any thread.
+         */
+        void notify() noexcept;
+
+        /**
+         * @brief Clear pending notifications.
+         * @return Number of notify() calls since the last consume().
+         */
+        uint64_t consume() noexcept;
+
+        /**
+         * @brief Descriptor to wait on.
+         */
+        int poll_fd() const noexcept { return fd_; }
+
+    private:
+        int fd_{-1}; ///< Non-blocking eventfd.
+    };
+
+} // namespace engine::reactor
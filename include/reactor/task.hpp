@@ -0,0 +1,90 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace engine::reactor
+{
+    class reactor;
+
+    /**
+     * @brief Coroutine run by a reactor.
+     *
+     * Starts suspended and is resumed by the reactor it is spawned on, which owns the frame from
+     * then on. The frame is the only allocation, made once when the coroutine is called, awaits
+     * inside it allocate nothing. An exception escaping the coroutine is rethrown from
+     * reactor::run().
+     */
+    class [[nodiscard]] task
+    {
+    public:
+        struct promise_type;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        /**
+         * @brief Notifies the owning reactor once the coroutine has finished.
+         */
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(handle_type h) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type
+        {
+            reactor *owner_{nullptr}; ///< Reactor the task was spawned on.
+            std::exception_ptr error_; ///< Exception the coroutine exited with.
+
+            task get_return_object() noexcept { return task{handle_type::from_promise(*this)}; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            final_awaiter final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() noexcept { error_ = std::current_exception(); }
+        };
+
+        task(task &&other) noexcept
+            : handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        task &operator=(task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        task(const task &) = delete;
+        task &operator=(const task &) = delete;
+
+        ~task() { destroy(); }
+
+        /**
+         * @brief Give up ownership of the frame, for the reactor.
+         */
+        handle_type release() noexcept { return std::exchange(handle_, {}); }
+
+    private:
+        explicit task(handle_type handle) noexcept
+            : handle_(handle)
+        {
+        }
+
+        void destroy() noexcept
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+                handle_ = {};
+            }
+        }
+
+        handle_type handle_; ///< Owned frame, until spawned.
+    };
+
+} // namespace engine::reactor
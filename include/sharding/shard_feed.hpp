@@ -0,0 +1,257 @@
+#pragma once
+
+#include "concurrency/idle_strategy.hpp"
+#include "concurrency/spsc_ring.hpp"
+#include "concurrency/thread_utils.hpp"
+#include "ingest/tick_view.hpp"
+#include "portfolio/portfolio_manager.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::sharding
+{
+    /**
+     * @brief Portfolio figures of one shard, or summed across shards.
+     */
+    struct portfolio_totals
+    {
+        double cash = 0.0;           ///< Cash balance.
+        double realized_pnl = 0.0;   ///< Realized profit and loss.
+        double unrealized_pnl = 0.0; ///< Unrealized profit and loss at last seen prices.
+        double equity = 0.0;         ///< Cash plus holdings at last seen prices.
+
+        /// @brief Accumulate another shard.
+        portfolio_totals &operator+=(const portfolio_totals &other) noexcept
+        {
+            cash += other.cash;
+            realized_pnl += other.realized_pnl;
+            unrealized_pnl += other.unrealized_pnl;
+            equity += other.equity;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Link between the router and one shard engine.
+     *
+     * Ticks travel through an SPSC ring carrying router symbol IDs. The router defines a symbol's
+     * name before its first tick, names are read by the shard only on first sight, so the name
+     * table's mutex is off the hot path. The shard publishes its portfolio totals behind a
+     * sequence counter, so readers on other threads never block it.
+     */
+    class shard_channel
+    {
+    public:
+        /**
+         * @brief Construct a channel.
+         * @param capacity Ticks in flight from router to shard.
+         */
+        explicit shard_channel(size_t capacity)
+            : ring_(capacity)
+        {
+        }
+
+        /// @brief Shared between threads by reference only.
+        shard_channel(const shard_channel &) = delete;
+        shard_channel &operator=(const shard_channel &) = delete;
+
+        /**
+         * @brief Name a router symbol ID. Router thread, before the first tick using it.
+         */
+        void define_symbol(symbols::symbol_id id, std::string_view name)
+        {
+            std::lock_guard lock(names_mutex_);
+            if (id >= names_.size())
+            {
+                // Deque growth keeps existing names in place for views held by the shard
+                names_.resize(static_cast<size_t>(id) + 1);
+            }
+            names_[id] = name;
+        }
+
+        /**
+         * @brief Name of a router symbol ID. Shard thread.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const
+        {
+            std::lock_guard lock(names_mutex_);
+            return id < names_.size() ? std::string_view{names_[id]} : std::string_view{};
+        }
+
+        /**
+         * @brief Publish a tick. Router thread.
+         * @return False if the ring is full.
+         */
+        bool try_push(const ingest::tick_view &tick) noexcept { return ring_.try_push(tick); }
+
+        /**
+         * @brief Take up to out.size() ticks without waiting. Shard thread.
+         * @return Number of ticks written.
+         */
+        size_t try_pop_batch(std::span<ingest::tick_view> out) noexcept
+        {
+            size_t n = 0;
+            while (n < out.size() && ring_.try_pop(out[n]))
+            {
+                ++n;
+            }
+            return n;
+        }
+
+        /**
+         * @brief Mark the end of the stream. Router thread, after the last push.
+         */
+        void close() noexcept { closed_.store(true, std::memory_order_release); }
+
+        /**
+         * @brief True once the router has closed the stream.
+         */
+        bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Mark the shard engine as no longer consuming, the router then drops its ticks.
+         */
+        void finish() noexcept { finished_.store(true, std::memory_order_release); }
+
+        /**
+         * @brief True once the shard engine has returned.
+         */
+        bool finished() const noexcept { return finished_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Portfolio published by publish(). Set before the shard starts.
+         */
+        void watch(const portfolio::portfolio_manager &portfolio) noexcept { portfolio_ = &portfolio; }
+
+        /**
+         * @brief Publish the watched portfolio's totals. Shard thread, between dispatches.
+         */
+        void publish() noexcept
+        {
+            if (!portfolio_)
+            {
+                return;
+            }
+
+            // Odd sequence marks a write in progress
+            const auto seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            cash_.store(portfolio_->cash_balance(), std::memory_order_relaxed);
+            realized_.store(portfolio_->realized_pnl(), std::memory_order_relaxed);
+            unrealized_.store(portfolio_->unrealized_pnl(), std::memory_order_relaxed);
+            equity_.store(portfolio_->total_equity(), std::memory_order_relaxed);
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Last published portfolio totals, safe from any thread.
+         */
+        portfolio_totals totals() const noexcept
+        {
+            portfolio_totals out;
+            uint64_t before;
+            uint64_t after;
+            do
+            {
+                before = seq_.load(std::memory_order_acquire);
+                out.cash = cash_.load(std::memory_order_relaxed);
+                out.realized_pnl = realized_.load(std::memory_order_relaxed);
+                out.unrealized_pnl = unrealized_.load(std::memory_order_relaxed);
+                out.equity = equity_.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = seq_.load(std::memory_order_relaxed);
+            } while (before != after || (before & 1) != 0);
+            return out;
+        }
+
+        /**
+         * @brief Number of pushes that found the ring full. Safe from any thread.
+         */
+        uint64_t producer_stalls() const noexcept { return ring_.producer_stalls(); }
+
+    private:
+        concurrency::spsc_ring<ingest::tick_view> ring_;                     ///< Router to shard ticks.
+        std::atomic<bool> closed_{false};                                    ///< No more ticks will be pushed.
+        std::atomic<bool> finished_{false};                                  ///< Shard engine has returned.
+        mutable std::mutex names_mutex_;                                     ///< Guards names_, first sight only.
+        std::deque<std::string> names_;                                      ///< Name by router symbol ID.
+        const portfolio::portfolio_manager *portfolio_{nullptr};             ///< Shard portfolio, read on the shard thread.
+        alignas(concurrency::cache_line_size) std::atomic<uint64_t> seq_{0}; ///< Publication sequence, odd while writing.
+        std::atomic<double> cash_{0.0};                                      ///< Published cash.
+        std::atomic<double> realized_{0.0};                                  ///< Published realized PnL.
+        std::atomic<double> unrealized_{0.0};                                ///< Published unrealized PnL.
+        std::atomic<double> equity_{0.0};                                    ///< Published equity.
+    };
+
+    /**
+     * @brief Batch streamer a shard engine reads its ticks from.
+     *
+     * next_batch() waits for the router, returning 0 only once the stream is closed and drained,
+     * so a backtest engine stopping on its first empty poll runs the whole stream. Portfolio
+     * totals are published every publish_interval batches and once more at the end.
+     */
+    class shard_feed
+    {
+    public:
+        /**
+         * @brief Construct a feed over a channel.
+         * @param channel Channel owned by the runner, outliving the feed.
+         * @param publish_interval Batches between portfolio publications, at least 1.
+         */
+        shard_feed(shard_channel &channel, uint32_t publish_interval) noexcept
+            : channel_(&channel), publish_interval_(publish_interval == 0 ? 1 : publish_interval)
+        {
+        }
+
+        /**
+         * @brief Wait for the next ticks.
+         * @param out Destination.
+         * @return Number of ticks written, 0 once the stream is closed and drained.
+         */
+        size_t next_batch(std::span<ingest::tick_view> out) noexcept
+        {
+            // Publish what the previous batch did
+            if (++batches_ >= publish_interval_)
+            {
+                batches_ = 0;
+                channel_->publish();
+            }
+
+            while (true)
+            {
+                // Read closed before popping, so an empty pop after it means drained
+                const bool closed = channel_->closed();
+                if (const size_t n = channel_->try_pop_batch(out))
+                {
+                    idle_.reset();
+                    return n;
+                }
+                if (closed)
+                {
+                    channel_->publish();
+                    return 0;
+                }
+                idle_.idle();
+            }
+        }
+
+        /**
+         * @brief Name of a router symbol ID.
+         */
+        std::string_view symbol_name(symbols::symbol_id id) const { return channel_->symbol_name(id); }
+
+    private:
+        shard_channel *channel_;           ///< Runner owned channel.
+        uint32_t publish_interval_;        ///< Batches between publications.
+        uint32_t batches_{0};              ///< Batches since the last publication.
+        concurrency::backoff_idle idle_{}; ///< Waits for the router.
+    };
+
+} // namespace engine::sharding
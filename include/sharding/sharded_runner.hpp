@@ -0,0 +1,283 @@
+#pragma once
+
+#include "concurrency/idle_strategy.hpp"
+#include "concurrency/thread_utils.hpp"
+#include "errors/error_code.hpp"
+#include "ingest/tick_view.hpp"
+#include "sharding/shard_feed.hpp"
+#include "symbols/symbol_registry.hpp"
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace engine::sharding
+{
+    /**
+     * @brief Configuration for a sharded run.
+     */
+    struct shard_config
+    {
+        size_t shards = 1;               ///< Number of engine instances.
+        size_t ring_capacity = 1u << 14; ///< Ticks in flight from the router to each shard.
+        std::vector<int> cores{};        ///< Core to pin each shard to, missing or negative leaves it unpinned.
+        uint32_t publish_interval = 16;  ///< Shard batches between portfolio publications.
+    };
+
+    /**
+     * @brief Runs one engine per symbol partition, each on its own thread.
+     *
+     * The calling thread routes ticks from a batch streamer to the shard owning their symbol, and
+     * each shard engine reads them through a shard_feed. Symbols are assigned round robin on first
+     * sight unless pinned with assign(), and stay on their shard for the run, so per symbol state
+     * in the strategy, execution handler and order queue of a shard is never shared. Components
+     * shared across shards, such as an order ID generator, must be thread safe.
+     *
+     * Each shard has its own portfolio, seeded with its slice of the capital by the factory. The
+     * consolidated view sums the totals shards publish between batches, so it lags the shards
+     * slightly and never locks them.
+     *
+     * @tparam Engine Engine type, an engine_base over shard_feed.
+     */
+    template <typename Engine>
+    class sharded_runner
+    {
+    public:
+        /// @brief Ticks pulled from the source per routing pass.
+        static constexpr size_t route_batch_size = 256;
+
+        /**
+         * @brief Build the shard engines.
+         * @param config Shard count, ring size and core placement.
+         * @param make_engine Callable (size_t shard, shard_feed feed) returning std::unique_ptr<Engine>.
+         */
+        template <typename Factory>
+        sharded_runner(const shard_config &config, Factory &&make_engine)
+            : config_(config)
+        {
+            if (config_.shards == 0)
+            {
+                errors::raise<std::invalid_argument>("sharded_runner needs at least one shard");
+            }
+
+            shards_.reserve(config_.shards);
+            for (size_t i = 0; i < config_.shards; ++i)
+            {
+                auto &s = shards_.emplace_back();
+                s.channel = std::make_unique<shard_channel>(config_.ring_capacity);
+                s.engine = make_engine(i, shard_feed{*s.channel, config_.publish_interval});
+                s.channel->watch(s.engine->portfolio_manager());
+                s.channel->publish();
+            }
+        }
+
+        /**
+         * @brief Pin a symbol to a shard. Call before run().
+         * @param symbol Symbol name.
+         * @param shard Shard index.
+         */
+        void assign(std::string_view symbol, size_t shard)
+        {
+            if (shard >= shards_.size())
+            {
+                errors::raise<std::out_of_range>("shard index out of range");
+            }
+            const auto id = symbols_.intern(symbol);
+            place(id, static_cast<uint32_t>(shard));
+        }
+
+        /**
+         * @brief Run every shard over a source until it is exhausted.
+         *
+         * Shards start on their own threads, then the calling thread routes the source and closes
+         * every feed. Returns once all shards have returned, rethrowing the first shard error.
+         * Ticks for a shard that stopped early are dropped.
+         *
+         * @param source Batch streamer providing the whole universe.
+         */
+        template <typename Source>
+            requires ingest::batch_streamer<Source>
+        void run(Source &source)
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(shards_.size());
+            for (size_t i = 0; i < shards_.size(); ++i)
+            {
+                auto &s = shards_[i];
+                threads.emplace_back([&s]
+                                     {
+#if ENGINE_EXCEPTIONS
+                    try
+                    {
+                        s.engine->run();
+                    }
+                    catch (...)
+                    {
+                        s.error = std::current_exception();
+                    }
+#else
+                    s.engine->run();
+#endif
+                    s.channel->finish(); });
+                concurrency::pin_to_core(threads.back().native_handle(), i < config_.cores.size() ? config_.cores[i] : -1);
+            }
+
+#if ENGINE_EXCEPTIONS
+            try
+            {
+                route(source);
+            }
+            catch (...)
+            {
+                close_all();
+                throw;
+            }
+#else
+            route(source);
+#endif
+            close_all();
+
+            for (auto &t : threads)
+            {
+                t.join();
+            }
+            for (auto &s : shards_)
+            {
+                if (s.error)
+                {
+                    std::rethrow_exception(s.error);
+                }
+            }
+        }
+
+        /**
+         * @brief Number of shards.
+         */
+        size_t shard_count() const noexcept { return shards_.size(); }
+
+        /**
+         * @brief Shard engine, only safe to inspect while no run is active.
+         */
+        Engine &shard(size_t index) noexcept { return *shards_[index].engine; }
+
+        /**
+         * @brief Const shard engine, only safe to inspect while no run is active.
+         */
+        const Engine &shard(size_t index) const noexcept { return *shards_[index].engine; }
+
+        /**
+         * @brief Shard owning a symbol, or shard_count() if it was never routed or assigned. Not during a run.
+         */
+        size_t shard_of(std::string_view symbol) const noexcept
+        {
+            const auto id = symbols_.find(symbol);
+            return id < shard_of_.size() && shard_of_[id] != unassigned ? shard_of_[id] : shards_.size();
+        }
+
+        /**
+         * @brief Last published totals of one shard, safe from any thread.
+         */
+        portfolio_totals shard_portfolio(size_t index) const noexcept { return shards_[index].channel->totals(); }
+
+        /**
+         * @brief Totals summed across shards, safe from any thread.
+         */
+        portfolio_totals portfolio() const noexcept
+        {
+            portfolio_totals total;
+            for (const auto &s : shards_)
+            {
+                total += s.channel->totals();
+            }
+            return total;
+        }
+
+        /**
+         * @brief Times the router found a shard's ring full, summed across shards.
+         */
+        uint64_t producer_stalls() const noexcept
+        {
+            uint64_t stalls = 0;
+            for (const auto &s : shards_)
+            {
+                stalls += s.channel->producer_stalls();
+            }
+            return stalls;
+        }
+
+    private:
+        /// @brief Marks a router symbol without a shard.
+        static constexpr uint32_t unassigned = UINT32_MAX;
+
+        /// @brief One engine and its feed.
+        struct shard_slot
+        {
+            std::unique_ptr<shard_channel> channel; ///< Router to engine link.
+            std::unique_ptr<Engine> engine;         ///< Engine reading the channel.
+            std::exception_ptr error;               ///< Error the engine returned with.
+        };
+
+        /// @brief Route the whole source, returning once it is exhausted.
+        template <typename Source>
+        void route(Source &source)
+        {
+            std::array<ingest::tick_view, route_batch_size> batch;
+            concurrency::backoff_idle idle;
+            while (const size_t n = source.next_batch(std::span{batch}))
+            {
+                for (auto &tick : std::span{batch.data(), n})
+                {
+                    bool fresh = false;
+                    tick.symbol = source_symbols_.resolve(tick.symbol, symbols_, [&source](symbols::symbol_id local)
+                                                          { return std::string_view{source.symbol_name(local)}; }, fresh);
+                    if (tick.symbol >= shard_of_.size() || shard_of_[tick.symbol] == unassigned) [[unlikely]]
+                    {
+                        place(tick.symbol, static_cast<uint32_t>(next_shard_++ % shards_.size()));
+                    }
+
+                    auto &channel = *shards_[shard_of_[tick.symbol]].channel;
+                    while (!channel.try_push(tick))
+                    {
+                        if (channel.finished())
+                            break;
+                        idle.idle();
+                    }
+                    idle.reset();
+                }
+            }
+        }
+
+        /// @brief Bind a router symbol to a shard, naming it on that shard's channel.
+        void place(symbols::symbol_id id, uint32_t index)
+        {
+            if (id >= shard_of_.size())
+            {
+                shard_of_.resize(static_cast<size_t>(id) + 1, unassigned);
+            }
+            shard_of_[id] = index;
+            shards_[index].channel->define_symbol(id, symbols_.name(id));
+        }
+
+        /// @brief End every feed's stream.
+        void close_all() noexcept
+        {
+            for (auto &s : shards_)
+            {
+                s.channel->close();
+            }
+        }
+
+        shard_config config_;               ///< Shard layout.
+        std::vector<shard_slot> shards_;    ///< Engines by shard index.
+        symbols::symbol_registry symbols_;  ///< Router symbol IDs, carried by routed ticks.
+        ingest::symbol_map source_symbols_; ///< Source symbol IDs to router IDs.
+        std::vector<uint32_t> shard_of_;    ///< Shard by router symbol ID.
+        size_t next_shard_{0};              ///< Round robin cursor for unpinned symbols.
+    };
+
+} // namespace engine::sharding
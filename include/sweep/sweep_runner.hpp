@@ -0,0 +1,91 @@
+#pragma once
+
+#include "concurrency/work_stealing.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "portfolio/portfolio_manager.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace engine::sweep
+{
+    /**
+     * @brief Outcome of one parameter set, read from its engine's portfolio after the run.
+     */
+    struct sweep_result
+    {
+        size_t job = 0;              ///< Index of the parameter set.
+        double cash = 0.0;           ///< Final cash balance.
+        double realized_pnl = 0.0;   ///< Final realized profit and loss.
+        double unrealized_pnl = 0.0; ///< Final unrealized profit and loss at last seen prices.
+        double equity = 0.0;         ///< Final cash plus holdings at last seen prices.
+        size_t fills = 0;            ///< Fills applied to the portfolio.
+        size_t cancels = 0;          ///< Cancels seen by the portfolio.
+    };
+
+    /**
+     * @brief Runs one backtest per parameter set over a shared tick dataset.
+     *
+     * The dataset is loaded once into a tick_buffer and every engine reads it through its own
+     * tick_cursor, so a job costs its engine's state and nothing per tick of history. Jobs run on
+     * a work stealing pool and each engine is destroyed once its result is taken, so memory grows
+     * with the worker count, not with the number of parameter sets.
+     *
+     * @tparam Engine Engine type, an engine_base over ingest::tick_cursor.
+     */
+    template <typename Engine>
+    class sweep_runner
+    {
+    public:
+        /**
+         * @brief Construct a runner over a dataset.
+         * @param data Ticks shared by every job, must outlive the runner and not change during a run.
+         * @param workers Threads to run jobs on, 0 for one per hardware thread.
+         */
+        explicit sweep_runner(const ingest::tick_buffer &data, size_t workers = 0) noexcept
+            : data_(data),
+              workers_(workers != 0 ? workers : std::max<size_t>(1, std::thread::hardware_concurrency()))
+        {
+        }
+
+        /**
+         * @brief Run every parameter set to the end of the dataset.
+         *
+         * The first job error stops the sweep and is rethrown once all workers have joined.
+         *
+         * @param params Parameter sets, one job each.
+         * @param make_engine Callable (const Params &, ingest::tick_cursor) returning std::unique_ptr<Engine>.
+         * @return One result per parameter set, in parameter order.
+         */
+        template <typename Params, typename Factory>
+        std::vector<sweep_result> run(const std::vector<Params> &params, Factory &&make_engine) const
+        {
+            std::vector<sweep_result> results(params.size());
+            concurrency::parallel_for(params.size(), workers_, [&](size_t job, size_t)
+                                      {
+                auto engine = make_engine(params[job], data_.cursor());
+                engine->run();
+                results[job] = summarize(job, engine->portfolio_manager()); });
+            return results;
+        }
+
+        /**
+         * @brief Number of worker threads.
+         */
+        size_t workers() const noexcept { return workers_; }
+
+    private:
+        /// @brief Read the final state of a job's portfolio.
+        static sweep_result summarize(size_t job, const portfolio::portfolio_manager &pm) noexcept
+        {
+            return {job, pm.cash_balance(), pm.realized_pnl(), pm.unrealized_pnl(), pm.total_equity(),
+                    pm.trade_log().size(), pm.cancel_count()};
+        }
+
+        const ingest::tick_buffer &data_; ///< Shared dataset.
+        size_t workers_;                  ///< Worker threads.
+    };
+
+} // namespace engine::sweep
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::symbols
+{
+    /// @brief Dense integer identifier for an interned symbol.
+    using symbol_id = uint32_t;
+
+    /// @brief Sentinel for a symbol that has not been interned.
+    inline constexpr symbol_id invalid_symbol = std::numeric_limits<symbol_id>::max();
+
+    /**
+     * @brief Maps symbol names to dense integer IDs.
+     *
+     * Symbols are interned once at ingestion time, after which every component works on the
+     * integer ID. IDs are assigned sequentially from zero so they can index flat arrays directly.
+     * The string name is kept for reporting.
+     */
+    class symbol_registry
+    {
+    public:
+        /**
+         * @brief Intern a symbol, assigning a new ID on first sight.
+         * @param name Symbol name.
+         * @return Dense ID of the symbol.
+         */
+        symbol_id intern(std::string_view name);
+
+        /**
+         * @brief Look up a symbol without interning it.
+         * @param name Symbol name.
+         * @return ID of the symbol, or invalid_symbol if it was never interned.
+         */
+        symbol_id find(std::string_view name) const noexcept;
+
+        /**
+         * @brief Get the name of an interned symbol.
+         * @param id Symbol ID, must have been returned by intern().
+         */
+        const std::string &name(symbol_id id) const noexcept { return names_[id]; }
+
+        /**
+         * @brief Number of interned symbols.
+         */
+        size_t size() const noexcept { return names_.size(); }
+
+        /**
+         * @brief Save the interned names, in ID order.
+         */
+        void save(checkpoint::snapshot_writer &out) const;
+
+        /**
+         * @brief Replace the table with a saved one, reproducing every ID.
+         */
+        void restore(checkpoint::snapshot_reader &in);
+
+    private:
+        /// @brief Transparent hash so lookups by string_view don't allocate.
+        struct name_hash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view sv) const noexcept { return std::hash<std::string_view>{}(sv); }
+        };
+
+        std::unordered_map<std::string, symbol_id, name_hash, std::equal_to<>> ids_; ///< Name to ID index.
+        std::vector<std::string> names_;                                              ///< ID to name.
+    };
+
+} // namespace engine::symbols
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "events/event.hpp"
+
+#include <chrono>
+
+namespace engine::timing
+{
+    /// @brief Engine time point, shared with event timestamps.
+    using time_point = std::chrono::system_clock::time_point;
+
+    /**
+     * @brief Wall clock for live engines.
+     *
+     * Reads the system clock once per engine loop iteration and serves that cached value to
+     * everything stamped during the iteration, instead of one clock read per event.
+     */
+    class real_time_clock
+    {
+    public:
+        /// @brief Current cached time.
+        time_point now() const noexcept { return now_; }
+
+        /// @brief Refresh cached time, called once per engine loop iteration.
+        void on_loop() noexcept { now_ = std::chrono::system_clock::now(); }
+
+        /// @brief Ticks don't move wall time.
+        void on_tick(const events::market_event &) noexcept {}
+
+    private:
+        time_point now_{std::chrono::system_clock::now()}; ///< Time of last loop iteration.
+    };
+
+    /**
+     * @brief Tick driven clock for backtests.
+     *
+     * Time only advances with the exchange timestamp of market data, so runs are deterministic
+     * and never read the system clock.
+     */
+    class sim_clock
+    {
+    public:
+        /// @brief Current simulated time.
+        time_point now() const noexcept { return now_; }
+
+        /// @brief Loop iterations don't move simulated time.
+        void on_loop() noexcept {}
+
+        /// @brief Advance to the tick's exchange time, never backwards.
+        void on_tick(const events::market_event &tick) noexcept
+        {
+            advance_to(time_point{std::chrono::milliseconds{tick.timestamp_ms_}});
+        }
+
+        /// @brief Advance to a time, never backwards.
+        void advance_to(time_point t) noexcept
+        {
+            if (t > now_)
+            {
+                now_ = t;
+            }
+        }
+
+        /// @brief Save simulated time.
+        void save(checkpoint::snapshot_writer &out) const { out.put(now_); }
+
+        /// @brief Restore simulated time.
+        void restore(checkpoint::snapshot_reader &in) { in.get(now_); }
+
+    private:
+        time_point now_{}; ///< Simulated time.
+    };
+
+} // namespace engine::timing
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "checkpoint/snapshot.hpp"
+#include "events/timer_id.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace engine::timing
+{
+    /**
+     * @brief Hierarchical timer wheel over 64 bit nanosecond time.
+     *
+     * Time is counted in ticks of a fixed resolution. Eight levels of 256 slots each cover the
+     * whole 64 bit tick range, a timer sitting in the level of the highest byte where its due tick
+     * differs from the current tick, so schedule and cancel are O(1) list operations and a timer
+     * is moved down at most seven times before it fires. Advancing jumps straight to the next
+     * occupied slot through per level occupancy bitmaps, so long quiet stretches of simulated time
+     * cost nothing.
+     *
+     * Timers fire at the first advance at or after their due time rounded up to the resolution.
+     * Timers due in the same tick fire together, in no specified order. Nodes come from a pool
+     * that only grows and slot lists are allocated on first use, so an idle wheel costs a few words
+     * and in steady state nothing allocates.
+     */
+    class timer_wheel
+    {
+    public:
+        /// @brief Default tick length.
+        static constexpr std::chrono::nanoseconds default_resolution = std::chrono::milliseconds{1};
+
+        /**
+         * @brief Construct an empty wheel.
+         * @param resolution Tick length, at least one nanosecond.
+         */
+        explicit timer_wheel(std::chrono::nanoseconds resolution = default_resolution);
+
+        /**
+         * @brief Schedule a timer.
+         * @param due_ns Due time in nanoseconds since epoch, a time already passed fires on the
+         *               next advance.
+         * @param tag Caller value handed back when the timer fires.
+         * @param period_ns Re-arm interval for a periodic timer, 0 for one shot.
+         * @return Handle for cancel(), valid until a one shot timer fires.
+         */
+        events::timer_id schedule(uint64_t due_ns, uint64_t tag = 0, uint64_t period_ns = 0);
+
+        /**
+         * @brief Cancel a pending timer.
+         * @return False if the handle is stale, e.g. the timer already fired.
+         */
+        bool cancel(events::timer_id id) noexcept;
+
+        /**
+         * @brief Fire every timer due at or before a time.
+         *
+         * Periodic timers are re-armed before their callback runs, to their first period after
+         * the time advanced to. A periodic timer that missed several periods, as after a jump in
+         * time, fires once for all of them rather than once per period. Callbacks may schedule
+         * and cancel timers, ones they schedule already due fire within this advance, a tick later.
+         *
+         * @param now_ns Current time in nanoseconds since epoch.
+         * @param fire Callable taking the timer's handle, tag and due time in nanoseconds.
+         * @return Number of timers fired.
+         */
+        template <typename Fire>
+        size_t advance(uint64_t now_ns, Fire &&fire)
+        {
+            const uint64_t target = now_ns / resolution_;
+            size_t fired = 0;
+            while (count_ != 0)
+            {
+                const uint64_t next = next_tick();
+                if (next > target)
+                {
+                    break;
+                }
+                current_ = next;
+                cascade(next);
+                fired += fire_slot(next, now_ns, fire);
+            }
+            if (target > current_)
+            {
+                current_ = target;
+            }
+            return fired;
+        }
+
+        /**
+         * @brief Number of pending timers.
+         */
+        size_t size() const noexcept { return count_; }
+
+        /**
+         * @brief True if no timer is pending.
+         */
+        bool empty() const noexcept { return count_ == 0; }
+
+        /**
+         * @brief Tick length in nanoseconds.
+         */
+        uint64_t resolution() const noexcept { return resolution_; }
+
+        /**
+         * @brief Save every pending timer, handles stay valid across a restore.
+         */
+        void save(checkpoint::snapshot_writer &out) const;
+
+        /**
+         * @brief Replace all timers with saved ones, leaving the wheel as it was if this throws.
+         * @throws std::runtime_error if the section is truncated or its pool and lists are inconsistent.
+         */
+        void restore(checkpoint::snapshot_reader &in);
+
+    private:
+        /// @brief Slots per level and levels, one per byte of the tick.
+        static constexpr size_t slot_bits = 8;
+        static constexpr size_t slots = size_t{1} << slot_bits;
+        static constexpr size_t levels = 64 / slot_bits;
+
+        /// @brief List of nodes being fired, after the wheel's slot lists.
+        static constexpr uint32_t firing_list = levels * slots;
+
+        /// @brief End of a node list.
+        static constexpr uint32_t nil = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Pooled timer.
+         */
+        struct node
+        {
+            uint64_t due_ns_{0};     ///< Due time.
+            uint64_t due_tick_{0};   ///< Tick the timer fires at.
+            uint64_t period_ns_{0};  ///< Re-arm interval, 0 for one shot.
+            uint64_t tag_{0};        ///< Caller value.
+            uint32_t prev_{nil};     ///< Previous node in its list.
+            uint32_t next_{nil};     ///< Next node in its list, or in the free list.
+            uint32_t list_{nil};     ///< List holding the node, nil while free.
+            uint32_t generation_{0}; ///< Bumped on release, invalidates old handles.
+        };
+
+        /**
+         * @brief Head and tail of a node list.
+         */
+        struct node_list
+        {
+            uint32_t head_{nil}; ///< First node.
+            uint32_t tail_{nil}; ///< Last node.
+        };
+
+        /// @brief Handle for a pooled node.
+        events::timer_id id_of(uint32_t index) const noexcept
+        {
+            return (static_cast<uint64_t>(nodes_[index].generation_) << 32) | (static_cast<uint64_t>(index) + 1);
+        }
+
+        /// @brief Tick a due time fires at, never before the next tick.
+        uint64_t tick_after(uint64_t due_ns) const noexcept
+        {
+            const uint64_t tick = due_ns / resolution_ + (due_ns % resolution_ != 0 ? 1 : 0);
+            return tick > current_ ? tick : current_ + 1;
+        }
+
+        /// @brief Place a node in the slot for its due tick.
+        void insert(uint32_t index) noexcept;
+
+        /// @brief Append a node to a list.
+        void link(uint32_t index, uint32_t list) noexcept;
+
+        /// @brief Remove a node from its list.
+        void unlink(uint32_t index) noexcept;
+
+        /// @brief Return a node to the pool.
+        void release(uint32_t index) noexcept;
+
+        /// @brief Earliest tick after the current one with a slot to fire or cascade.
+        uint64_t next_tick() const noexcept;
+
+        /// @brief Move down the timers of every level whose slot starts at tick.
+        void cascade(uint64_t tick) noexcept;
+
+        /// @brief Move the level 0 slot of tick onto the firing list.
+        void take_slot(uint64_t tick) noexcept;
+
+        /// @brief Fire the level 0 slot of the current tick, advancing to a time.
+        template <typename Fire>
+        size_t fire_slot(uint64_t tick, uint64_t now_ns, Fire &fire)
+        {
+            take_slot(tick);
+            size_t fired = 0;
+            while (lists_[firing_list].head_ != nil)
+            {
+                const uint32_t index = lists_[firing_list].head_;
+                unlink(index);
+                const auto id = id_of(index);
+                auto &n = nodes_[index];
+                const uint64_t due = n.due_ns_;
+                const uint64_t tag = n.tag_;
+                if (n.period_ns_ != 0)
+                {
+                    n.due_ns_ = due + n.period_ns_;
+                    if (n.due_ns_ <= now_ns)
+                    {
+                        // Missed periods are folded into this firing, keeping the timer's phase
+                        n.due_ns_ += ((now_ns - n.due_ns_) / n.period_ns_ + 1) * n.period_ns_;
+                    }
+                    n.due_tick_ = tick_after(n.due_ns_);
+                    insert(index);
+                }
+                else
+                {
+                    release(index);
+                }
+                // Copies taken, the callback may grow the pool
+                fire(id, tag, due);
+                ++fired;
+            }
+            return fired;
+        }
+
+        /// @brief Check restored state, every index in bounds and every node on exactly one list.
+        bool consistent() const;
+
+        /// @brief Occupancy bitmap of one level.
+        using slot_mask = std::array<uint64_t, slots / 64>;
+
+        uint64_t resolution_;                      ///< Tick length in nanoseconds.
+        uint64_t current_{0};                      ///< Last tick processed.
+        size_t count_{0};                          ///< Pending timers.
+        uint32_t free_{nil};                       ///< Free list of released nodes.
+        std::vector<node> nodes_;                  ///< Node pool, indexed by handle.
+        std::vector<node_list> lists_;             ///< Slot lists by level then the firing list, empty until first use.
+        std::array<slot_mask, levels> occupied_{}; ///< Non-empty slots by level.
+    };
+
+} // namespace engine::timing
@@ -0,0 +1,137 @@
+#include "checkpoint/snapshot.hpp"
+#include "errors/error_code.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace engine::checkpoint
+{
+    namespace
+    {
+        /// @brief Closes a stdio file on scope exit.
+        struct file_closer
+        {
+            void operator()(std::FILE *f) const noexcept { std::fclose(f); }
+        };
+        using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+    } // namespace
+
+    snapshot_writer::snapshot_writer()
+    {
+        put(snapshot_header{});
+    }
+
+    void snapshot_writer::set_event_layout(size_t bytes, uint64_t fingerprint) noexcept
+    {
+        const auto size = static_cast<uint32_t>(bytes);
+        std::memcpy(buffer_.data() + offsetof(snapshot_header, event_size_), &size, sizeof(size));
+        std::memcpy(buffer_.data() + offsetof(snapshot_header, event_layout_), &fingerprint, sizeof(fingerprint));
+    }
+
+    void snapshot_writer::write_file(const std::filesystem::path &path) const
+    {
+        // Write a sibling and rename it over the target, so a crash leaves the old snapshot or
+        // the new one, never a torn file
+        auto tmp = path;
+        tmp += ".tmp";
+        bool ok = false;
+        if (file_ptr file{std::fopen(tmp.c_str(), "wb")})
+        {
+            ok = std::fwrite(buffer_.data(), 1, buffer_.size(), file.get()) == buffer_.size() &&
+                 std::fflush(file.get()) == 0 && ::fsync(::fileno(file.get())) == 0;
+            ok = std::fclose(file.release()) == 0 && ok;
+        }
+
+        std::error_code ec;
+        if (ok)
+        {
+            std::filesystem::rename(tmp, path, ec);
+        }
+        if (!ok || ec)
+        {
+            std::filesystem::remove(tmp, ec);
+            errors::raise<std::runtime_error>("Unable to write snapshot: " + path.string());
+        }
+
+        // Persist the rename itself, best effort
+        const auto dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."};
+        if (const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); fd >= 0)
+        {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    snapshot_reader::snapshot_reader(std::span<const std::byte> bytes)
+        : buffer_(bytes.begin(), bytes.end())
+    {
+        check_header();
+    }
+
+    snapshot_reader::snapshot_reader(const std::filesystem::path &path)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        file_ptr file{ec ? nullptr : std::fopen(path.c_str(), "rb")};
+        if (!file)
+        {
+            errors::raise<std::runtime_error>("Unable to open snapshot: " + path.string());
+        }
+
+        // One read of the whole file, restore then works from memory
+        buffer_.resize(static_cast<size_t>(size));
+        if (std::fread(buffer_.data(), 1, buffer_.size(), file.get()) != buffer_.size())
+        {
+            errors::raise<std::runtime_error>("Unable to read snapshot: " + path.string());
+        }
+        check_header();
+    }
+
+    void snapshot_reader::section(uint32_t section)
+    {
+        if (get<uint32_t>() != section)
+        {
+            errors::raise<std::runtime_error>("Snapshot section mismatch, engine composition differs");
+        }
+    }
+
+    void snapshot_reader::check_header()
+    {
+        snapshot_header header;
+        if (remaining() < sizeof(header))
+        {
+            errors::raise<std::runtime_error>("Not a snapshot");
+        }
+        get(header);
+        if (header.magic_ != snapshot_magic)
+        {
+            errors::raise<std::runtime_error>("Not a snapshot");
+        }
+        if (header.version_ != format_version)
+        {
+            errors::raise<std::runtime_error>("Incompatible snapshot");
+        }
+        event_size_ = header.event_size_;
+        event_layout_ = header.event_layout_;
+    }
+
+    void snapshot_reader::check_event_layout(size_t bytes, uint64_t fingerprint) const
+    {
+        if (event_size_ != bytes || event_layout_ != fingerprint)
+        {
+            errors::raise<std::runtime_error>("Incompatible snapshot, event layout differs");
+        }
+    }
+
+    void snapshot_reader::truncated()
+    {
+        errors::raise<std::runtime_error>("Truncated snapshot");
+    }
+
+} // namespace engine::checkpoint
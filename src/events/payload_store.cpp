@@ -0,0 +1,58 @@
+#include "events/payload_store.hpp"
+
+namespace engine::events
+{
+    reason_ref payload_store::intern_reason(std::string_view reason)
+    {
+        // Fast path, already interned
+        if (auto it = reason_ids_.find(reason); it != reason_ids_.end())
+        {
+            return reason_ref{it->second};
+        }
+
+        // Handles are 1 based so 0 stays null
+        reasons_.emplace_back(reason);
+        auto seq = static_cast<uint32_t>(reasons_.size());
+        reason_ids_.emplace(reasons_.back(), seq);
+        return reason_ref{seq};
+    }
+
+    std::string_view payload_store::reason(reason_ref ref) const noexcept
+    {
+        if (!ref || ref.seq_ > reasons_.size())
+        {
+            return {};
+        }
+        return reasons_[ref.seq_ - 1];
+    }
+
+    void payload_store::save(checkpoint::snapshot_writer &out) const
+    {
+        out.section(checkpoint::tag("PAYL"));
+        ticks_.save(out);
+        orders_.save(out);
+        out.put(static_cast<uint64_t>(reasons_.size()));
+        for (const auto &reason : reasons_)
+        {
+            out.put_string(reason);
+        }
+    }
+
+    void payload_store::restore(checkpoint::snapshot_reader &in)
+    {
+        in.section(checkpoint::tag("PAYL"));
+        ticks_.restore(in);
+        orders_.restore(in);
+
+        // Re-interning in handle order reproduces every handle
+        const auto count = in.get_count(sizeof(uint64_t));
+        reasons_.clear();
+        reason_ids_.clear();
+        reasons_.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            intern_reason(in.get_string());
+        }
+    }
+
+} // namespace engine::events
@@ -0,0 +1,405 @@
+#include "journal/journal_reader.hpp"
+#include "errors/error_code.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace engine::journal
+{
+    namespace
+    {
+        /// @brief Copy a trivially copyable value out of unaligned bytes.
+        template <typename T>
+        T load(const std::byte *p) noexcept
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        /// @brief Size of a payload record of a kind, 0 if it isn't one.
+        constexpr size_t payload_record_size(uint8_t kind) noexcept
+        {
+            switch (kind)
+            {
+            case tick_payload_record:
+                return 1 + sizeof(uint32_t) + sizeof(events::market_event);
+            case order_payload_record:
+                return 1 + sizeof(uint32_t) + sizeof(events::order_event);
+            default:
+                return 0;
+            }
+        }
+    } // namespace
+
+    journal_reader::journal_reader(const std::filesystem::path &path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            errors::raise<std::runtime_error>("Unable to open journal: " + path.string());
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(file_header))
+        {
+            ::close(fd);
+            errors::raise<std::runtime_error>("Not a journal: " + path.string());
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            size_ = 0;
+            errors::raise<std::runtime_error>("Unable to map journal: " + path.string());
+        }
+        ::madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const std::byte *>(mapped);
+
+        const auto header = load<file_header>(data_);
+        const file_header expected{};
+        if (header.magic_ != expected.magic_ || header.version_ != expected.version_ || header.event_size_ != expected.event_size_)
+        {
+            unmap();
+            errors::raise<std::runtime_error>("Incompatible journal: " + path.string());
+        }
+
+        if (!load_index())
+        {
+            scan();
+        }
+        rewind();
+    }
+
+    journal_reader::~journal_reader()
+    {
+        unmap();
+    }
+
+    journal_reader::journal_reader(journal_reader &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          end_(std::exchange(other.end_, 0)),
+          cursor_(std::exchange(other.cursor_, 0)),
+          symbols_(std::move(other.symbols_)),
+          reasons_(std::move(other.reasons_)),
+          index_(std::move(other.index_)),
+          tick_(other.tick_),
+          order_(other.order_),
+          tick_seq_(std::exchange(other.tick_seq_, 0)),
+          order_seq_(std::exchange(other.order_seq_, 0)),
+          complete_(other.complete_)
+    {
+    }
+
+    journal_reader &journal_reader::operator=(journal_reader &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            end_ = std::exchange(other.end_, 0);
+            cursor_ = std::exchange(other.cursor_, 0);
+            symbols_ = std::move(other.symbols_);
+            reasons_ = std::move(other.reasons_);
+            index_ = std::move(other.index_);
+            tick_ = other.tick_;
+            order_ = other.order_;
+            tick_seq_ = std::exchange(other.tick_seq_, 0);
+            order_seq_ = std::exchange(other.order_seq_, 0);
+            complete_ = other.complete_;
+        }
+        return *this;
+    }
+
+    void journal_reader::seek(int64_t time_ns) noexcept
+    {
+        // Last entry strictly before t, earlier records may share an entry's time
+        auto it = std::lower_bound(index_.begin(), index_.end(), time_ns,
+                                   [](const index_entry &e, int64_t t)
+                                   { return e.time_ns_ < t; });
+        cursor_ = it == index_.begin() ? sizeof(file_header) : static_cast<size_t>(std::prev(it)->offset_);
+
+        // Scan to the first timed event at or after t
+        events::event ev;
+        for (auto pos = cursor_; next(ev); pos = cursor_)
+        {
+            if (auto t = event_time_ns(ev); t && *t >= time_ns)
+            {
+                cursor_ = pos;
+                return;
+            }
+        }
+    }
+
+    bool journal_reader::load_index() noexcept
+    {
+        if (size_ < sizeof(file_header) + sizeof(file_footer))
+        {
+            return false;
+        }
+        const auto footer = load<file_footer>(data_ + size_ - sizeof(file_footer));
+        const auto limit = size_ - sizeof(file_footer);
+        if (footer.magic_ != footer_magic || footer.index_offset_ < sizeof(file_header) || footer.index_offset_ >= limit ||
+            static_cast<uint8_t>(data_[footer.index_offset_]) != index_record)
+        {
+            return false;
+        }
+
+        // Bounds check every field, a bad trailer falls back to a scan
+        auto pos = static_cast<size_t>(footer.index_offset_) + 1;
+        auto take = [&](size_t n)
+        {
+            const auto at = pos;
+            pos += n;
+            return pos <= limit ? data_ + at : nullptr;
+        };
+
+        const auto *p = take(sizeof(uint32_t));
+        if (!p)
+        {
+            return false;
+        }
+        const auto symbol_count = load<uint32_t>(p);
+        for (uint32_t i = 0; i < symbol_count; ++i)
+        {
+            const auto *h = take(sizeof(symbol_header));
+            if (!h)
+            {
+                return false;
+            }
+            const auto header = load<symbol_header>(h);
+            const auto *name = take(header.length_);
+            if (!name)
+            {
+                return false;
+            }
+            if (!add_symbol(header, name))
+            {
+                return false;
+            }
+        }
+
+        p = take(sizeof(uint32_t));
+        if (!p)
+        {
+            return false;
+        }
+        const auto reason_count = load<uint32_t>(p);
+        for (uint32_t i = 0; i < reason_count; ++i)
+        {
+            const auto *h = take(sizeof(reason_header));
+            if (!h)
+            {
+                return false;
+            }
+            const auto header = load<reason_header>(h);
+            const auto *text = take(header.length_);
+            if (!text)
+            {
+                return false;
+            }
+            if (!add_reason(header, text))
+            {
+                return false;
+            }
+        }
+
+        p = take(sizeof(uint32_t));
+        if (!p)
+        {
+            return false;
+        }
+        const auto index_count = load<uint32_t>(p);
+        const auto *entries = take(index_count * sizeof(index_entry));
+        if (!entries)
+        {
+            return false;
+        }
+        index_.resize(index_count);
+        std::memcpy(index_.data(), entries, index_count * sizeof(index_entry));
+
+        end_ = static_cast<size_t>(footer.index_offset_);
+        complete_ = true;
+        return true;
+    }
+
+    void journal_reader::scan()
+    {
+        symbols_.clear();
+        reasons_.clear();
+        index_.clear();
+
+        // Same stride as the writer default, only the spacing of seeks depends on it
+        constexpr size_t stride = 4096;
+        size_t events = 0;
+        size_t pos = sizeof(file_header);
+        size_t payloads_at = 0;
+        events::event ev;
+        while (pos < size_)
+        {
+            const auto kind = static_cast<uint8_t>(data_[pos]);
+            if (kind < event_kinds)
+            {
+                const auto next = pos + 1 + payload_sizes[kind];
+                if (next > size_)
+                {
+                    break; // Torn final record
+                }
+                decode_event(kind, data_ + pos + 1, ev);
+                if (events++ % stride == 0 || index_.empty())
+                {
+                    if (auto t = event_time_ns(ev))
+                    {
+                        // Seeks land on the payloads recorded ahead of the event
+                        index_.push_back({*t, payloads_at != 0 ? payloads_at : pos});
+                    }
+                }
+                payloads_at = 0;
+                pos = next;
+            }
+            else if (const auto size = payload_record_size(kind); size != 0)
+            {
+                if (pos + size > size_)
+                {
+                    break;
+                }
+                if (payloads_at == 0)
+                {
+                    payloads_at = pos;
+                }
+                pos += size;
+            }
+            else if (kind == symbol_record)
+            {
+                if (pos + 1 + sizeof(symbol_header) > size_)
+                {
+                    break;
+                }
+                const auto header = load<symbol_header>(data_ + pos + 1);
+                const auto next = pos + 1 + sizeof(symbol_header) + header.length_;
+                if (next > size_)
+                {
+                    break;
+                }
+                if (!add_symbol(header, data_ + pos + 1 + sizeof(symbol_header)))
+                {
+                    break; // Corrupt definition
+                }
+                pos = next;
+            }
+            else if (kind == reason_record)
+            {
+                if (pos + 1 + sizeof(reason_header) > size_)
+                {
+                    break;
+                }
+                const auto header = load<reason_header>(data_ + pos + 1);
+                const auto next = pos + 1 + sizeof(reason_header) + header.length_;
+                if (next > size_)
+                {
+                    break;
+                }
+                if (!add_reason(header, data_ + pos + 1 + sizeof(reason_header)))
+                {
+                    break;
+                }
+                pos = next;
+            }
+            else
+            {
+                break; // Index record or garbage
+            }
+        }
+        end_ = pos;
+    }
+
+    bool journal_reader::add_symbol(const symbol_header &header, const std::byte *name)
+    {
+        // IDs are dense and each is defined by a record of its own, so a valid one is below the
+        // number of records the file could hold. Checked before growing to a corrupt ID.
+        if (header.id_ >= size_ / (1 + sizeof(symbol_header)))
+        {
+            return false;
+        }
+        if (header.id_ >= symbols_.size())
+        {
+            symbols_.resize(header.id_ + 1);
+        }
+        symbols_[header.id_].assign(reinterpret_cast<const char *>(name), header.length_);
+        return true;
+    }
+
+    bool journal_reader::add_reason(const reason_header &header, const std::byte *text)
+    {
+        // Reasons are a small closed set, interned densely, so the same bound holds with room
+        if (header.id_ >= size_ / (1 + sizeof(reason_header)))
+        {
+            return false;
+        }
+        if (header.id_ >= reasons_.size())
+        {
+            reasons_.resize(header.id_ + 1);
+        }
+        reasons_[header.id_].assign(reinterpret_cast<const char *>(text), header.length_);
+        return true;
+    }
+
+    size_t journal_reader::read_record(size_t pos) noexcept
+    {
+        const auto limit = end_ != 0 ? end_ : size_;
+        const auto kind = static_cast<uint8_t>(data_[pos]);
+        if (const auto size = payload_record_size(kind); size != 0)
+        {
+            if (pos + size > limit)
+            {
+                return limit;
+            }
+            const auto seq = load<uint32_t>(data_ + pos + 1);
+            if (kind == tick_payload_record)
+            {
+                std::memcpy(&tick_, data_ + pos + 1 + sizeof(seq), sizeof(tick_));
+                tick_seq_ = seq;
+            }
+            else
+            {
+                std::memcpy(&order_, data_ + pos + 1 + sizeof(seq), sizeof(order_));
+                order_seq_ = seq;
+            }
+            return pos + size;
+        }
+
+        // Definitions were all loaded up front
+        if (kind == symbol_record && pos + 1 + sizeof(symbol_header) <= limit)
+        {
+            const auto next = pos + 1 + sizeof(symbol_header) + load<symbol_header>(data_ + pos + 1).length_;
+            return next <= limit ? next : limit;
+        }
+        if (kind == reason_record && pos + 1 + sizeof(reason_header) <= limit)
+        {
+            const auto next = pos + 1 + sizeof(reason_header) + load<reason_header>(data_ + pos + 1).length_;
+            return next <= limit ? next : limit;
+        }
+        return limit;
+    }
+
+    void journal_reader::unmap() noexcept
+    {
+        if (data_)
+        {
+            ::munmap(const_cast<std::byte *>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace engine::journal
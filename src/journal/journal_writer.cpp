@@ -0,0 +1,212 @@
+#include "journal/journal_writer.hpp"
+#include "errors/error_code.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace engine::journal
+{
+    journal_writer::journal_writer(const std::filesystem::path &path, const writer_config &config)
+        : ring_(config.ring_capacity),
+          file_(std::fopen(path.c_str(), "wb")),
+          file_buffer_(config.file_buffer),
+          index_stride_(config.index_stride == 0 ? 1 : config.index_stride)
+    {
+        if (!file_)
+        {
+            errors::raise<std::runtime_error>("Unable to open journal: " + path.string());
+        }
+        std::setvbuf(file_, file_buffer_.data(), _IOFBF, file_buffer_.size());
+
+        const file_header header{};
+        write(&header, sizeof(header));
+
+        thread_ = std::jthread([this](std::stop_token stop)
+                               { run(std::move(stop)); });
+    }
+
+    journal_writer::~journal_writer()
+    {
+        close();
+    }
+
+    void journal_writer::define_symbol(symbols::symbol_id id, std::string_view name)
+    {
+        std::lock_guard lock{pending_mutex_};
+        pending_.push_back({id, std::string{name}});
+    }
+
+    void journal_writer::define_reason(uint32_t id, std::string_view text)
+    {
+        if (id < reasons_defined_.size() && reasons_defined_[id])
+        {
+            return;
+        }
+        if (id >= reasons_defined_.size())
+        {
+            reasons_defined_.resize(id + 1, false);
+        }
+        reasons_defined_[id] = true;
+
+        std::lock_guard lock{pending_mutex_};
+        pending_reasons_.push_back({id, std::string{text}});
+    }
+
+    void journal_writer::close()
+    {
+        if (!thread_.joinable())
+        {
+            return;
+        }
+        thread_.request_stop();
+        thread_.join();
+
+        write_index();
+        if (std::fclose(file_) != 0)
+        {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+        file_ = nullptr;
+    }
+
+    void journal_writer::run(std::stop_token stop)
+    {
+        std::array<entry, 256> batch;
+        for (;;)
+        {
+            size_t n = 0;
+            while (n < batch.size() && ring_.try_pop(batch[n]))
+            {
+                ++n;
+            }
+
+            if (n == 0)
+            {
+                // Appends happen before the stop request, so an empty ring after it is final
+                if (stop.stop_requested() && ring_.empty())
+                {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Symbols and reasons are defined before their first event is pushed, so anything
+            // popped above only needs definitions visible by now
+            write_pending_definitions();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (batch[i].kind_ < event_kinds)
+                {
+                    write_event(batch[i].event_);
+                }
+                else
+                {
+                    write_payload(batch[i]);
+                }
+            }
+        }
+        write_pending_definitions();
+    }
+
+    void journal_writer::write_pending_definitions()
+    {
+        std::vector<name_def> pending;
+        std::vector<name_def> pending_reasons;
+        {
+            std::lock_guard lock{pending_mutex_};
+            pending.swap(pending_);
+            pending_reasons.swap(pending_reasons_);
+        }
+
+        for (auto &def : pending)
+        {
+            const symbol_header header{def.id_, static_cast<uint32_t>(def.name_.size())};
+            write(&symbol_record, 1);
+            write(&header, sizeof(header));
+            write(def.name_.data(), def.name_.size());
+            symbols_.push_back(std::move(def));
+        }
+        for (auto &def : pending_reasons)
+        {
+            const reason_header header{def.id_, static_cast<uint32_t>(def.name_.size())};
+            write(&reason_record, 1);
+            write(&header, sizeof(header));
+            write(def.name_.data(), def.name_.size());
+            reasons_.push_back(std::move(def));
+        }
+    }
+
+    void journal_writer::write_event(const events::event &ev)
+    {
+        // Index every stride-th timed record so a seek lands at most a stride early, on the
+        // payloads ahead of it if it has any
+        if (events_ % index_stride_ == 0 || index_.empty())
+        {
+            if (auto t = event_time_ns(ev))
+            {
+                index_.push_back({*t, payloads_open_ ? payloads_at_ : offset_});
+            }
+        }
+        ++events_;
+        payloads_open_ = false;
+
+        const auto kind = static_cast<uint8_t>(ev.index());
+        write(&kind, 1);
+        std::visit([&](const auto &e)
+                   { write(&e, sizeof(e)); }, ev);
+    }
+
+    void journal_writer::write_payload(const entry &e)
+    {
+        if (!payloads_open_)
+        {
+            payloads_at_ = offset_;
+            payloads_open_ = true;
+        }
+        write(&e.kind_, 1);
+        write(&e.seq_, sizeof(e.seq_));
+        std::visit([&](const auto &p)
+                   { write(&p, sizeof(p)); }, e.event_);
+    }
+
+    void journal_writer::write_index()
+    {
+        const file_footer footer{offset_};
+
+        write(&index_record, 1);
+        const auto symbol_count = static_cast<uint32_t>(symbols_.size());
+        write(&symbol_count, sizeof(symbol_count));
+        for (const auto &def : symbols_)
+        {
+            const symbol_header header{def.id_, static_cast<uint32_t>(def.name_.size())};
+            write(&header, sizeof(header));
+            write(def.name_.data(), def.name_.size());
+        }
+
+        const auto reason_count = static_cast<uint32_t>(reasons_.size());
+        write(&reason_count, sizeof(reason_count));
+        for (const auto &def : reasons_)
+        {
+            const reason_header header{def.id_, static_cast<uint32_t>(def.name_.size())};
+            write(&header, sizeof(header));
+            write(def.name_.data(), def.name_.size());
+        }
+
+        const auto index_count = static_cast<uint32_t>(index_.size());
+        write(&index_count, sizeof(index_count));
+        write(index_.data(), index_.size() * sizeof(index_entry));
+
+        write(&footer, sizeof(footer));
+    }
+
+    void journal_writer::write(const void *data, size_t size)
+    {
+        if (size != 0 && std::fwrite(data, 1, size, file_) != size)
+        {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+        offset_ += size;
+    }
+
+} // namespace engine::journal
@@ -0,0 +1,33 @@
+#include "metrics/cycle_clock.hpp"
+
+#include <thread>
+
+namespace engine::metrics
+{
+    namespace
+    {
+        /// @brief Measure cycles against steady_clock over a short window.
+        double measure() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            using namespace std::chrono;
+            const auto wall_start = steady_clock::now();
+            const auto cycles_start = cycle_clock::now();
+            std::this_thread::sleep_for(milliseconds{10});
+            const auto cycles = cycle_clock::now() - cycles_start;
+            const auto wall = duration_cast<nanoseconds>(steady_clock::now() - wall_start).count();
+            return cycles == 0 ? 1.0 : static_cast<double>(wall) / static_cast<double>(cycles);
+#else
+            return 1.0;
+#endif
+        }
+    } // namespace
+
+    double cycle_clock::ns_per_cycle() noexcept
+    {
+        // Thread safe one time initialisation
+        static const double ratio = measure();
+        return ratio;
+    }
+
+} // namespace engine::metrics
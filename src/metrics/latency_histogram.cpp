@@ -0,0 +1,45 @@
+#include "metrics/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::metrics
+{
+    uint64_t histogram_snapshot::percentile(double q) const noexcept
+    {
+        if (total_ == 0)
+        {
+            return 0;
+        }
+
+        // Rank of the quantile, at least the first value
+        q = std::clamp(q, 0.0, 1.0);
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total_))));
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts_.size(); ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+            {
+                return std::min(latency_histogram::upper_bound(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    histogram_snapshot latency_histogram::snapshot() const
+    {
+        std::vector<uint64_t> counts(bucket_count);
+        uint64_t total = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        // Total from the buckets themselves so percentiles stay consistent with the counts
+        return {std::move(counts), total, sum_.load(std::memory_order_relaxed), max_.load(std::memory_order_relaxed)};
+    }
+
+} // namespace engine::metrics
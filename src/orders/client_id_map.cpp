@@ -0,0 +1,43 @@
+#include "orders/client_id_map.hpp"
+
+namespace engine::orders
+{
+    bool client_id_map::bind(std::string_view client_id, events::order_id id)
+    {
+        const auto h = by_client_.hash(client_id);
+        if (by_id_.contains(id) || by_client_.find(client_id, h) != nullptr)
+        {
+            return false;
+        }
+        by_client_.try_emplace(client_id, id);
+        by_id_.try_emplace(id, client_id);
+        return true;
+    }
+
+    events::order_id client_id_map::find(std::string_view client_id) const noexcept
+    {
+        return find(client_id, by_client_.hash(client_id));
+    }
+
+    events::order_id client_id_map::find(std::string_view client_id, size_t hash) const noexcept
+    {
+        const auto *id = by_client_.find(client_id, hash);
+        return id ? *id : events::invalid_order_id;
+    }
+
+    std::string_view client_id_map::client(events::order_id id) const noexcept
+    {
+        const auto *client_id = by_id_.find(id);
+        return client_id ? std::string_view{*client_id} : std::string_view{};
+    }
+
+    void client_id_map::erase(events::order_id id) noexcept
+    {
+        if (const auto *client_id = by_id_.find(id))
+        {
+            by_client_.erase(std::string_view{*client_id});
+            by_id_.erase(id);
+        }
+    }
+
+} // namespace engine::orders
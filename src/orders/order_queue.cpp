@@ -1,82 +1,240 @@
 #include "orders/order_queue.hpp"
 
-
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
 
 namespace engine::orders
 {
+    namespace
+    {
+        /// @brief Snapshot record of a resting order.
+        struct saved_order
+        {
+            events::order_event order_; ///< Client order.
+            int64_t filled_qty_;        ///< Cumulative filled.
+            double avg_fill_price_;     ///< Weighted average fill price.
+        };
+
+        /// @brief Save one side of the book in order.
+        void save_side(checkpoint::snapshot_writer &out, const price_level_book &book, bool is_buy)
+        {
+            const auto count = is_buy ? book.bid_count() : book.ask_count();
+            out.reserve(sizeof(uint64_t) + count * sizeof(saved_order));
+            out.put(static_cast<uint64_t>(count));
+            book.for_each(is_buy, [&out](const order_state &st)
+                          {
+                out.put(saved_order{st.order_, st.filled_qty_, st.avg_fill_price_});
+                return true; });
+        }
 
-    void order_queue::emplace(order_state &&state)
+        [[noreturn]] void corrupt()
+        {
+            errors::raise<std::runtime_error>("Corrupt snapshot, order book");
+        }
+    } // namespace
+
+    order_queue::order_queue(size_t ledger_depth) : ledger_depth_(ledger_depth)
     {
-        auto &order = state.order_;
-        if (order.is_buy_)
+        if (ledger_depth > ledger_capacity)
         {
-            // Delete from index if exists, defensive
-            if (auto it = bid_index_.find(order.order_id_); it != bid_index_.end())
-            {
-                bids_.erase(it->second);
-                bid_index_.erase(it);
-            }
-            // Add back into index and set
-            auto iter = bids_.insert(std::move(state));
-            bid_index_[order.order_id_] = iter;
+            errors::raise<std::invalid_argument>("ledger depth exceeds order_queue::ledger_capacity");
         }
-        else
+    }
+
+    price_level_book &order_queue::book_at(size_t slot)
+    {
+        if (slot >= books_.size())
         {
-            // Delete from index if exists, defensive
-            if (auto it = asks_index_.find(order.order_id_); it != asks_index_.end())
-            {
-                asks_.erase(it->second);
-                asks_index_.erase(it);
-            }
-            // Add back into index and set
-            auto iter = asks_.insert(std::move(state));
-            asks_index_[order.order_id_] = iter;
+            books_.resize(slot + 1);
+        }
+        if (!books_[slot])
+        {
+            books_[slot] = std::make_unique<price_level_book>(*pool_);
         }
+        return *books_[slot];
     }
 
-    order_state *order_queue::get(const std::string &id) noexcept
+    void order_queue::set_tick_size(symbols::symbol_id symbol, double tick_size)
     {
-        // Get from index.
-        if (auto it = bid_index_.find(id); it != bid_index_.end())
+        const tick_scale scale{tick_size};
+        auto &b = book_at(slot_of(symbol));
+        if (!b.empty())
         {
-            return const_cast<order_state *>(&*it->second);
+            errors::raise<std::logic_error>("tick size set on a book holding orders");
         }
-        if (auto it = asks_index_.find(id); it != asks_index_.end())
+        b = price_level_book{*pool_, scale};
+    }
+
+    order_state &order_queue::emplace(order_state &&state)
+    {
+        const auto id = state.order_.order_id_;
+        const auto h = index_.hash(id);
+        if (const auto *at = index_.find(id, h))
+        {
+            // Replace an order already resting, defensive
+            books_[at->slot_]->erase(at->handle_);
+            index_.erase(id, h);
+        }
+        const auto slot = slot_of(state.order_.symbol_);
+        auto &book = book_at(slot);
+        const auto handle = book.insert(std::move(state));
+        index_.try_emplace(id, location{static_cast<uint32_t>(slot), handle});
+        return book.at(handle);
+    }
+
+    order_state *order_queue::get(events::order_id id) noexcept
+    {
+        // Get from index.
+        if (const auto *at = index_.find(id))
         {
-            return const_cast<order_state *>(&*it->second);
+            return &books_[at->slot_]->at(at->handle_);
         }
         // Couldn't be found
         return nullptr;
     }
 
-    const order_state *order_queue::get(const std::string &id) const noexcept
+    const order_state *order_queue::get(events::order_id id) const noexcept
     {
-        if (auto it = bid_index_.find(id); it != bid_index_.end())
+        if (const auto *at = index_.find(id))
         {
-            return &*it->second;
+            return &books_[at->slot_]->at(at->handle_);
         }
-        if (auto it = asks_index_.find(id); it != asks_index_.end())
+        return nullptr;
+    }
+
+    errors::errc order_queue::inactive(events::order_id id) noexcept
+    {
+        // Erase from both index and book, copying the final state into the ledger first so the
+        // slot goes straight back to the pool and the next insert reuses it while it is warm
+        const auto h = index_.hash(id);
+        if (const auto *at = index_.find(id, h))
         {
-            return &*it->second;
+            auto &book = *books_[at->slot_];
+            const auto order = at->handle_;
+            index_.erase(id, h);
+            if (ledger_depth_ != 0)
+            {
+                retire(book.at(order));
+            }
+            book.erase(order);
+            return errors::errc::ok;
         }
-        return nullptr;
+        return errors::errc::unknown_order;
     }
 
-    void order_queue::inactive(const std::string &id) noexcept
+    void order_queue::retire(const order_state &state) noexcept
     {
-        // Erase from both index and set
-        if (auto it = bid_index_.find(id); it != bid_index_.end())
+        uint32_t at = 0;
+        if (ledger_.size() < ledger_depth_)
         {
-            historical_ledger_.emplace(*it->second);
-            bids_.erase(it->second);
-            bid_index_.erase(it);
-            return;
+            // Capacity is reserved on first use, so the ring never reallocates after
+            if (ledger_.capacity() < ledger_depth_)
+            {
+                ledger_.reserve(ledger_depth_);
+            }
+            at = static_cast<uint32_t>(ledger_.size());
+            ledger_.push_back(state);
+        }
+        else
+        {
+            // Overwrite the oldest, unindexing it first
+            at = static_cast<uint32_t>(ledger_head_);
+            auto &oldest = ledger_[at];
+            retired_.erase(oldest.order_.order_id_, at);
+            std::destroy_at(&oldest);
+            std::construct_at(&oldest, state);
+            ledger_head_ = (ledger_head_ + 1) % ledger_depth_;
+        }
+        retired_.assign(state.order_.order_id_, at, ledger_id());
+    }
+
+    const order_state *order_queue::retired(events::order_id id) const noexcept
+    {
+        // A resting order is not retired, its old state stays in the ledger until it ages out
+        if (index_.find(id))
+        {
+            return nullptr;
+        }
+        const auto at = retired_.find(id, ledger_id());
+        return at != decltype(retired_)::npos ? &ledger_[at] : nullptr;
+    }
+
+    void order_queue::save(checkpoint::snapshot_writer &out) const
+    {
+        out.section(checkpoint::tag("ORDQ"));
+        // Every slot is saved in slot order, so the slot count read back is bounded by the
+        // snapshot's size. A slot without a book saves a zero tick size, empty books still carry
+        // theirs
+        out.put(static_cast<uint64_t>(books_.size()));
+        for (const auto &b : books_)
+        {
+            if (!b)
+            {
+                out.put(0.0);
+                continue;
+            }
+            out.put(b->scale().tick_size());
+            save_side(out, *b, true);
+            save_side(out, *b, false);
+        }
+
+        // Then the ledger, oldest first so restoring it in order rebuilds the same ring
+        out.put(static_cast<uint64_t>(ledger_.size()));
+        for_each_retired([&out](const order_state &st)
+                         { out.put(saved_order{st.order_, st.filled_qty_, st.avg_fill_price_}); });
+    }
+
+    void order_queue::restore_side(checkpoint::snapshot_reader &in, price_level_book &book, uint32_t slot, bool is_buy)
+    {
+        const auto count = in.get_count(sizeof(saved_order));
+        index_.reserve(index_.size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            saved_order rec{};
+            in.get(rec);
+            if (slot_of(rec.order_.symbol_) != slot || rec.order_.is_buy_ != is_buy || index_.contains(rec.order_.order_id_))
+            {
+                corrupt();
+            }
+            index_.try_emplace(rec.order_.order_id_, location{slot, book.insert(order_state{rec.order_, rec.filled_qty_, rec.avg_fill_price_})});
+        }
+    }
+
+    void order_queue::restore(checkpoint::snapshot_reader &in)
+    {
+        in.section(checkpoint::tag("ORDQ"));
+        // Rebuilt aside and moved in, so a corrupt snapshot leaves this queue as it was
+        order_queue fresh{ledger_depth_};
+        const auto slots = in.get_count(sizeof(double));
+        fresh.books_.resize(slots);
+        for (size_t slot = 0; slot < slots; ++slot)
+        {
+            const auto tick_size = in.get<double>();
+            if (tick_size == 0.0)
+            {
+                continue;
+            }
+            if (!(tick_size > 0.0) || !std::isfinite(tick_size))
+            {
+                corrupt();
+            }
+            auto &book = *(fresh.books_[slot] = std::make_unique<price_level_book>(*fresh.pool_, tick_scale{tick_size}));
+            fresh.restore_side(in, book, static_cast<uint32_t>(slot), true);
+            fresh.restore_side(in, book, static_cast<uint32_t>(slot), false);
         }
-        if (auto it = asks_index_.find(id); it != asks_index_.end())
+
+        const auto retired = in.get_count(sizeof(saved_order));
+        for (size_t i = 0; i < retired; ++i)
         {
-            historical_ledger_.emplace(*it->second);
-            asks_.erase(it->second);
-            asks_index_.erase(it);
+            saved_order rec{};
+            in.get(rec);
+            if (fresh.ledger_depth_ != 0)
+            {
+                fresh.retire(order_state{rec.order_, rec.filled_qty_, rec.avg_fill_price_});
+            }
         }
+        *this = std::move(fresh);
     }
-} // namespace engine::orders
\ No newline at end of file
+} // namespace engine::orders
@@ -0,0 +1,143 @@
+#include "orders/price_level_book.hpp"
+
+#include <algorithm>
+
+namespace engine::orders
+{
+    price_level_book::handle price_level_book::link(handle h)
+    {
+        auto &node = pool_->node(h);
+        const bool is_buy = node.state_.order_.is_buy_;
+        const auto ts = node.state_.order_.timestamp_;
+
+        const auto level = find_or_add_level(is_buy, scale_.to_ticks(node.state_.order_.price_));
+        auto &lvl = levels_[level];
+        node.level_ = level;
+
+        // Orders usually arrive in time order, so the walk back from the tail stops at once
+        handle after = lvl.tail_;
+        while (after != npos && pool_->at(after).order_.timestamp_ > ts)
+        {
+            after = pool_->node(after).prev_;
+        }
+        node.prev_ = after;
+        node.next_ = after != npos ? pool_->node(after).next_ : lvl.head_;
+        (node.prev_ != npos ? pool_->node(node.prev_).next_ : lvl.head_) = h;
+        (node.next_ != npos ? pool_->node(node.next_).prev_ : lvl.tail_) = h;
+
+        ++(is_buy ? bid_count_ : ask_count_);
+        return h;
+    }
+
+    void price_level_book::unlink(handle h) noexcept
+    {
+        auto &node = pool_->node(h);
+        auto &lvl = levels_[node.level_];
+        (node.prev_ != npos ? pool_->node(node.prev_).next_ : lvl.head_) = node.next_;
+        (node.next_ != npos ? pool_->node(node.next_).prev_ : lvl.tail_) = node.prev_;
+
+        const bool is_buy = node.state_.order_.is_buy_;
+        if (lvl.head_ == npos)
+        {
+            drop_level(is_buy, node.level_);
+        }
+        --(is_buy ? bid_count_ : ask_count_);
+    }
+
+    void price_level_book::clear() noexcept
+    {
+        // Release every resting order, then thread every level onto the free list
+        for (const auto &ladder : {&bid_ladder_, &ask_ladder_})
+        {
+            for (const auto &step : *ladder)
+            {
+                for (auto h = levels_[step.level_].head_; h != npos;)
+                {
+                    const auto next = pool_->node(h).next_;
+                    pool_->release(h);
+                    h = next;
+                }
+            }
+        }
+        free_level_ = npos;
+        for (size_t i = levels_.size(); i-- > 0;)
+        {
+            levels_[i].head_ = free_level_;
+            free_level_ = static_cast<uint32_t>(i);
+        }
+        bid_ladder_.clear();
+        ask_ladder_.clear();
+        bid_levels_.clear();
+        ask_levels_.clear();
+        bid_count_ = 0;
+        ask_count_ = 0;
+    }
+
+    uint32_t price_level_book::find_or_add_level(bool is_buy, price_ticks ticks)
+    {
+        auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+
+        // Fast path, most activity is at the top of the book
+        if (!ladder.empty() && ladder.back().ticks_ == ticks)
+        {
+            return ladder.back().level_;
+        }
+
+        auto [slot, added] = (is_buy ? bid_levels_ : ask_levels_).try_emplace(ticks, free_level_);
+        if (!added)
+        {
+            return *slot;
+        }
+
+        uint32_t level = free_level_;
+        if (level != npos)
+        {
+            free_level_ = levels_[level].head_;
+        }
+        else
+        {
+            level = static_cast<uint32_t>(levels_.size());
+            levels_.emplace_back();
+        }
+        *slot = level;
+        levels_[level] = price_level{npos, npos, ticks};
+
+        auto pos = std::lower_bound(ladder.begin(), ladder.end(), ticks, [is_buy](const rung &r, price_ticks t)
+                                    { return is_buy ? r.ticks_ < t : r.ticks_ > t; });
+        ladder.insert(pos, rung{ticks, level});
+        return level;
+    }
+
+    size_t price_level_book::rung_at(bool is_buy, size_t at, price_ticks ticks) const noexcept
+    {
+        const auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+        if (at < ladder.size() && ladder[at].ticks_ == ticks)
+        {
+            // Nothing worse was dropped, the common case
+            return at;
+        }
+        auto pos = std::lower_bound(ladder.begin(), ladder.end(), ticks, [is_buy](const rung &r, price_ticks t)
+                                    { return is_buy ? r.ticks_ < t : r.ticks_ > t; });
+        return static_cast<size_t>(pos - ladder.begin());
+    }
+
+    void price_level_book::drop_level(bool is_buy, uint32_t level) noexcept
+    {
+        auto &ladder = is_buy ? bid_ladder_ : ask_ladder_;
+        const auto ticks = levels_[level].ticks_;
+        if (ladder.back().level_ == level)
+        {
+            ladder.pop_back();
+        }
+        else
+        {
+            auto pos = std::lower_bound(ladder.begin(), ladder.end(), ticks, [is_buy](const rung &r, price_ticks t)
+                                        { return is_buy ? r.ticks_ < t : r.ticks_ > t; });
+            ladder.erase(pos);
+        }
+        (is_buy ? bid_levels_ : ask_levels_).erase(ticks);
+        levels_[level].head_ = free_level_;
+        free_level_ = level;
+    }
+
+} // namespace engine::orders
@@ -10,8 +10,15 @@ namespace engine::portfolio
 
     void portfolio_manager::on_fill(const engine::events::fill_event &fill) noexcept
     {
+        // A fill with no instrument has no position to apply to
+        auto *s = slot(fill.symbol_);
+        if (!s) [[unlikely]]
+        {
+            return;
+        }
+
         // Get new quantity
-        auto &pos = positions_[fill.symbol_];
+        auto &pos = s->position;
         int64_t signed_qty = fill.is_buy_ ? fill.filled_qty_ : -fill.filled_qty_;
 
         // Commission
@@ -65,31 +72,36 @@ namespace engine::portfolio
         trade_log_.push_back(fill);
     }
 
-    void portfolio_manager::on_market(const std::string &symbol, double price, double qty) noexcept
+    void portfolio_manager::on_market(symbols::symbol_id symbol, double price, double qty) noexcept
     {
         // Track market price
-        market_prices_[symbol] = price;
-        market_quantities[symbol] = qty;
+        auto *s = slot(symbol);
+        if (!s) [[unlikely]]
+        {
+            return;
+        }
+        s->market_price = price;
+        s->market_qty = qty;
+        s->has_market = true;
     }
 
     void portfolio_manager::on_cancel(const engine::events::cancel_event &cancel) noexcept
     {
         // Track cancelled orders
         cancel_count_++;
-        cancelled_order_ids_.push_back(cancel.originating_order_.order_id_);
+        cancelled_order_ids_.push_back(cancel.order_id_);
     }
 
     double portfolio_manager::unrealized_pnl() const noexcept
     {
         double total = 0.0;
-        for (const auto &[symbol, pos] : positions_)
+        for (const auto &s : symbols_)
         {
             // Update total pnl from market prices
-            auto it = market_prices_.find(symbol);
-            if (it != market_prices_.end())
+            if (s.has_market)
             {
-                double mkt_price = it->second;
-                total += static_cast<double>(pos.quantity) * (mkt_price - pos.avg_price);
+                const auto &pos = s.position;
+                total += static_cast<double>(pos.quantity) * (s.market_price - pos.avg_price);
             }
         }
         return total;
@@ -103,12 +115,11 @@ namespace engine::portfolio
     double portfolio_manager::total_equity() const noexcept
     {
         double value = cash_;
-        for (const auto &[symbol, pos] : positions_)
+        for (const auto &s : symbols_)
         {
-            auto it = market_prices_.find(symbol);
-            if (it != market_prices_.end())
+            if (s.has_market)
             {
-                value += static_cast<double>(pos.quantity) * it->second;
+                value += static_cast<double>(s.position.quantity) * s.market_price;
             }
         }
         return value;
@@ -119,11 +130,11 @@ namespace engine::portfolio
         return cash_;
     }
 
-    const position_state &portfolio_manager::position(const std::string &symbol) const noexcept
+    const position_state &portfolio_manager::position(symbols::symbol_id symbol) const noexcept
     {
         static position_state empty{};
-        auto it = positions_.find(symbol);
-        return it != positions_.end() ? it->second : empty;
+        auto s = find_slot(symbol);
+        return s ? s->position : empty;
     }
 
     const std::vector<engine::events::fill_event> &portfolio_manager::trade_log() const noexcept
@@ -131,16 +142,60 @@ namespace engine::portfolio
         return trade_log_;
     }
 
-    double portfolio_manager::last_price(const std::string &symbol) const noexcept
+    double portfolio_manager::last_price(symbols::symbol_id symbol) const noexcept
+    {
+        auto s = find_slot(symbol);
+        return s ? s->market_price : 0.0;
+    }
+
+    double portfolio_manager::last_quantity(symbols::symbol_id symbol) const noexcept
+    {
+        auto s = find_slot(symbol);
+        return s ? s->market_qty : 0.0;
+    }
+
+    portfolio_manager::symbol_slot *portfolio_manager::slot(symbols::symbol_id symbol)
+    {
+        // Not an ID, growing to it would ask for 2^32 slots
+        if (symbol == symbols::invalid_symbol)
+        {
+            return nullptr;
+        }
+        // IDs are dense, so growth happens once per new symbol
+        if (symbol >= symbols_.size())
+        {
+            symbols_.resize(static_cast<size_t>(symbol) + 1);
+        }
+        return &symbols_[symbol];
+    }
+
+    const portfolio_manager::symbol_slot *portfolio_manager::find_slot(symbols::symbol_id symbol) const noexcept
+    {
+        return symbol < symbols_.size() ? &symbols_[symbol] : nullptr;
+    }
+
+    void portfolio_manager::save(checkpoint::snapshot_writer &out) const
     {
-        auto it = market_prices_.find(symbol);
-        return (it != market_prices_.end()) ? it->second : 0.0;
+        out.section(checkpoint::tag("PORT"));
+        out.put(cash_);
+        out.put(realized_pnl_);
+        out.put(commission_rate_);
+        out.put(static_cast<uint64_t>(cancel_count_));
+        out.put_span(std::span{symbols_});
+        out.put_span(std::span{trade_log_});
+        out.put_span(std::span{cancelled_order_ids_});
     }
 
-    double portfolio_manager::last_quantity(const std::string &symbol) const noexcept
+    void portfolio_manager::restore(checkpoint::snapshot_reader &in)
     {
-        auto it = market_quantities.find(symbol);
-        return (it != market_quantities.end()) ? it->second : 0.0;
+        in.section(checkpoint::tag("PORT"));
+        in.get(cash_);
+        in.get(realized_pnl_);
+        in.get(commission_rate_);
+        cancel_count_ = in.get_count();
+        in.get_vector(symbols_);
+        in.get_vector(trade_log_);
+        in.get_vector(cancelled_order_ids_);
     }
 
 } // namespace engine::portfolio
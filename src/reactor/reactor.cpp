@@ -0,0 +1,357 @@
+#include "reactor/reactor.hpp"
+#include "errors/error_code.hpp"
+
+#include <array>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace engine::reactor
+{
+    namespace
+    {
+        constexpr size_t no_index = std::numeric_limits<size_t>::max();
+
+        /// @brief Add or re-arm a descriptor for one readiness event.
+        bool watch(int epoll_fd, int fd, bool registered) noexcept
+        {
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.fd = fd;
+            if (::epoll_ctl(epoll_fd, registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev) == 0)
+            {
+                return true;
+            }
+            // Closing a descriptor drops it from epoll, so a reused number is new to it
+            return registered && errno == ENOENT && ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
+        }
+
+        /// @brief Close the descriptors that were opened.
+        void close_all(int epoll_fd, int timer_fd, int wake_fd) noexcept
+        {
+            for (int fd : {epoll_fd, timer_fd, wake_fd})
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            }
+        }
+    } // namespace
+
+    void task::final_awaiter::await_suspend(handle_type h) noexcept
+    {
+        // Frame stays alive until the reactor destroys it
+        if (auto *owner = h.promise().owner_)
+        {
+            owner->finished(h);
+        }
+    }
+
+    reactor::reactor()
+        : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)),
+          timer_fd_(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+          wake_fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (epoll_fd_ < 0 || timer_fd_ < 0 || wake_fd_ < 0)
+        {
+            close_all(epoll_fd_, timer_fd_, wake_fd_);
+            errors::raise<std::runtime_error>("Unable to create reactor");
+        }
+
+        // Internal descriptors stay armed, level triggered
+        for (int fd : {timer_fd_, wake_fd_})
+        {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+        }
+    }
+
+    reactor::~reactor()
+    {
+        for (auto h : tasks_)
+        {
+            h.destroy();
+        }
+        close_all(epoll_fd_, timer_fd_, wake_fd_);
+    }
+
+    void reactor::spawn(task t)
+    {
+        auto h = t.release();
+        h.promise().owner_ = this;
+        tasks_.push_back(h);
+        ready_.push_back(h);
+        ++live_;
+    }
+
+    void reactor::run()
+    {
+        while (live_ > 0 && !stop_.load(std::memory_order_relaxed))
+        {
+            // Resume a snapshot, coroutines may queue more while running
+            std::swap(ready_, running_);
+            for (auto h : running_)
+            {
+                h.resume();
+            }
+            running_.clear();
+
+            if (live_ == 0 || stop_.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            // Block only when nothing is runnable, yielded coroutines still let descriptors in
+            poll_events(ready_.empty() ? -1 : 0);
+        }
+
+        stop_.store(false, std::memory_order_relaxed);
+
+        // Reclaim finished frames
+        std::erase_if(tasks_, [](task::handle_type h)
+                      {
+            if (!h.done())
+                return false;
+            h.destroy();
+            return true; });
+
+        if (error_)
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+    void reactor::stop() noexcept
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        const uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    bool reactor::cancel(int fd) noexcept
+    {
+        if (fd < 0 || static_cast<size_t>(fd) >= io_.size() || !io_[static_cast<size_t>(fd)])
+        {
+            return false;
+        }
+        fire(*io_[static_cast<size_t>(fd)], wait_result::cancelled);
+        return true;
+    }
+
+    void reactor::arm(waiter &w, std::coroutine_handle<> h)
+    {
+        w.handle_ = h;
+        if (w.fd_ >= 0)
+        {
+            const auto fd = static_cast<size_t>(w.fd_);
+            if (fd >= io_.size())
+            {
+                io_.resize(fd + 1, nullptr);
+                registered_.resize(fd + 1, false);
+            }
+            if (io_[fd])
+            {
+                errors::raise<std::logic_error>("descriptor already awaited");
+            }
+            if (!watch(epoll_fd_, w.fd_, registered_[fd]))
+            {
+                errors::raise<std::runtime_error>("Unable to watch descriptor");
+            }
+            registered_[fd] = true;
+            io_[fd] = &w;
+        }
+        if (w.deadline_ != clock::time_point::max())
+        {
+            heap_push(w);
+            if (w.deadline_ < armed_)
+            {
+                rearm_timer();
+            }
+        }
+    }
+
+    void reactor::fire(waiter &w, wait_result result) noexcept
+    {
+        if (w.fd_ >= 0)
+        {
+            // A late one shot event for it finds no waiter and is dropped
+            io_[static_cast<size_t>(w.fd_)] = nullptr;
+        }
+        if (w.heap_index_ != no_index)
+        {
+            heap_erase(w);
+        }
+        w.result_ = result;
+        ready_.push_back(w.handle_);
+    }
+
+    void reactor::finished(task::handle_type h) noexcept
+    {
+        --live_;
+        if (h.promise().error_ && !error_)
+        {
+            error_ = h.promise().error_;
+            stop_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void reactor::poll_events(int timeout_ms)
+    {
+        std::array<epoll_event, 64> events;
+        const int n = ::epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), timeout_ms);
+        for (int i = 0; i < n; ++i)
+        {
+            const int fd = events[static_cast<size_t>(i)].data.fd;
+            if (fd == timer_fd_)
+            {
+                uint64_t expirations;
+                [[maybe_unused]] auto r = ::read(timer_fd_, &expirations, sizeof(expirations));
+                armed_ = clock::time_point::max();
+            }
+            else if (fd == wake_fd_)
+            {
+                uint64_t count;
+                [[maybe_unused]] auto r = ::read(wake_fd_, &count, sizeof(count));
+            }
+            else if (static_cast<size_t>(fd) < io_.size() && io_[static_cast<size_t>(fd)])
+            {
+                fire(*io_[static_cast<size_t>(fd)], wait_result::ready);
+            }
+        }
+        expire_timers();
+    }
+
+    void reactor::expire_timers()
+    {
+        if (timers_.empty())
+        {
+            return;
+        }
+        const auto now = clock::now();
+        while (!timers_.empty() && timers_.front()->deadline_ <= now)
+        {
+            auto &w = *timers_.front();
+            fire(w, w.fd_ >= 0 ? wait_result::timeout : wait_result::ready);
+        }
+        rearm_timer();
+    }
+
+    void reactor::rearm_timer() noexcept
+    {
+        const auto next = timers_.empty() ? clock::time_point::max() : timers_.front()->deadline_;
+        if (next == armed_)
+        {
+            return;
+        }
+        armed_ = next;
+
+        // Zero disarms, so a deadline already passed is clamped to the next nanosecond
+        itimerspec spec{};
+        if (next != clock::time_point::max())
+        {
+            const auto ns = std::max<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count(), 1);
+            spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+            spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+        }
+        ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+    void reactor::heap_push(waiter &w)
+    {
+        w.heap_index_ = timers_.size();
+        timers_.push_back(&w);
+        heap_sift_up(w.heap_index_);
+    }
+
+    void reactor::heap_erase(waiter &w) noexcept
+    {
+        const auto i = w.heap_index_;
+        w.heap_index_ = no_index;
+        auto *last = timers_.back();
+        timers_.pop_back();
+        if (i < timers_.size())
+        {
+            // Move the last entry into the hole and restore order either way
+            timers_[i] = last;
+            last->heap_index_ = i;
+            heap_sift_up(i);
+            heap_sift_down(last->heap_index_);
+        }
+    }
+
+    void reactor::heap_sift_up(size_t i) noexcept
+    {
+        while (i > 0)
+        {
+            const auto parent = (i - 1) / 2;
+            if (timers_[parent]->deadline_ <= timers_[i]->deadline_)
+            {
+                break;
+            }
+            std::swap(timers_[parent], timers_[i]);
+            timers_[parent]->heap_index_ = parent;
+            timers_[i]->heap_index_ = i;
+            i = parent;
+        }
+    }
+
+    void reactor::heap_sift_down(size_t i) noexcept
+    {
+        while (true)
+        {
+            const auto left = 2 * i + 1;
+            const auto right = left + 1;
+            auto smallest = i;
+            if (left < timers_.size() && timers_[left]->deadline_ < timers_[smallest]->deadline_)
+            {
+                smallest = left;
+            }
+            if (right < timers_.size() && timers_[right]->deadline_ < timers_[smallest]->deadline_)
+            {
+                smallest = right;
+            }
+            if (smallest == i)
+            {
+                break;
+            }
+            std::swap(timers_[smallest], timers_[i]);
+            timers_[smallest]->heap_index_ = smallest;
+            timers_[i]->heap_index_ = i;
+            i = smallest;
+        }
+    }
+
+    event_signal::event_signal()
+        : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (fd_ < 0)
+        {
+            errors::raise<std::runtime_error>("Unable to create eventfd");
+        }
+    }
+
+    event_signal::~event_signal()
+    {
+        ::close(fd_);
+    }
+
+    void event_signal::notify() noexcept
+    {
+        const uint64_t one = 1;
+        [[maybe_unused]] auto n = ::write(fd_, &one, sizeof(one));
+    }
+
+    uint64_t event_signal::consume() noexcept
+    {
+        uint64_t count = 0;
+        return ::read(fd_, &count, sizeof(count)) == sizeof(count) ? count : 0;
+    }
+
+} // namespace engine::reactor
@@ -0,0 +1,50 @@
+#include "symbols/symbol_registry.hpp"
+
+namespace engine::symbols
+{
+    symbol_id symbol_registry::intern(std::string_view name)
+    {
+        // Fast path, already interned
+        if (auto it = ids_.find(name); it != ids_.end())
+        {
+            return it->second;
+        }
+
+        // Assign next dense ID
+        auto id = static_cast<symbol_id>(names_.size());
+        names_.emplace_back(name);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    symbol_id symbol_registry::find(std::string_view name) const noexcept
+    {
+        auto it = ids_.find(name);
+        return it != ids_.end() ? it->second : invalid_symbol;
+    }
+
+    void symbol_registry::save(checkpoint::snapshot_writer &out) const
+    {
+        out.section(checkpoint::tag("SYMS"));
+        out.put(static_cast<uint64_t>(names_.size()));
+        for (const auto &name : names_)
+        {
+            out.put_string(name);
+        }
+    }
+
+    void symbol_registry::restore(checkpoint::snapshot_reader &in)
+    {
+        in.section(checkpoint::tag("SYMS"));
+        const auto count = in.get_count(sizeof(uint64_t));
+        names_.clear();
+        ids_.clear();
+        names_.reserve(count);
+        ids_.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            intern(in.get_string());
+        }
+    }
+
+} // namespace engine::symbols
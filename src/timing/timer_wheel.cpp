@@ -0,0 +1,305 @@
+#include "timing/timer_wheel.hpp"
+
+#include "errors/error_code.hpp"
+
+#include <bit>
+#include <span>
+#include <stdexcept>
+
+namespace engine::timing
+{
+    timer_wheel::timer_wheel(std::chrono::nanoseconds resolution)
+    {
+        if (resolution.count() <= 0)
+        {
+            errors::raise<std::invalid_argument>("timer wheel resolution must be positive");
+        }
+        resolution_ = static_cast<uint64_t>(resolution.count());
+    }
+
+    events::timer_id timer_wheel::schedule(uint64_t due_ns, uint64_t tag, uint64_t period_ns)
+    {
+        if (lists_.empty()) [[unlikely]]
+        {
+            lists_.resize(static_cast<size_t>(firing_list) + 1);
+        }
+
+        // Reuse a released node before growing the pool
+        uint32_t index = free_;
+        if (index != nil)
+        {
+            free_ = nodes_[index].next_;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+
+        auto &n = nodes_[index];
+        n.due_ns_ = due_ns;
+        n.due_tick_ = tick_after(due_ns);
+        n.period_ns_ = period_ns;
+        n.tag_ = tag;
+        insert(index);
+        ++count_;
+        return id_of(index);
+    }
+
+    bool timer_wheel::cancel(events::timer_id id) noexcept
+    {
+        const auto slot = static_cast<uint32_t>(id);
+        if (slot == 0 || slot > nodes_.size())
+        {
+            return false;
+        }
+        const uint32_t index = slot - 1;
+        const auto &n = nodes_[index];
+        if (n.list_ == nil || n.generation_ != static_cast<uint32_t>(id >> 32))
+        {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    void timer_wheel::insert(uint32_t index) noexcept
+    {
+        const uint64_t due = nodes_[index].due_tick_;
+
+        // Level of the highest byte the due tick differs from now in, cascades may place a timer
+        // due right now in the level 0 slot about to fire
+        const uint64_t diff = due ^ current_;
+        const size_t level = diff == 0 ? 0 : static_cast<size_t>(63 - std::countl_zero(diff)) / slot_bits;
+        const size_t slot = static_cast<size_t>(due >> (level * slot_bits)) & (slots - 1);
+        occupied_[level][slot / 64] |= uint64_t{1} << (slot % 64);
+        link(index, static_cast<uint32_t>(level * slots + slot));
+    }
+
+    void timer_wheel::link(uint32_t index, uint32_t list) noexcept
+    {
+        auto &n = nodes_[index];
+        auto &l = lists_[list];
+        n.list_ = list;
+        n.prev_ = l.tail_;
+        n.next_ = nil;
+        if (l.tail_ != nil)
+        {
+            nodes_[l.tail_].next_ = index;
+        }
+        else
+        {
+            l.head_ = index;
+        }
+        l.tail_ = index;
+    }
+
+    void timer_wheel::unlink(uint32_t index) noexcept
+    {
+        auto &n = nodes_[index];
+        auto &l = lists_[n.list_];
+        (n.prev_ != nil ? nodes_[n.prev_].next_ : l.head_) = n.next_;
+        (n.next_ != nil ? nodes_[n.next_].prev_ : l.tail_) = n.prev_;
+
+        // Keep the bitmap exact so advance never visits an empty slot
+        if (l.head_ == nil && n.list_ != firing_list)
+        {
+            const size_t slot = n.list_ % slots;
+            occupied_[n.list_ / slots][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+        }
+        n.list_ = nil;
+        n.prev_ = nil;
+        n.next_ = nil;
+    }
+
+    void timer_wheel::release(uint32_t index) noexcept
+    {
+        auto &n = nodes_[index];
+        ++n.generation_;
+        n.next_ = free_;
+        free_ = index;
+        --count_;
+    }
+
+    uint64_t timer_wheel::next_tick() const noexcept
+    {
+        // Every timer on a level is due after every timer below it, so the lowest occupied level
+        // holds the next slot to fire or cascade
+        for (size_t level = 0; level < levels; ++level)
+        {
+            const size_t shift = level * slot_bits;
+            const size_t from = static_cast<size_t>(current_ >> shift) & (slots - 1);
+            for (size_t word = 0; word < occupied_[level].size(); ++word)
+            {
+                uint64_t bits = occupied_[level][word];
+                if (word == from / 64)
+                {
+                    bits &= ~uint64_t{0} << (from % 64);
+                }
+                else if (word < from / 64)
+                {
+                    bits = 0;
+                }
+                if (bits != 0)
+                {
+                    const auto slot = static_cast<uint64_t>(word * 64 + static_cast<size_t>(std::countr_zero(bits)));
+                    const uint64_t above = shift + slot_bits < 64 ? current_ >> (shift + slot_bits) << (shift + slot_bits) : 0;
+                    return above | (slot << shift);
+                }
+            }
+        }
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    void timer_wheel::cascade(uint64_t tick) noexcept
+    {
+        for (size_t level = levels - 1; level > 0; --level)
+        {
+            const size_t shift = level * slot_bits;
+            if ((tick & ((uint64_t{1} << shift) - 1)) != 0)
+            {
+                continue;
+            }
+
+            // Slot starts now, spread its timers over the levels below
+            const size_t slot = static_cast<size_t>(tick >> shift) & (slots - 1);
+            auto &l = lists_[level * slots + slot];
+            uint32_t index = l.head_;
+            l = node_list{};
+            occupied_[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+            while (index != nil)
+            {
+                const uint32_t next = nodes_[index].next_;
+                insert(index);
+                index = next;
+            }
+        }
+    }
+
+    void timer_wheel::take_slot(uint64_t tick) noexcept
+    {
+        const size_t slot = static_cast<size_t>(tick) & (slots - 1);
+        auto &l = lists_[slot];
+        lists_[firing_list] = l;
+        l = node_list{};
+        occupied_[0][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+        for (uint32_t index = lists_[firing_list].head_; index != nil; index = nodes_[index].next_)
+        {
+            nodes_[index].list_ = firing_list;
+        }
+    }
+
+    void timer_wheel::save(checkpoint::snapshot_writer &out) const
+    {
+        out.section(checkpoint::tag("TIMR"));
+        out.put(resolution_);
+        out.put(current_);
+        out.put(static_cast<uint64_t>(count_));
+        out.put(free_);
+        out.put_span(std::span<const node>{nodes_});
+        out.put_span(std::span<const node_list>{lists_});
+        out.put(occupied_);
+    }
+
+    void timer_wheel::restore(checkpoint::snapshot_reader &in)
+    {
+        in.section(checkpoint::tag("TIMR"));
+        // Read into a wheel aside and checked before it replaces this one, a corrupt resolution or
+        // link would otherwise divide by zero or write past the pool on the next schedule or advance
+        const auto resolution = in.get<uint64_t>();
+        if (resolution == 0 || resolution > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        {
+            errors::raise<std::runtime_error>("Corrupt snapshot, timer wheel");
+        }
+        timer_wheel fresh{std::chrono::nanoseconds{static_cast<int64_t>(resolution)}};
+        in.get(fresh.current_);
+        fresh.count_ = static_cast<size_t>(in.get<uint64_t>());
+        in.get(fresh.free_);
+        in.get_vector(fresh.nodes_);
+        in.get_vector(fresh.lists_);
+        in.get(fresh.occupied_);
+        if (!fresh.consistent())
+        {
+            errors::raise<std::runtime_error>("Corrupt snapshot, timer wheel");
+        }
+        *this = std::move(fresh);
+    }
+
+    bool timer_wheel::consistent() const
+    {
+        // Slot lists are allocated on the first schedule, so a wheel without them has no timers
+        if (lists_.empty())
+        {
+            return nodes_.empty() && count_ == 0 && free_ == nil && occupied_ == decltype(occupied_){};
+        }
+        if (lists_.size() != static_cast<size_t>(firing_list) + 1 || nodes_.size() >= nil || count_ > nodes_.size())
+        {
+            return false;
+        }
+
+        // Walk every list, each node once, naming the list it is on and linking back to the one before
+        std::vector<bool> seen(nodes_.size());
+        const auto visit = [&](uint32_t index, uint32_t list)
+        {
+            if (index >= nodes_.size() || seen[index] || nodes_[index].list_ != list)
+            {
+                return false;
+            }
+            seen[index] = true;
+            return true;
+        };
+        size_t linked = 0;
+        for (uint32_t list = 0; list < lists_.size(); ++list)
+        {
+            const auto &l = lists_[list];
+            uint32_t prev = nil;
+            for (uint32_t index = l.head_; index != nil; index = nodes_[index].next_)
+            {
+                if (!visit(index, list) || nodes_[index].prev_ != prev)
+                {
+                    return false;
+                }
+                prev = index;
+                ++linked;
+            }
+            if (l.tail_ != prev)
+            {
+                return false;
+            }
+
+            // Nothing is mid fire between advances, and a slot's bit is set exactly when it has timers
+            const bool listed = l.head_ != nil;
+            if (list == firing_list)
+            {
+                if (listed)
+                {
+                    return false;
+                }
+                continue;
+            }
+            const size_t slot = list % slots;
+            if (((occupied_[list / slots][slot / 64] >> (slot % 64)) & 1) != (listed ? 1u : 0u))
+            {
+                return false;
+            }
+        }
+        if (linked != count_)
+        {
+            return false;
+        }
+
+        // Every other node is on the free list
+        size_t released = 0;
+        for (uint32_t index = free_; index != nil; index = nodes_[index].next_)
+        {
+            if (!visit(index, nil))
+            {
+                return false;
+            }
+            ++released;
+        }
+        return released == nodes_.size() - count_;
+    }
+
+} // namespace engine::timing
@@ -0,0 +1,565 @@
+#include <gtest/gtest.h>
+#include "checkpoint/snapshot.hpp"
+#include "engine_base.hpp"
+#include "execution_engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "orders/order_id_generator.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Hands out one tick per loop iteration so a run can stop on any tick
+    struct OneByOne
+    {
+        ingest::tick_cursor cursor;
+
+        const ingest::tick_view *next_view() noexcept { return cursor.next_view(); }
+        std::string_view symbol_name(symbols::symbol_id id) const noexcept { return cursor.symbol_name(id); }
+        void save(checkpoint::snapshot_writer &out) const { cursor.save(out); }
+        void restore(checkpoint::snapshot_reader &in) { cursor.restore(in); }
+    };
+
+    // Bids every third tick, its counters are saved as the strategy blob
+    struct EveryThird
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            if (++seen % 3 == 0)
+            {
+                q.push(order_event{ev.symbol_, static_cast<order_id>(seen), 10, true, ev.price_, order_type::Limit, order_flags::None});
+            }
+        }
+        void on_fill(const fill_event &) { ++fills; }
+
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            out.put(seen);
+            out.put(fills);
+        }
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.get(seen);
+            in.get(fills);
+        }
+
+        int64_t seen = 0;
+        int64_t fills = 0;
+    };
+
+    // Fills half of every order, leaving the rest resting
+    struct HalfFill : execution_engine_base<HalfFill>
+    {
+        HalfFill() = default;
+
+        void on_order(const order_event &order, event_queue &q)
+        {
+            emit_fill(order, order.quantity_ / 2, order.price_, q);
+        }
+    };
+
+    struct ResumableEngine : engine_base<ResumableEngine, OneByOne, EveryThird, HalfFill, timing::sim_clock>
+    {
+        explicit ResumableEngine(const ingest::tick_buffer &ticks)
+            : engine_base(OneByOne{ticks.cursor()}, EveryThird{}, portfolio::portfolio_manager{100000.0, 0.001}, HalfFill{})
+        {
+            set_latency_model({2ms, 1ms});
+        }
+        bool should_stop() { return strategy().seen >= stop_at; }
+        bool handle_no_event() { return false; }
+
+        int64_t stop_at = std::numeric_limits<int64_t>::max();
+    };
+
+    // Bids every tick with generated IDs, the generator is saved with the strategy
+    struct GeneratedIds
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            ++seen;
+            q.push(order_event{ev.symbol_, ids->next(), 10, true, ev.price_, order_type::Limit, order_flags::None});
+        }
+
+        void save(checkpoint::snapshot_writer &out) const
+        {
+            out.put(seen);
+            ids->save(out);
+        }
+        void restore(checkpoint::snapshot_reader &in)
+        {
+            in.get(seen);
+            ids->restore(in);
+        }
+
+        orders::order_id_generator *ids;
+        int64_t seen = 0;
+    };
+
+    struct GeneratedIdEngine : engine_base<GeneratedIdEngine, OneByOne, GeneratedIds, HalfFill, timing::sim_clock>
+    {
+        GeneratedIdEngine(const ingest::tick_buffer &ticks, orders::order_id_generator &ids)
+            : engine_base(OneByOne{ticks.cursor()}, GeneratedIds{&ids}, portfolio::portfolio_manager{100000.0, 0.001}, HalfFill{})
+        {
+        }
+        bool should_stop() { return strategy().seen >= stop_at; }
+        bool handle_no_event() { return false; }
+
+        int64_t stop_at = std::numeric_limits<int64_t>::max();
+    };
+
+    // Carries a wider custom event, so its event_type differs from the default list's
+    struct wide_event
+    {
+        std::array<double, 16> values_;
+    };
+    using wide_events = extend_events_t<default_events, wide_event>;
+
+    // Same variant size as the default list, but a different type in place of timer_event
+    struct opaque_timer_event
+    {
+        std::array<std::byte, sizeof(timer_event)> bytes_;
+    };
+    using swapped_events = event_list<market_event, signal_event, order_event, fill_event, cancel_event, opaque_timer_event>;
+
+    struct Quiet
+    {
+    };
+
+    struct WideEngine : engine_base<WideEngine, OneByOne, Quiet, Quiet, timing::sim_clock, wide_events>
+    {
+        explicit WideEngine(const ingest::tick_buffer &ticks)
+            : engine_base(OneByOne{ticks.cursor()}, Quiet{}, portfolio::portfolio_manager{100000.0}, Quiet{})
+        {
+        }
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    struct SwappedEngine : engine_base<SwappedEngine, OneByOne, Quiet, Quiet, timing::sim_clock, swapped_events>
+    {
+        explicit SwappedEngine(const ingest::tick_buffer &ticks)
+            : engine_base(OneByOne{ticks.cursor()}, Quiet{}, portfolio::portfolio_manager{100000.0}, Quiet{})
+        {
+        }
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    ingest::tick_buffer make_ticks(size_t count)
+    {
+        ingest::tick_buffer buffer;
+        for (size_t i = 0; i < count; ++i)
+        {
+            buffer.add(i % 2 ? "ETHUSD" : "BTCUSD", 100.0 + static_cast<double>(i % 7), 1.0, static_cast<int64_t>(i), false);
+        }
+        return buffer;
+    }
+
+    order_event order(order_id id, bool is_buy, double price, int64_t ts_ms)
+    {
+        return order_event{0, id, 10, is_buy, price, order_type::Limit, order_flags::None, timing::time_point{std::chrono::milliseconds{ts_ms}}};
+    }
+} // namespace
+
+TEST(CheckpointTest, RejectsForeignTruncatedAndMismatchedSnapshots)
+{
+    std::vector<std::byte> garbage(64, std::byte{0x5a});
+    EXPECT_THROW(checkpoint::snapshot_reader{garbage}, std::runtime_error);
+
+    symbols::symbol_registry registry;
+    registry.intern("BTCUSD");
+    checkpoint::snapshot_writer out;
+    registry.save(out);
+
+    // Restoring into a different component fails on the section tag
+    checkpoint::snapshot_reader mismatched{out.bytes()};
+    portfolio::portfolio_manager portfolio;
+    EXPECT_THROW(portfolio.restore(mismatched), std::runtime_error);
+
+    const auto bytes = out.bytes();
+    checkpoint::snapshot_reader truncated{bytes.first(bytes.size() - 2)};
+    symbols::symbol_registry copy;
+    EXPECT_THROW(copy.restore(truncated), std::runtime_error);
+
+    // A snapshot from another section layout is refused up front
+    std::vector<std::byte> other(bytes.begin(), bytes.end());
+    const uint32_t version = checkpoint::format_version + 1;
+    std::memcpy(other.data() + offsetof(checkpoint::snapshot_header, version_), &version, sizeof(version));
+    EXPECT_THROW(checkpoint::snapshot_reader{other}, std::runtime_error);
+}
+
+TEST(CheckpointTest, RejectsSnapshotFromAnotherEventList)
+{
+    static_assert(sizeof(WideEngine::event_type) != sizeof(ResumableEngine::event_type));
+    const auto ticks = make_ticks(10);
+
+    ResumableEngine first{ticks};
+    first.run();
+    checkpoint::snapshot_writer out;
+    first.save(out);
+
+    // The header records the saving engine's event size and event list fingerprint
+    checkpoint::snapshot_reader header{out.bytes()};
+    EXPECT_NO_THROW(header.check_event_layout(sizeof(ResumableEngine::event_type), default_events::layout_fingerprint));
+    EXPECT_THROW(header.check_event_layout(sizeof(WideEngine::event_type), wide_events::layout_fingerprint), std::runtime_error);
+
+    checkpoint::snapshot_reader same{out.bytes()};
+    ResumableEngine resumed{ticks};
+    EXPECT_NO_THROW(resumed.restore(same));
+
+    checkpoint::snapshot_reader other{out.bytes()};
+    WideEngine wide{ticks};
+    EXPECT_THROW(wide.restore(other), std::runtime_error);
+
+    // A list with the same variant size is still told apart by its fingerprint
+    static_assert(sizeof(SwappedEngine::event_type) == sizeof(ResumableEngine::event_type));
+    checkpoint::snapshot_reader swapped{out.bytes()};
+    SwappedEngine swapped_engine{ticks};
+    EXPECT_THROW(swapped_engine.restore(swapped), std::runtime_error);
+}
+
+TEST(CheckpointTest, WriteFileReplacesWholeSnapshot)
+{
+    const auto path = std::filesystem::temp_directory_path() / "test_checkpoint_replace.qes";
+    auto tmp = path;
+    tmp += ".tmp";
+
+    for (const auto *name : {"BTCUSD", "ETHUSD"})
+    {
+        symbols::symbol_registry registry;
+        registry.intern(name);
+        checkpoint::snapshot_writer out;
+        registry.save(out);
+        out.write_file(path);
+    }
+    EXPECT_FALSE(std::filesystem::exists(tmp));
+
+    checkpoint::snapshot_reader in{path};
+    symbols::symbol_registry restored;
+    restored.restore(in);
+    EXPECT_EQ(restored.name(0), "ETHUSD");
+
+    // A failed write leaves the previous snapshot in place
+    checkpoint::snapshot_writer out;
+    EXPECT_THROW(out.write_file(path / "not_a_directory"), std::runtime_error);
+    EXPECT_TRUE(std::filesystem::exists(path));
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, OrderBookRoundTripKeepsPriorityAndFills)
+{
+    orders::order_queue book;
+    book.emplace(order(1, true, 100.0, 2));
+    book.emplace(order(2, true, 101.0, 3));
+    book.emplace(order(3, true, 100.0, 1));
+    book.emplace(order(4, false, 103.0, 1));
+    book.emplace(order(5, false, 102.0, 2));
+    book.get(3)->filled_qty_ = 4;
+    book.get(3)->avg_fill_price_ = 99.5;
+
+    checkpoint::snapshot_writer out;
+    book.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    orders::order_queue restored;
+    restored.emplace(order(9, true, 1.0, 0));
+    restored.restore(in);
+
+    ASSERT_EQ(restored.size(), 5u);
+    EXPECT_EQ(restored.get(9), nullptr);
+    std::vector<order_id> ids;
+    restored.for_each_pruned([&](const orders::order_state &st)
+                             { ids.push_back(st.order_.order_id_); return true; });
+    EXPECT_EQ(ids, (std::vector<order_id>{2, 3, 1, 5, 4}));
+    EXPECT_EQ(restored.get(3)->filled_qty_, 4);
+    EXPECT_DOUBLE_EQ(restored.get(3)->avg_fill_price_, 99.5);
+
+    // Restored book keeps working
+    restored.inactive(2);
+    EXPECT_EQ(restored.best_bid(0).order_.order_id_, 3u);
+}
+
+TEST(CheckpointTest, OrderLedgerIsSavedAndReplaced)
+{
+    orders::order_queue book{orders::order_queue::ledger_capacity};
+    book.emplace(order(1, true, 100.0, 2));
+    book.emplace(order(2, true, 101.0, 3));
+    book.get(1)->filled_qty_ = 5;
+    book.inactive(1);
+    book.inactive(2);
+    book.emplace(order(2, true, 102.0, 3)); // rests again, only its old ring entry remains
+
+    checkpoint::snapshot_writer out;
+    book.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    orders::order_queue restored{orders::order_queue::ledger_capacity};
+    restored.emplace(order(7, false, 50.0, 1));
+    restored.inactive(7);
+    restored.restore(in);
+
+    // The ledger from before the restore is gone, the saved one is back in order
+    EXPECT_EQ(restored.retired(7), nullptr);
+    EXPECT_EQ(restored.ledger_size(), 2u);
+    ASSERT_NE(restored.retired(1), nullptr);
+    EXPECT_EQ(restored.retired(1)->filled_qty_, 5);
+    EXPECT_EQ(restored.retired(2), nullptr);
+    EXPECT_NE(restored.get(2), nullptr);
+    std::vector<order_id> ids;
+    restored.for_each_retired([&](const orders::order_state &st)
+                              { ids.push_back(st.order_.order_id_); });
+    EXPECT_EQ(ids, (std::vector<order_id>{1, 2}));
+}
+
+TEST(CheckpointTest, OrderLedgerRestoresIntoQueueDepth)
+{
+    orders::order_queue book{orders::order_queue::ledger_capacity};
+    for (order_id id = 1; id <= 3; ++id)
+    {
+        book.emplace(order(id, true, 100.0, static_cast<int64_t>(id)));
+        book.inactive(id);
+    }
+
+    checkpoint::snapshot_writer out;
+    book.save(out);
+
+    // A shallower ledger keeps the newest saved orders, none keeps nothing
+    checkpoint::snapshot_reader shallow_in{out.bytes()};
+    orders::order_queue shallow{1};
+    shallow.restore(shallow_in);
+    EXPECT_EQ(shallow.ledger_depth(), 1u);
+    EXPECT_EQ(shallow.ledger_size(), 1u);
+    EXPECT_NE(shallow.retired(3), nullptr);
+
+    checkpoint::snapshot_reader bare_in{out.bytes()};
+    orders::order_queue bare;
+    bare.restore(bare_in);
+    EXPECT_EQ(bare.ledger_size(), 0u);
+    EXPECT_EQ(bare.retired(3), nullptr);
+}
+
+TEST(CheckpointTest, CorruptOrderBookIsRejectedAndLeavesQueueAsItWas)
+{
+    orders::order_queue book;
+    book.emplace(order(1, true, 100.0, 2)); // symbol 0, book slot 1
+
+    checkpoint::snapshot_writer out;
+    book.save(out);
+    const auto bytes = out.bytes();
+    // Header, section tag, slot count, slot 0's zero tick size, slot 1's tick size and bid count
+    const auto slots_at = sizeof(checkpoint::snapshot_header) + sizeof(uint32_t);
+    const auto record_at = slots_at + sizeof(uint64_t) + 2 * sizeof(double) + sizeof(uint64_t);
+
+    orders::order_queue restored;
+    restored.emplace(order(9, true, 1.0, 0));
+
+    // A slot count beyond what the snapshot holds fails before anything is allocated for it
+    std::vector<std::byte> huge(bytes.begin(), bytes.end());
+    const uint64_t slots = uint64_t{1} << 32;
+    std::memcpy(huge.data() + slots_at, &slots, sizeof(slots));
+    checkpoint::snapshot_reader huge_in{huge};
+    EXPECT_THROW(restored.restore(huge_in), std::runtime_error);
+
+    // An order filed under another symbol's book is refused
+    std::vector<std::byte> misfiled(bytes.begin(), bytes.end());
+    const symbols::symbol_id other = 7;
+    std::memcpy(misfiled.data() + record_at + offsetof(order_event, symbol_), &other, sizeof(other));
+    checkpoint::snapshot_reader misfiled_in{misfiled};
+    EXPECT_THROW(restored.restore(misfiled_in), std::runtime_error);
+
+    // An ask saved among the bids is refused, it would rest on the wrong side of the book
+    std::vector<std::byte> flipped(bytes.begin(), bytes.end());
+    const bool ask = false;
+    std::memcpy(flipped.data() + record_at + offsetof(order_event, is_buy_), &ask, sizeof(ask));
+    checkpoint::snapshot_reader flipped_in{flipped};
+    EXPECT_THROW(restored.restore(flipped_in), std::runtime_error);
+
+    EXPECT_EQ(restored.size(), 1u);
+    EXPECT_NE(restored.get(9), nullptr);
+
+    checkpoint::snapshot_reader in{bytes};
+    restored.restore(in);
+    EXPECT_EQ(restored.size(), 1u);
+    EXPECT_NE(restored.get(1), nullptr);
+}
+
+TEST(CheckpointTest, SchedulerRoundTripKeepsDueOrder)
+{
+    scheduled_queue scheduler;
+    for (uint64_t i = 0; i < 40; ++i)
+    {
+        scheduler.push((i * 7919) % 50, market_event{0, static_cast<double>(i), 1.0, 0, false});
+    }
+    event ev;
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(scheduler.pop(ev));
+    }
+
+    checkpoint::snapshot_writer out;
+    scheduler.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    scheduled_queue restored;
+    restored.restore(in);
+
+    ASSERT_EQ(restored.size(), scheduler.size());
+    EXPECT_EQ(restored.now(), scheduler.now());
+    event a;
+    event b;
+    while (scheduler.pop(a))
+    {
+        ASSERT_TRUE(restored.pop(b));
+        EXPECT_EQ(std::get<market_event>(a).price_, std::get<market_event>(b).price_);
+    }
+    EXPECT_TRUE(restored.empty());
+}
+
+TEST(CheckpointTest, CorruptEventsAreRejectedAndLeaveQueuesAsTheyWere)
+{
+    // Header, section tag and the queue's now or the scheduler's, then the event count
+    const auto events_at = sizeof(checkpoint::snapshot_header) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+    event_queue queue;
+    queue.push(market_event{0, 100.0, 1.0, 0, false});
+    checkpoint::snapshot_writer queue_out;
+    queue.save(queue_out);
+
+    // Bytes past every alternative's index, whatever the variant layout
+    std::vector<std::byte> unknown(queue_out.bytes().begin(), queue_out.bytes().end());
+    std::memset(unknown.data() + events_at, 0xff, sizeof(event));
+    event_queue restored;
+    restored.push(signal_event{});
+    checkpoint::snapshot_reader unknown_in{unknown};
+    EXPECT_THROW(restored.restore(unknown_in), std::runtime_error);
+    ASSERT_EQ(restored.size(), 1u);
+    event ev;
+    ASSERT_TRUE(restored.try_pop(ev));
+    EXPECT_TRUE(std::holds_alternative<signal_event>(ev));
+
+    scheduled_queue scheduler;
+    scheduler.push(5, market_event{0, 1.0, 1.0, 0, false});
+    scheduler.push(9, market_event{0, 2.0, 1.0, 0, false});
+    ASSERT_TRUE(scheduler.pop(ev));
+    checkpoint::snapshot_writer scheduler_out;
+    scheduler.save(scheduler_out);
+    const auto bytes = scheduler_out.bytes();
+
+    scheduled_queue kept;
+    kept.push(3, signal_event{});
+
+    std::vector<std::byte> bad_event(bytes.begin(), bytes.end());
+    std::memset(bad_event.data() + events_at + sizeof(uint64_t), 0xff, sizeof(event));
+    checkpoint::snapshot_reader bad_event_in{bad_event};
+    EXPECT_THROW(kept.restore(bad_event_in), std::runtime_error);
+
+    // An event due before the saved now would break the scheduler's monotone keys
+    std::vector<std::byte> early(bytes.begin(), bytes.end());
+    const uint64_t due = 1;
+    std::memcpy(early.data() + events_at, &due, sizeof(due));
+    checkpoint::snapshot_reader early_in{early};
+    EXPECT_THROW(kept.restore(early_in), std::runtime_error);
+
+    ASSERT_EQ(kept.size(), 1u);
+    EXPECT_EQ(kept.now(), 0u);
+
+    checkpoint::snapshot_reader in{bytes};
+    kept.restore(in);
+    ASSERT_EQ(kept.size(), 1u);
+    ASSERT_TRUE(kept.pop(ev));
+    EXPECT_EQ(std::get<market_event>(ev).price_, 2.0);
+}
+
+TEST(CheckpointTest, ResumedRunMatchesUninterruptedRun)
+{
+    const auto ticks = make_ticks(300);
+    const auto path = std::filesystem::temp_directory_path() / "test_checkpoint.qes";
+
+    ResumableEngine full{ticks};
+    full.run();
+
+    // Stop part way, with orders resting and deliveries still scheduled
+    ResumableEngine first{ticks};
+    first.stop_at = 137;
+    first.run();
+    ASSERT_GT(first.exec_handler().get_order(135)->filled_qty_, 0);
+    first.save_checkpoint(path);
+
+    ResumableEngine resumed{ticks};
+    resumed.restore_checkpoint(path);
+    EXPECT_EQ(resumed.strategy().seen, 137);
+    EXPECT_EQ(resumed.symbols().size(), 2u);
+    resumed.run();
+    std::filesystem::remove(path);
+
+    const auto &a = full.portfolio_manager();
+    const auto &b = resumed.portfolio_manager();
+    EXPECT_EQ(resumed.strategy().seen, full.strategy().seen);
+    EXPECT_EQ(resumed.strategy().fills, full.strategy().fills);
+    EXPECT_DOUBLE_EQ(b.cash_balance(), a.cash_balance());
+    EXPECT_DOUBLE_EQ(b.realized_pnl(), a.realized_pnl());
+    ASSERT_EQ(b.trade_log().size(), a.trade_log().size());
+    for (size_t i = 0; i < a.trade_log().size(); ++i)
+    {
+        EXPECT_EQ(b.trade_log()[i].order_id_, a.trade_log()[i].order_id_);
+        EXPECT_EQ(b.trade_log()[i].timestamp, a.trade_log()[i].timestamp);
+    }
+    for (const auto *name : {"BTCUSD", "ETHUSD"})
+    {
+        EXPECT_EQ(b.position(resumed.symbols().find(name)).quantity, a.position(full.symbols().find(name)).quantity);
+    }
+    for (order_id id = 3; id <= 300; id += 3)
+    {
+        const auto *x = full.exec_handler().get_order(id);
+        const auto *y = resumed.exec_handler().get_order(id);
+        ASSERT_EQ(x == nullptr, y == nullptr) << id;
+        if (x)
+        {
+            EXPECT_EQ(y->filled_qty_, x->filled_qty_);
+            EXPECT_DOUBLE_EQ(y->avg_fill_price_, x->avg_fill_price_);
+        }
+    }
+}
+
+TEST(CheckpointTest, RestoredOrderIdsAreNotReissued)
+{
+    const auto ticks = make_ticks(20);
+    const auto path = std::filesystem::temp_directory_path() / "test_checkpoint_ids.qes";
+
+    orders::order_id_generator first_ids{4};
+    GeneratedIdEngine first{ticks, first_ids};
+    first.stop_at = 10;
+    first.run();
+    first.save_checkpoint(path);
+
+    // A new process starts from a new generator, the snapshot moves it past every issued ID
+    orders::order_id_generator ids{4};
+    GeneratedIdEngine resumed{ticks, ids};
+    resumed.restore_checkpoint(path);
+    std::filesystem::remove(path);
+    EXPECT_EQ(ids.next_unclaimed(), first_ids.next_unclaimed());
+
+    // Orders placed after the restore rest beside the restored ones instead of replacing them
+    resumed.run();
+    EXPECT_EQ(resumed.strategy().seen, 20);
+    for (order_id id = 1; id <= 10; ++id)
+    {
+        const auto *before = first.exec_handler().get_order(id);
+        const auto *after = resumed.exec_handler().get_order(id);
+        ASSERT_NE(before, nullptr) << id;
+        ASSERT_NE(after, nullptr) << id;
+        EXPECT_EQ(after->order_.timestamp_, before->order_.timestamp_) << id;
+        EXPECT_EQ(after->filled_qty_, before->filled_qty_) << id;
+    }
+    for (order_id id = first_ids.next_unclaimed(); id < first_ids.next_unclaimed() + 10; ++id)
+    {
+        EXPECT_NE(resumed.exec_handler().get_order(id), nullptr) << id;
+    }
+}
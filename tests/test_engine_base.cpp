@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "engine_base.hpp"
 #include "events/event.hpp"
+#include "ingest/tick_buffer.hpp"
 #include "portfolio/portfolio_manager.hpp"
 
 using namespace engine;
@@ -35,10 +36,12 @@ struct DummyStrategy
 {
     bool saw_market = false;
     bool saw_signal = false;
+    engine::symbols::symbol_id last_symbol = engine::symbols::invalid_symbol;
 
-    void on_market(const market_event &, event_queue &q)
+    void on_market(const market_event &ev, event_queue &q)
     {
         saw_market = true;
+        last_symbol = ev.symbol_;
         // Push a fake signal after market
         q.push(signal_event{});
     }
@@ -47,7 +50,7 @@ struct DummyStrategy
     {
         saw_signal = true;
         // Push a dummy order to keep the pipeline flowing
-        q.push(order_event{"BTCUSD", "1", 1, true, 100.0, order_type::Limit, order_flags::FOK});
+        q.push(order_event{last_symbol, 1, 1, true, 100.0, order_type::Limit, order_flags::FOK});
     }
 
     void on_cancel(const cancel_event&)
@@ -56,30 +59,23 @@ struct DummyStrategy
     }
 };
 
-static order_event order_ev{"BTCUSD",
-                     "order",
-                     2,
-                     false,
-                     200.0,
-                     order_type::Market,
-                     order_flags::None,
-                     std::chrono::system_clock::now(),
-                     market_event{"BTCUSD", 200.0, 2, 1, false}};
-
 // Dummy execution handler: records orders
 struct DummyExec
 {
     bool saw_order = false;
+    size_t markets_seen = 0;
+    std::vector<size_t> markets_seen_at_order;
 
     void on_order(const order_event &order, event_queue &q)
     {
         saw_order = true;
-        q.push(fill_event{order.symbol_, "1", order.quantity_, order.quantity_, order.is_buy_, order.price_, order_ev});
+        markets_seen_at_order.push_back(markets_seen);
+        q.push(fill_event{order.symbol_, 1, order.quantity_, order.quantity_, order.is_buy_, order.price_, q.payloads().retain(order)});
     }
 
     void on_market(const market_event &, event_queue &)
     {
-        // empty
+        ++markets_seen;
     }
 };
 
@@ -123,7 +119,7 @@ TEST(EngineBaseTest, OrderAndFillFlowUpdatesPortfolio)
     EXPECT_TRUE(engine.exec_handler().saw_order);
 
     // Portfolio should reflect the fill
-    EXPECT_EQ(engine.portfolio_manager().position("BTCUSD").quantity, 1);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 1);
     EXPECT_NEAR(engine.portfolio_manager().cash_balance(), 900.0, 1e-9);
 }
 
@@ -142,7 +138,7 @@ TEST(EngineBaseTest, MultipleTicksProcessedInOrder)
 
     // Market prices should be updated to last tick
     EXPECT_NEAR(engine.portfolio_manager().total_equity(), 1006.0, 1e-9); // only 1 fill from first tick
-    EXPECT_EQ(engine.portfolio_manager().position("BTCUSD").quantity, 3);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 3);
     EXPECT_NEAR(engine.portfolio_manager().unrealized_pnl(), 6.0, 1e-9); // mark-to-market at 102 vs entry 100
 }
 
@@ -178,6 +174,582 @@ TEST(EngineBaseTest, MultipleSignalsOrdersFills)
     TestEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
     engine.run();
 
-    EXPECT_EQ(engine.portfolio_manager().position("BTCUSD").quantity, 2);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 2);
     EXPECT_NEAR(engine.portfolio_manager().cash_balance(), 800.0, 1e-9);
 }
+
+TEST(EngineBaseTest, PipelinedRunMatchesSerialRun)
+{
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 1, false},
+         tick_data{"BTCUSD", 101.0, 1.0, 2, false},
+         tick_data{"BTCUSD", 102.0, 1.0, 3, false}}};
+    DummyStrategy strat;
+    portfolio_manager pf(1000.0);
+    DummyExec exec;
+
+    // Tiny ring forces the streamer thread to stall on the engine
+    TestEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
+    engine.run_pipelined({2, -1});
+
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 3);
+    EXPECT_NEAR(engine.portfolio_manager().total_equity(), 1006.0, 1e-9);
+    EXPECT_EQ(engine.pipeline_stats().ring_capacity, 2u);
+}
+
+TEST(EngineBaseTest, LatencyModelDelaysOrdersBySimulatedTime)
+{
+    // Ticks 10ms apart, orders take 5ms to reach execution
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 10, false},
+         tick_data{"BTCUSD", 101.0, 1.0, 20, false},
+         tick_data{"BTCUSD", 102.0, 1.0, 30, false}}};
+    DummyStrategy strat;
+    portfolio_manager pf(1000.0);
+    DummyExec exec;
+
+    TestEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
+    engine.set_latency_model({std::chrono::milliseconds{5}, std::chrono::nanoseconds{0}});
+    engine.run();
+
+    // Each order lands after the tick that spawned it, before the next one
+    EXPECT_EQ(engine.exec_handler().markets_seen_at_order, (std::vector<size_t>{1, 2, 3}));
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 3);
+}
+
+TEST(EngineBaseTest, LatencyModelHoldsOrdersAcrossTicks)
+{
+    // Ticks 1ms apart, orders take 5ms so all arrive after the last tick
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 1, false},
+         tick_data{"BTCUSD", 101.0, 1.0, 2, false},
+         tick_data{"BTCUSD", 102.0, 1.0, 3, false}}};
+    DummyStrategy strat;
+    portfolio_manager pf(1000.0);
+    DummyExec exec;
+
+    TestEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
+    engine.set_latency_model({std::chrono::milliseconds{5}, std::chrono::milliseconds{1}});
+    engine.run();
+
+    // In flight orders and fills are flushed when the stream ends
+    EXPECT_EQ(engine.exec_handler().markets_seen_at_order, (std::vector<size_t>{3, 3, 3}));
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 3);
+}
+
+// Backtest engine on simulated time
+struct SimEngine
+    : public engine_base<SimEngine, DummyStreamer, DummyStrategy, DummyExec, timing::sim_clock>
+{
+    using Base = engine_base<SimEngine, DummyStreamer, DummyStrategy, DummyExec, timing::sim_clock>;
+    using Base::Base;
+
+    bool should_stop() { return false; }
+    bool handle_no_event() { return false; }
+};
+
+TEST(EngineBaseTest, SimClockStampsEventsWithMarketTime)
+{
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 1000, false},
+         tick_data{"BTCUSD", 101.0, 1.0, 2000, false}}};
+    DummyStrategy strat;
+    portfolio_manager pf(1000.0);
+    DummyExec exec;
+
+    SimEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
+    engine.run();
+
+    using std::chrono::milliseconds;
+    const auto &log = engine.portfolio_manager().trade_log();
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[0].timestamp, timing::time_point{milliseconds{1000}});
+    EXPECT_EQ(log[1].timestamp, timing::time_point{milliseconds{2000}});
+    EXPECT_EQ(engine.clock().now(), timing::time_point{milliseconds{2000}});
+}
+
+TEST(EngineBaseTest, SimClockStampsDelayedFillsAtDeliveryTime)
+{
+    DummyStreamer streamer{{tick_data{"BTCUSD", 100.0, 1.0, 1000, false}}};
+    DummyStrategy strat;
+    portfolio_manager pf(1000.0);
+    DummyExec exec;
+
+    SimEngine engine{std::move(streamer), std::move(strat), std::move(pf), std::move(exec)};
+    engine.set_latency_model({std::chrono::milliseconds{5}, std::chrono::milliseconds{2}});
+    engine.run();
+
+    // Fill emitted when the order lands at 1005ms
+    const auto &log = engine.portfolio_manager().trade_log();
+    ASSERT_EQ(log.size(), 1u);
+    EXPECT_EQ(log[0].timestamp, timing::time_point{std::chrono::milliseconds{1005}});
+}
+
+// Orders carry their trigger tick, the first one's is then flooded out of the payload store
+struct TriggeredOrders
+{
+    void on_market(const market_event &ev, event_queue &q)
+    {
+        q.push(order_event{ev.symbol_, ++sent, 1, true, ev.price_, order_type::Limit, order_flags::None, {}, q.payloads().retain(ev)});
+        if (sent == 1)
+        {
+            for (size_t i = 0; i < payload_store::default_capacity; ++i)
+            {
+                q.payloads().retain(ev);
+            }
+        }
+    }
+
+    order_id sent = 0;
+};
+
+// Records whether each order's trigger still resolves on arrival
+struct TriggerCheckingExec
+{
+    std::vector<bool> resolved;
+
+    void on_order(const order_event &order, event_queue &q)
+    {
+        resolved.push_back(q.payloads().tick(order.trigger_) != nullptr);
+    }
+};
+
+struct TriggerEngine
+    : public engine_base<TriggerEngine, DummyStreamer, TriggeredOrders, TriggerCheckingExec, timing::sim_clock>
+{
+    using Base = engine_base<TriggerEngine, DummyStreamer, TriggeredOrders, TriggerCheckingExec, timing::sim_clock>;
+    using Base::Base;
+
+    bool should_stop() { return false; }
+    bool handle_no_event() { return false; }
+};
+
+TEST(EngineBaseTest, DelayedEventsWithEvictedPayloadsAreCounted)
+{
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 1000, false},
+         tick_data{"BTCUSD", 101.0, 1.0, 2000, false}}};
+
+    TriggerEngine engine{std::move(streamer), TriggeredOrders{}, portfolio_manager{1000.0}, TriggerCheckingExec{}};
+    engine.set_latency_model({std::chrono::milliseconds{5}, std::chrono::milliseconds{1}});
+    engine.run();
+
+    // The first order's trigger was evicted while it was in flight, the second's was not
+    EXPECT_EQ(engine.exec_handler().resolved, (std::vector<bool>{false, true}));
+    EXPECT_EQ(engine.stale_payloads(), 1u);
+}
+
+// Custom event carried alongside the core list
+struct funding_event
+{
+    double rate_;
+    std::chrono::system_clock::time_point timestamp{};
+};
+
+using funding_events = extend_events_t<default_events, funding_event>;
+using funding_queue = basic_event_queue<funding_events::variant>;
+
+// Strategy emitting a funding event per tick and handling it through on_event
+struct FundingStrategy
+{
+    std::vector<double> rates;
+    std::vector<timing::time_point> stamps;
+    size_t fills_seen = 0;
+
+    void on_market(const market_event &ev, funding_queue &q)
+    {
+        q.push(funding_event{ev.price_ / 1000.0});
+    }
+
+    void on_event(const funding_event &ev)
+    {
+        rates.push_back(ev.rate_);
+        stamps.push_back(ev.timestamp);
+    }
+
+    void on_fill(const fill_event &)
+    {
+        ++fills_seen;
+    }
+};
+
+// Handles only orders, never sees markets or funding
+struct OrderOnlyExec
+{
+    size_t orders = 0;
+
+    void on_order(const order_event &, funding_queue &)
+    {
+        ++orders;
+    }
+};
+
+struct FundingEngine
+    : public engine_base<FundingEngine, DummyStreamer, FundingStrategy, OrderOnlyExec, timing::sim_clock, funding_events>
+{
+    using Base = engine_base<FundingEngine, DummyStreamer, FundingStrategy, OrderOnlyExec, timing::sim_clock, funding_events>;
+    using Base::Base;
+
+    bool should_stop() { return false; }
+    bool handle_no_event() { return false; }
+};
+
+static_assert(handles_v<FundingStrategy, funding_event, funding_queue>);
+static_assert(!handles_v<OrderOnlyExec, market_event, funding_queue>);
+static_assert(!handles_v<portfolio_manager, funding_event, funding_queue>);
+
+TEST(EngineBaseTest, CustomEventListRoutesToDetectedHandlers)
+{
+    DummyStreamer streamer{
+        {tick_data{"BTCUSD", 100.0, 1.0, 1000, false},
+         tick_data{"BTCUSD", 200.0, 1.0, 2000, false}}};
+
+    FundingEngine engine{std::move(streamer), FundingStrategy{}, portfolio_manager{1000.0}, OrderOnlyExec{}};
+    engine.run();
+
+    const auto &strat = engine.strategy();
+    ASSERT_EQ(strat.rates.size(), 2u);
+    EXPECT_DOUBLE_EQ(strat.rates[0], 0.1);
+    EXPECT_DOUBLE_EQ(strat.rates[1], 0.2);
+
+    // Custom events with a timestamp are stamped like core ones
+    EXPECT_EQ(strat.stamps[1], timing::time_point{std::chrono::milliseconds{2000}});
+    EXPECT_EQ(engine.exec_handler().orders, 0u);
+    EXPECT_EQ(strat.fills_seen, 0u);
+}
+
+TEST(EngineBaseTest, StrategyFillHandlerIsDetected)
+{
+    // Fills now reach any component declaring on_fill, not just the portfolio
+    struct FillStrategy : DummyStrategy
+    {
+        size_t fills = 0;
+        void on_fill(const fill_event &) { ++fills; }
+    };
+    struct FillEngine : engine_base<FillEngine, DummyStreamer, FillStrategy, DummyExec>
+    {
+        using engine_base<FillEngine, DummyStreamer, FillStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    DummyStreamer streamer{{tick_data{"BTCUSD", 100.0, 1.0, 1, false}}};
+    FillEngine engine{std::move(streamer), FillStrategy{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.run();
+
+    EXPECT_EQ(engine.strategy().fills, 1u);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 1);
+}
+
+// View streamer over caller owned storage with string_view symbols
+struct StringViewStreamer
+{
+    struct tick
+    {
+        std::string_view symbol;
+        double price;
+        double qty;
+        int64_t timestamp_ms;
+        bool is_buyer_match;
+    };
+
+    std::vector<tick> ticks;
+    size_t index = 0;
+
+    const tick *next_view()
+    {
+        return index < ticks.size() ? &ticks[index++] : nullptr;
+    }
+};
+
+static_assert(ingest::view_streamer<StringViewStreamer>);
+static_assert(!ingest::id_view_streamer<StringViewStreamer>);
+static_assert(ingest::id_view_streamer<ingest::tick_buffer>);
+static_assert(!ingest::view_streamer<DummyStreamer>);
+
+TEST(EngineBaseTest, StringViewStreamerIngestsInPlace)
+{
+    const std::string btc = "BTCUSD";
+    StringViewStreamer streamer{{{btc, 100.0, 1.0, 1, false},
+                                 {btc, 102.0, 1.0, 2, false}}};
+
+    struct ViewEngine : engine_base<ViewEngine, StringViewStreamer, DummyStrategy, DummyExec>
+    {
+        using engine_base<ViewEngine, StringViewStreamer, DummyStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    ViewEngine engine{std::move(streamer), DummyStrategy{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.run();
+
+    EXPECT_EQ(engine.symbols().size(), 1u);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 2);
+    EXPECT_NEAR(engine.portfolio_manager().total_equity(), 1004.0, 1e-9);
+}
+
+TEST(EngineBaseTest, IdViewStreamerMapsLocalSymbols)
+{
+    ingest::tick_buffer buffer;
+    buffer.add("ETHUSD", 10.0, 1.0, 1, false);
+    buffer.add("BTCUSD", 100.0, 1.0, 2, false);
+    buffer.add("ETHUSD", 11.0, 1.0, 3, false);
+
+    struct BufferEngine : engine_base<BufferEngine, ingest::tick_buffer, DummyStrategy, DummyExec>
+    {
+        using engine_base<BufferEngine, ingest::tick_buffer, DummyStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    BufferEngine engine{std::move(buffer), DummyStrategy{}, portfolio_manager{1000.0}, DummyExec{}};
+
+    // Engine IDs differ from the buffer's local ones
+    engine.symbols().intern("BTCUSD");
+    engine.run();
+
+    const auto &symbols = engine.symbols();
+    EXPECT_EQ(symbols.find("BTCUSD"), 0u);
+    EXPECT_EQ(symbols.find("ETHUSD"), 1u);
+    EXPECT_EQ(engine.portfolio_manager().position(symbols.find("ETHUSD")).quantity, 2);
+    EXPECT_EQ(engine.portfolio_manager().position(symbols.find("BTCUSD")).quantity, 1);
+    EXPECT_DOUBLE_EQ(engine.portfolio_manager().last_price(symbols.find("ETHUSD")), 11.0);
+}
+
+TEST(EngineBaseTest, BatchStreamerFiresMetricsPerBatch)
+{
+    struct BatchEngine : engine_base<BatchEngine, ingest::tick_buffer, DummyStrategy, DummyExec>
+    {
+        using engine_base<BatchEngine, ingest::tick_buffer, DummyStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+        void on_loop_metrics(size_t ticks, std::chrono::nanoseconds)
+        {
+            metric_ticks.push_back(ticks);
+        }
+
+        std::vector<size_t> metric_ticks;
+    };
+    static_assert(ingest::batch_streamer<ingest::tick_buffer>);
+
+    constexpr size_t count = 2 * BatchEngine::tick_batch_size + 10;
+    ingest::tick_buffer buffer;
+    for (size_t i = 0; i < count; ++i)
+    {
+        buffer.add("BTCUSD", 100.0, 1.0, static_cast<int64_t>(i), false);
+    }
+
+    BatchEngine engine{std::move(buffer), DummyStrategy{}, portfolio_manager{1000000.0}, DummyExec{}};
+    engine.run();
+
+    // One metrics call per batch, with the running tick count
+    const std::vector<size_t> expected{BatchEngine::tick_batch_size, 2 * BatchEngine::tick_batch_size, count};
+    EXPECT_EQ(engine.metric_ticks, expected);
+
+    // Every tick still drives its own order and fill
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, static_cast<int64_t>(count));
+    EXPECT_EQ(engine.exec_handler().markets_seen_at_order.back(), count);
+}
+
+TEST(EngineBaseTest, BlockingIdleResumesPausedEngine)
+{
+    struct BlockingEngine : engine_base<BlockingEngine, DummyStreamer, DummyStrategy, DummyExec,
+                                        timing::real_time_clock, default_events, concurrency::blocking_idle>
+    {
+        using engine_base<BlockingEngine, DummyStreamer, DummyStrategy, DummyExec,
+                          timing::real_time_clock, default_events, concurrency::blocking_idle>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    DummyStreamer streamer{{tick_data{"BTCUSD", 100.0, 1.0, 1, false}}};
+    BlockingEngine engine{std::move(streamer), DummyStrategy{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.idle_strategy() = concurrency::blocking_idle{std::chrono::seconds{10}};
+    engine.pause();
+
+    std::thread resumer([&]
+                        {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        engine.resume(); });
+    engine.run();
+    resumer.join();
+
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 1);
+
+    // Paused time is metered as idle
+    const auto idle = engine.idle_stats();
+    EXPECT_EQ(idle.idle_episodes, 1u);
+    EXPECT_GE(idle.idle_ns, 10'000'000u);
+    EXPECT_LT(idle.idle_calls, 100u);
+}
+
+TEST(EngineBaseTest, NoEventIdlesUntilStreamerHasData)
+{
+    // Streamer with nothing for the first few polls
+    struct LateStreamer
+    {
+        int empty_polls = 3;
+        bool sent = false;
+
+        std::optional<tick_data> next()
+        {
+            if (empty_polls > 0)
+            {
+                --empty_polls;
+                return std::nullopt;
+            }
+            if (sent)
+                return std::nullopt;
+            sent = true;
+            return tick_data{"BTCUSD", 100.0, 1.0, 1, false};
+        }
+    };
+    struct LateEngine : engine_base<LateEngine, LateStreamer, DummyStrategy, DummyExec>
+    {
+        using engine_base<LateEngine, LateStreamer, DummyStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return !streamer_done(); }
+        bool streamer_done() { return strategy().saw_market; }
+    };
+
+    LateEngine engine{LateStreamer{}, DummyStrategy{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.run();
+
+    const auto idle = engine.idle_stats();
+    EXPECT_EQ(idle.idle_episodes, 1u);
+    EXPECT_EQ(idle.idle_calls, 3u);
+    EXPECT_TRUE(engine.strategy().saw_market);
+}
+
+TEST(EngineBaseTest, SampledLoopMetricsFeedHistograms)
+{
+    struct MetricsEngine : engine_base<MetricsEngine, DummyStreamer, DummyStrategy, DummyExec>
+    {
+        using engine_base<MetricsEngine, DummyStreamer, DummyStrategy, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+        void on_loop_metrics(size_t, std::chrono::nanoseconds) { ++hook_calls; }
+
+        size_t hook_calls = 0;
+    };
+
+    std::vector<tick_data> ticks;
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        ticks.push_back(tick_data{"BTCUSD", 100.0, 1.0, i, false});
+    }
+
+    MetricsEngine engine{DummyStreamer{ticks}, DummyStrategy{}, portfolio_manager{1000000.0}, DummyExec{}};
+    engine.set_metrics_sampling(2);
+    engine.run();
+
+    // One tick per iteration, every other iteration timed
+    EXPECT_EQ(engine.hook_calls, 5u);
+    const auto s = engine.metrics().iteration_ns().snapshot();
+    EXPECT_EQ(s.count(), 5u);
+    EXPECT_GT(s.max(), 0u);
+    EXPECT_GE(s.p99(), s.p50());
+}
+
+TEST(EngineBaseTest, DefaultOnErrorRethrowsOriginalException)
+{
+    struct Failing
+    {
+        void on_market(const market_event &) { throw std::out_of_range("strategy failed"); }
+    };
+    struct FailingEngine : engine_base<FailingEngine, DummyStreamer, Failing, DummyExec>
+    {
+        using engine_base<FailingEngine, DummyStreamer, Failing, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    FailingEngine engine{DummyStreamer{{tick_data{"BTCUSD", 100.0, 1.0, 1, false}}}, Failing{}, portfolio_manager{1000.0}, DummyExec{}};
+
+    // Not sliced to std::exception
+    EXPECT_THROW(engine.run(), std::out_of_range);
+}
+
+TEST(EngineBaseTest, SwallowedErrorResumesTickBatchAtNextTick)
+{
+    struct FailsOnce : DummyStrategy
+    {
+        std::vector<int64_t> seen;
+
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            seen.push_back(ev.timestamp_ms_);
+            if (ev.timestamp_ms_ == 5)
+            {
+                throw std::runtime_error("strategy failed");
+            }
+            DummyStrategy::on_market(ev, q);
+        }
+    };
+    struct ResumingEngine : engine_base<ResumingEngine, ingest::tick_buffer, FailsOnce, DummyExec>
+    {
+        using engine_base<ResumingEngine, ingest::tick_buffer, FailsOnce, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+        void on_error(const std::exception &) { ++errors; }
+
+        size_t errors = 0;
+    };
+
+    ingest::tick_buffer buffer;
+    for (int64_t ts = 1; ts <= 10; ++ts)
+    {
+        buffer.add("BTCUSD", 100.0, 1.0, ts, false);
+    }
+    ResumingEngine engine{std::move(buffer), FailsOnce{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.run();
+
+    // Polled as one batch, every tick after the one that threw is still handled
+    EXPECT_EQ(engine.errors, 1u);
+    EXPECT_EQ(engine.strategy().seen, (std::vector<int64_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+    EXPECT_EQ(engine.exec_handler().markets_seen, 10u);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 9);
+}
+
+TEST(EngineBaseTest, SwallowedErrorStillDeliversEveryQueuedEvent)
+{
+    struct Fanout
+    {
+        size_t signals = 0;
+
+        void on_market(const market_event &, event_queue &q)
+        {
+            for (int i = 0; i < 5; ++i)
+            {
+                q.push(signal_event{});
+            }
+        }
+
+        void on_signal(const signal_event &, event_queue &q)
+        {
+            if (++signals == 2)
+            {
+                throw std::runtime_error("strategy failed");
+            }
+            q.push(order_event{0, signals, 1, true, 100.0, order_type::Limit, order_flags::FOK});
+        }
+    };
+    struct SwallowingEngine : engine_base<SwallowingEngine, DummyStreamer, Fanout, DummyExec>
+    {
+        using engine_base<SwallowingEngine, DummyStreamer, Fanout, DummyExec>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+        void on_error(const std::exception &) { ++errors; }
+
+        size_t errors = 0;
+    };
+
+    SwallowingEngine engine{DummyStreamer{{tick_data{"BTCUSD", 100.0, 1.0, 1, false}}}, Fanout{}, portfolio_manager{1000.0}, DummyExec{}};
+    engine.run();
+
+    // The signals popped in the same batch as the one that threw are still delivered
+    EXPECT_EQ(engine.errors, 1u);
+    EXPECT_EQ(engine.strategy().signals, 5u);
+    EXPECT_EQ(engine.exec_handler().markets_seen_at_order.size(), 4u);
+    EXPECT_EQ(engine.portfolio_manager().position(0).quantity, 4);
+}
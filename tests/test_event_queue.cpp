@@ -2,17 +2,12 @@
 #include "events/event_queue.hpp"
 #include "events/event.hpp"
 
+#include <array>
+
 using namespace engine::events;
 
-static order_event order_ev{"BTCUSD",
-                     "order",
-                     2,
-                     false,
-                     200.0,
-                     order_type::Market,
-                     order_flags::None,
-                     std::chrono::system_clock::now(),
-                     market_event{"BTCUSD", 200.0, 2, 1, false}};
+// interned symbol id used throughout
+constexpr engine::symbols::symbol_id BTC = 0;
 
 TEST(EventQueueTest, InitiallyEmpty)
 {
@@ -23,7 +18,7 @@ TEST(EventQueueTest, InitiallyEmpty)
 TEST(EventQueueTest, PushThenPopSingleEvent)
 {
     event_queue q;
-    fill_event f{"BTCUSD", "1", 1, 1, true, 100.0, order_ev};
+    fill_event f{BTC, 1, 1, 1, true, 100.0};
 
     q.push(f);
     EXPECT_FALSE(q.empty());
@@ -32,7 +27,7 @@ TEST(EventQueueTest, PushThenPopSingleEvent)
     EXPECT_TRUE(std::holds_alternative<fill_event>(ev));
     auto &fe = std::get<fill_event>(ev);
 
-    EXPECT_EQ(fe.symbol_, "BTCUSD");
+    EXPECT_EQ(fe.symbol_, BTC);
     EXPECT_EQ(fe.filled_qty_, 1);
     EXPECT_TRUE(fe.is_buy_);
     EXPECT_DOUBLE_EQ(fe.fill_price_, 100.0);
@@ -44,8 +39,8 @@ TEST(EventQueueTest, MultiplePushMaintainsFIFO)
 {
     event_queue q;
 
-    order_event o1{"BTCUSD", "1", 5, true, 101.0, order_type::Limit, order_flags::FOK};
-    order_event o2{"BTCUSD", "2", 10, false, 99.5, order_type::Limit, order_flags::FOK};
+    order_event o1{BTC, 1, 5, true, 101.0, order_type::Limit, order_flags::FOK};
+    order_event o2{BTC, 2, 10, false, 99.5, order_type::Limit, order_flags::FOK};
 
     q.push(o1);
     q.push(o2);
@@ -72,8 +67,8 @@ TEST(EventQueueTest, PushDifferentEventTypes)
     event_queue q;
 
     signal_event s;
-    market_event m{"BTCUSD", 100.5, 10.0, 123456789, false};
-    fill_event f{"BTCUSD", "2", 2, 2, false, 101.2, order_ev};
+    market_event m{BTC, 100.5, 10.0, 123456789, false};
+    fill_event f{BTC, 2, 2, 2, false, 101.2};
 
     q.push(s);
     q.push(m);
@@ -93,7 +88,7 @@ TEST(EventQueueTest, PushDifferentEventTypes)
 TEST(EventQueueTest, MovesEventsCorrectly)
 {
     event_queue q;
-    fill_event f{"BTCUSD", "1", 3, 3, true, 102.5, order_ev};
+    fill_event f{BTC, 1, 3, 3, true, 102.5};
 
     q.push(std::move(f));
     auto ev = q.pop();
@@ -110,3 +105,155 @@ TEST(EventQueueTest, PopThrowsOnEmptyQueue)
     EXPECT_TRUE(q.empty());
     EXPECT_THROW(q.pop(), std::runtime_error);
 }
+
+TEST(EventQueueTest, PopReportsEmptyQueueByCode)
+{
+    event_queue q;
+    event ev;
+    EXPECT_EQ(q.pop(ev), engine::errors::errc::queue_empty);
+    q.push(market_event{BTC, 100.0, 1.0, 1, true});
+    EXPECT_EQ(q.pop(ev), engine::errors::errc::ok);
+    EXPECT_TRUE(std::holds_alternative<market_event>(ev));
+}
+
+TEST(EventQueueTest, FillReferencesOrderThroughPayloadStore)
+{
+    event_queue q;
+    market_event tick{BTC, 100.0, 1.0, 1, true};
+    order_event o{BTC, 1, 5, true, 100.0, order_type::Limit, order_flags::None,
+                  std::chrono::system_clock::now(), q.payloads().retain(tick)};
+
+    q.push(fill_event{BTC, 1, 5, 5, true, 100.0, q.payloads().retain(o)});
+
+    auto ev = q.pop();
+    ASSERT_TRUE(std::holds_alternative<fill_event>(ev));
+    const auto *origin = q.payloads().order(std::get<fill_event>(ev).originating_order_);
+    ASSERT_NE(origin, nullptr);
+    EXPECT_EQ(origin->order_id_, 1u);
+    EXPECT_EQ(origin->quantity_, 5);
+
+    const auto *trigger = q.payloads().tick(origin->trigger_);
+    ASSERT_NE(trigger, nullptr);
+    EXPECT_DOUBLE_EQ(trigger->price_, 100.0);
+}
+
+TEST(EventQueueTest, PayloadStoreEvictsOldestOnWrap)
+{
+    payload_store store{2};
+    order_event o{BTC, 1, 5, true, 100.0, order_type::Limit, order_flags::None};
+
+    auto first = store.retain(o);
+    store.retain(o);
+    EXPECT_NE(store.order(first), nullptr);
+
+    // Third retain overwrites the first slot
+    store.retain(o);
+    EXPECT_EQ(store.order(first), nullptr);
+    EXPECT_EQ(store.order(order_ref{}), nullptr);
+}
+
+TEST(EventQueueTest, PayloadStoreInternsReasons)
+{
+    payload_store store;
+
+    auto a = store.intern_reason("IOC remainder cancelled");
+    auto b = store.intern_reason("IOC remainder cancelled");
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(store.reason(a), "IOC remainder cancelled");
+    EXPECT_TRUE(store.reason(reason_ref{}).empty());
+}
+
+TEST(EventQueueTest, TryPopOnEmptyReturnsFalse)
+{
+    event_queue q;
+    event ev;
+    EXPECT_FALSE(q.try_pop(ev));
+
+    q.push(signal_event{});
+    EXPECT_TRUE(q.try_pop(ev));
+    EXPECT_TRUE(std::holds_alternative<signal_event>(ev));
+    EXPECT_FALSE(q.try_pop(ev));
+}
+
+TEST(EventQueueTest, GrowsPastCapacityAndKeepsFIFOAcrossWrap)
+{
+    event_queue q{4};
+    EXPECT_EQ(q.capacity(), 4u);
+
+    // Offset head so pending events wrap the ring before growth
+    for (int64_t i = 0; i < 3; ++i)
+    {
+        q.push(market_event{BTC, 0.0, 0.0, i, false});
+    }
+    q.pop();
+    q.pop();
+
+    for (int64_t i = 3; i < 10; ++i)
+    {
+        q.push(market_event{BTC, 0.0, 0.0, i, false});
+    }
+    EXPECT_EQ(q.size(), 8u);
+    EXPECT_EQ(q.capacity(), 8u);
+
+    for (int64_t i = 2; i < 10; ++i)
+    {
+        auto ev = q.pop();
+        ASSERT_TRUE(std::holds_alternative<market_event>(ev));
+        EXPECT_EQ(std::get<market_event>(ev).timestamp_ms_, i);
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(EventQueueTest, ReserveAvoidsGrowth)
+{
+    event_queue q;
+    q.reserve(5000);
+    const auto cap = q.capacity();
+    EXPECT_GE(cap, 5000u);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        q.push(signal_event{});
+    }
+    EXPECT_EQ(q.capacity(), cap);
+}
+
+TEST(EventQueueTest, PopBatchAcrossWrapKeepsFIFO)
+{
+    event_queue q{4};
+    q.push(signal_event{});
+    q.push(signal_event{});
+    q.pop();
+    q.pop();
+
+    // Head now mid ring, pushes wrap
+    for (int64_t i = 0; i < 4; ++i)
+    {
+        q.push(market_event{BTC, 0.0, 0.0, i, false});
+    }
+
+    std::array<event, 3> out;
+    ASSERT_EQ(q.pop_batch(out), 3u);
+    for (int64_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(std::get<market_event>(out[static_cast<size_t>(i)]).timestamp_ms_, i);
+    }
+
+    ASSERT_EQ(q.pop_batch(out), 1u);
+    EXPECT_EQ(std::get<market_event>(out[0]).timestamp_ms_, 3);
+    EXPECT_EQ(q.pop_batch(out), 0u);
+}
+
+TEST(EventQueueTest, PushStampsUnsetTimestampsWithEngineTime)
+{
+    event_queue q;
+    const auto now = std::chrono::system_clock::time_point{std::chrono::seconds{42}};
+    const auto explicit_ts = std::chrono::system_clock::time_point{std::chrono::seconds{7}};
+    q.set_now(now);
+
+    q.push(order_event{BTC, 1, 1, true, 100.0, order_type::Limit, order_flags::None});
+    q.push(fill_event{BTC, 1, 1, 1, true, 100.0, {}, explicit_ts});
+
+    EXPECT_EQ(std::get<order_event>(q.pop()).timestamp_, now);
+    EXPECT_EQ(std::get<fill_event>(q.pop()).timestamp, explicit_ts);
+}
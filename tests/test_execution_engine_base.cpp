@@ -2,6 +2,8 @@
 #include "execution_engine_base.hpp"
 #include "events/event.hpp"
 #include "events/event_queue.hpp"
+#include "orders/client_id_map.hpp"
+#include "orders/order_id_generator.hpp"
 
 using namespace engine;
 using namespace engine::orders;
@@ -12,13 +14,18 @@ struct DummyEngine : public execution_engine_base<DummyEngine>
 {
     void on_order(const order_event &, event_queue &) {} // not needed for base tests
     // test hook
-    void test_emit_fill(const order_event &order,
-                        int64_t filled_qty,
-                        double exec_price,
-                        event_queue &q)
+    errors::errc test_emit_fill(const order_event &order,
+                                int64_t filled_qty,
+                                double exec_price,
+                                event_queue &q)
     {
-        this->emit_fill(order, filled_qty, exec_price, q);
+        return this->emit_fill(order, filled_qty, exec_price, q);
     }
+    errors::errc test_emit_cancel(const order_event &order, event_queue &q)
+    {
+        return this->emit_cancel(order, "IOC", q);
+    }
+    size_t resting() const { return orders_.size(); }
 };
 
 class ExecutionEngineBaseTest : public ::testing::Test
@@ -26,10 +33,16 @@ class ExecutionEngineBaseTest : public ::testing::Test
 protected:
     DummyEngine engine;
     event_queue queue;
+    engine::symbols::symbol_registry symbols;
+    client_id_map client_ids;
+    order_id_generator ids;
 
-    order_event make_order(std::string id, std::string symbol, int64_t qty, bool is_buy = true, double limit = 0.0)
+    // Client IDs are mapped to engine IDs at the boundary
+    order_event make_order(std::string_view client_id, std::string_view symbol, int64_t qty, bool is_buy = true, double limit = 0.0)
     {
-        return order_event{symbol, id, qty, is_buy, limit, order_type::Market, order_flags::FOK, std::chrono::system_clock::now(), market_event{}};
+        auto id = ids.next();
+        client_ids.bind(client_id, id);
+        return order_event{symbols.intern(symbol), id, qty, is_buy, limit, order_type::Market, order_flags::FOK, std::chrono::system_clock::now(), {}};
     }
 };
 
@@ -38,7 +51,7 @@ TEST_F(ExecutionEngineBaseTest, FirstFillInitializesState)
     auto order = make_order("ord1", "AAPL", 100);
     engine.test_emit_fill(order, 100, 150.0, queue);
 
-    const auto *st = engine.get_order("ord1");
+    const auto *st = engine.get_order(client_ids.find("ord1"));
     ASSERT_NE(st, nullptr);
     EXPECT_EQ(st->filled_qty_, 100);
     EXPECT_DOUBLE_EQ(st->avg_fill_price_, 150.0);
@@ -47,7 +60,7 @@ TEST_F(ExecutionEngineBaseTest, FirstFillInitializesState)
     auto ev = queue.pop();
     auto *fill = std::get_if<fill_event>(&ev);
     ASSERT_NE(fill, nullptr);
-    EXPECT_EQ(fill->order_id_, "ord1");
+    EXPECT_EQ(client_ids.client(fill->order_id_), "ord1");
     EXPECT_EQ(fill->filled_qty_, 100);
     EXPECT_EQ(fill->order_qty_, 100);
     EXPECT_TRUE(fill->is_buy_);
@@ -61,7 +74,7 @@ TEST_F(ExecutionEngineBaseTest, MultiplePartialFillsUpdateAveragePrice)
     engine.test_emit_fill(order, 50, 100.0, queue);
     engine.test_emit_fill(order, 25, 101.0, queue);
 
-    const auto *st = engine.get_order("ord2");
+    const auto *st = engine.get_order(client_ids.find("ord2"));
     ASSERT_NE(st, nullptr);
     EXPECT_EQ(st->filled_qty_, 75);
     EXPECT_NEAR(st->avg_fill_price_, 100.33, 1e-2); // weighted avg
@@ -74,7 +87,7 @@ TEST_F(ExecutionEngineBaseTest, FullFillMarksInactive)
     engine.test_emit_fill(order, 5, 200.0, queue);
     engine.test_emit_fill(order, 5, 201.0, queue);
 
-    const auto *st = engine.get_order("ord3");
+    const auto *st = engine.get_order(client_ids.find("ord3"));
     ASSERT_NE(st, nullptr);
     EXPECT_EQ(st->filled_qty_, 10);
 }
@@ -87,8 +100,8 @@ TEST_F(ExecutionEngineBaseTest, SeparateOrdersTrackedIndependently)
     engine.test_emit_fill(o1, 10, 300.0, queue);
     engine.test_emit_fill(o2, 5, 1000.0, queue);
 
-    const auto *st1 = engine.get_order("ord4");
-    const auto *st2 = engine.get_order("ord5");
+    const auto *st1 = engine.get_order(client_ids.find("ord4"));
+    const auto *st2 = engine.get_order(client_ids.find("ord5"));
 
     ASSERT_NE(st1, nullptr);
     ASSERT_NE(st2, nullptr);
@@ -103,7 +116,7 @@ TEST_F(ExecutionEngineBaseTest, OverFillStillMarksInactive)
 
     engine.test_emit_fill(order, 15, 500.0, queue); // > total_qty
 
-    const auto *st = engine.get_order("ord6");
+    const auto *st = engine.get_order(client_ids.find("ord6"));
     ASSERT_NE(st, nullptr);
     EXPECT_EQ(st->filled_qty_, 15); // recorded as is
 }
@@ -114,8 +127,50 @@ TEST_F(ExecutionEngineBaseTest, ZeroQuantityFillDoesNotCrash)
 
     engine.test_emit_fill(order, 0, 120.0, queue); // no-op fill
 
-    const auto *st = engine.get_order("ord7");
+    const auto *st = engine.get_order(client_ids.find("ord7"));
     ASSERT_NE(st, nullptr);
     EXPECT_EQ(st->filled_qty_, 0);
     EXPECT_DOUBLE_EQ(st->avg_fill_price_, 0.0);
 }
+
+TEST_F(ExecutionEngineBaseTest, EmitFillReportsQuantityErrors)
+{
+    auto order = make_order("ord1", "BTCUSD", 10);
+    EXPECT_EQ(engine.test_emit_fill(order, 0, 100.0, queue), errors::errc::invalid_quantity);
+    EXPECT_EQ(engine.test_emit_fill(order, 4, 100.0, queue), errors::errc::ok);
+    EXPECT_EQ(engine.test_emit_fill(order, 8, 100.0, queue), errors::errc::overfill);
+
+    // Reported, not refused, every fill is still emitted
+    EXPECT_EQ(queue.size(), 3u);
+}
+
+TEST_F(ExecutionEngineBaseTest, FillAfterCompletionIsOverfillAndDoesNotRest)
+{
+    auto order = make_order("ord8", "BTCUSD", 10);
+    EXPECT_EQ(engine.test_emit_fill(order, 10, 100.0, queue), errors::errc::ok);
+    EXPECT_EQ(engine.test_emit_fill(order, 1, 101.0, queue), errors::errc::overfill);
+
+    // Not resurrected, its final state is unchanged
+    EXPECT_EQ(engine.resting(), 0u);
+    const auto *st = engine.get_order(client_ids.find("ord8"));
+    ASSERT_NE(st, nullptr);
+    EXPECT_EQ(st->filled_qty_, 10);
+    EXPECT_DOUBLE_EQ(st->avg_fill_price_, 100.0);
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST_F(ExecutionEngineBaseTest, EmitCancelReportsUnknownOrders)
+{
+    auto order = make_order("ord9", "BTCUSD", 10);
+    EXPECT_EQ(engine.test_emit_cancel(order, queue), errors::errc::unknown_order);
+
+    EXPECT_EQ(engine.test_emit_fill(order, 4, 100.0, queue), errors::errc::ok);
+    EXPECT_EQ(engine.test_emit_cancel(order, queue), errors::errc::ok);
+    EXPECT_EQ(engine.test_emit_cancel(order, queue), errors::errc::unknown_order);
+
+    // A fill after the cancel is emitted, not applied
+    EXPECT_EQ(engine.test_emit_fill(order, 1, 100.0, queue), errors::errc::unknown_order);
+    EXPECT_EQ(engine.resting(), 0u);
+    EXPECT_EQ(engine.get_order(client_ids.find("ord9"))->filled_qty_, 4);
+    EXPECT_EQ(queue.size(), 5u);
+}
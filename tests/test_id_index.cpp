@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "orders/block_index.hpp"
+#include "orders/client_id_map.hpp"
+#include "orders/id_index.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+using namespace engine;
+using namespace engine::orders;
+
+namespace
+{
+    struct string_hash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view sv) const noexcept { return std::hash<std::string_view>{}(sv); }
+    };
+} // namespace
+
+TEST(IdIndexTest, InsertFindAndErase)
+{
+    id_index<uint64_t, int> index;
+    EXPECT_EQ(index.find(1u), nullptr);
+    EXPECT_FALSE(index.erase(1u));
+
+    EXPECT_TRUE(index.try_emplace(1u, 10).second);
+    EXPECT_FALSE(index.try_emplace(1u, 11).second);
+    EXPECT_EQ(*index.find(1u), 10);
+    index.insert_or_assign(1u, 12);
+    EXPECT_EQ(*index.find(1u), 12);
+    EXPECT_EQ(index.size(), 1u);
+
+    EXPECT_TRUE(index.erase(1u));
+    EXPECT_EQ(index.find(1u), nullptr);
+    EXPECT_TRUE(index.empty());
+}
+
+TEST(IdIndexTest, MatchesReferenceMapUnderChurn)
+{
+    id_index<uint64_t, uint64_t> index;
+    std::map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng{7};
+    for (int i = 0; i < 200'000; ++i)
+    {
+        // Small key range so inserts, hits and erases all collide often
+        const auto key = rng() % 4096;
+        if (rng() % 3 == 0)
+        {
+            EXPECT_EQ(index.erase(key), reference.erase(key) == 1);
+        }
+        else
+        {
+            EXPECT_EQ(index.try_emplace(key, key * 3).second, reference.emplace(key, key * 3).second);
+        }
+    }
+    EXPECT_EQ(index.size(), reference.size());
+    for (uint64_t key = 0; key < 4096; ++key)
+    {
+        const auto *value = index.find(key);
+        const auto it = reference.find(key);
+        ASSERT_EQ(value != nullptr, it != reference.end());
+        if (value)
+        {
+            EXPECT_EQ(*value, it->second);
+        }
+    }
+}
+
+TEST(IdIndexTest, ReserveAndClearKeepCapacity)
+{
+    id_index<uint64_t, int> index;
+    index.reserve(1000);
+    const auto cap = index.capacity();
+    EXPECT_GE(cap - cap / 8, 1000u);
+    for (uint64_t id = 1; id <= 1000; ++id)
+    {
+        index.try_emplace(id, 0);
+    }
+    EXPECT_EQ(index.capacity(), cap);
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.capacity(), cap);
+    EXPECT_EQ(index.find(5u), nullptr);
+}
+
+TEST(IdIndexTest, HeterogeneousLookupWithPrecomputedHash)
+{
+    id_index<std::string, int, string_hash> index;
+    index.try_emplace(std::string_view{"client-1"}, 1);
+    index.try_emplace(std::string{"client-2"}, 2);
+
+    const std::string_view key{"client-2"};
+    const auto h = index.hash(key);
+    ASSERT_NE(index.find(key, h), nullptr);
+    EXPECT_EQ(*index.find(key, h), 2);
+    EXPECT_EQ(index.hash(std::string{"client-2"}), h);
+    EXPECT_TRUE(index.erase(key, h));
+    EXPECT_FALSE(index.contains(key));
+    EXPECT_TRUE(index.contains(std::string_view{"client-1"}));
+}
+
+TEST(IdIndexTest, ClientIdMapLooksUpByPrecomputedHash)
+{
+    client_id_map map;
+    EXPECT_TRUE(map.bind("client-1", 7));
+    const auto h = map.hash("client-1");
+    EXPECT_EQ(map.find("client-1", h), 7u);
+    map.erase(7);
+    EXPECT_EQ(map.find("client-1", h), events::invalid_order_id);
+}
+
+TEST(IdIndexTest, BlockIndexMatchesReferenceMapUnderChurn)
+{
+    block_index<uint64_t, 3> index;
+    std::map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng{11};
+    uint64_t next = 1;
+    for (int i = 0; i < 200'000; ++i)
+    {
+        // Sequential inserts and erases of recent IDs, so blocks fill, empty and are reused
+        if (rng() % 2 == 0 || reference.empty())
+        {
+            const auto id = next++;
+            EXPECT_EQ(index.try_emplace(id, id * 3).second, reference.emplace(id, id * 3).second);
+        }
+        else
+        {
+            const auto id = next - 1 - rng() % std::min<uint64_t>(next - 1, 256);
+            EXPECT_EQ(index.erase(id), reference.erase(id) == 1);
+        }
+    }
+    EXPECT_EQ(index.size(), reference.size());
+    for (uint64_t id = 0; id <= next; ++id)
+    {
+        const auto *value = index.find(id);
+        const auto it = reference.find(id);
+        ASSERT_EQ(value != nullptr, it != reference.end());
+        if (value)
+        {
+            EXPECT_EQ(*value, it->second);
+        }
+    }
+}
+
+TEST(IdIndexTest, BlockIndexKeepsNeighboursOfErasedIds)
+{
+    block_index<int, 2> index;
+    EXPECT_FALSE(index.erase(5u));
+    EXPECT_TRUE(index.try_emplace(4u, 4).second);
+    EXPECT_TRUE(index.try_emplace(5u, 5).second);
+    EXPECT_FALSE(index.try_emplace(5u, 6).second);
+    EXPECT_EQ(index.find(6u), nullptr);
+
+    // Erasing one ID of a block leaves the rest, erasing the last releases it for reuse
+    EXPECT_TRUE(index.erase(4u));
+    EXPECT_EQ(index.find(4u), nullptr);
+    ASSERT_NE(index.find(5u), nullptr);
+    EXPECT_EQ(*index.find(5u), 5);
+    EXPECT_TRUE(index.erase(5u));
+    EXPECT_TRUE(index.empty());
+
+    EXPECT_TRUE(index.try_emplace(9u, 9).second);
+    EXPECT_EQ(index.find(5u), nullptr);
+    EXPECT_EQ(*index.find(9u), 9);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "concurrency/idle_strategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace engine::concurrency;
+using namespace std::chrono_literals;
+
+TEST(IdleStrategyTest, BackoffParksAfterSpinsAndYields)
+{
+    backoff_idle idle{{2, 2, 2ms, 2ms}};
+
+    // Spins and yields return immediately
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i)
+    {
+        idle.idle();
+    }
+    const auto polled = std::chrono::steady_clock::now();
+    EXPECT_LT(polled - start, 2ms);
+
+    // Then parks
+    idle.idle();
+    EXPECT_GE(std::chrono::steady_clock::now() - polled, 2ms);
+}
+
+TEST(IdleStrategyTest, BlockingWakeBeforeIdleIsNotLost)
+{
+    blocking_idle idle{10s};
+    idle.wake();
+
+    // Wake landed between the empty poll and idle, must return without sleeping
+    const auto start = std::chrono::steady_clock::now();
+    idle.idle();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+    EXPECT_EQ(idle.wakes(), 1u);
+}
+
+TEST(IdleStrategyTest, BlockingWaitsUntilWoken)
+{
+    blocking_idle idle{10s};
+    std::atomic<bool> woken{false};
+
+    std::thread waiter([&]
+                       {
+        idle.idle();
+        woken.store(true); });
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(woken.load());
+
+    // Keep waking until the waiter is observed, it may not have slept yet on the first wake
+    const auto start = std::chrono::steady_clock::now();
+    while (!woken.load())
+    {
+        idle.wake();
+        std::this_thread::sleep_for(1ms);
+    }
+    waiter.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+}
+
+TEST(IdleStrategyTest, BlockingTimesOut)
+{
+    blocking_idle idle{5ms};
+    const auto start = std::chrono::steady_clock::now();
+    idle.idle();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 4ms);
+}
+
+TEST(IdleStrategyTest, MeterCountsEpisodesAndTime)
+{
+    metered_idle<backoff_idle> idle{backoff_idle{{0, 0, 1ms, 1ms}}};
+
+    idle.idle();
+    idle.idle();
+    idle.reset();
+    idle.reset(); // no open episode, ignored
+    idle.idle();
+    idle.reset();
+
+    const auto c = idle.counters();
+    EXPECT_EQ(c.idle_episodes, 2u);
+    EXPECT_EQ(c.idle_calls, 3u);
+    EXPECT_GE(c.idle_ns, 3'000'000u);
+}
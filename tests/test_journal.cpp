@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include "engine_base.hpp"
+#include "journal/journal_reader.hpp"
+#include "journal/journal_streamer.hpp"
+#include "journal/journal_writer.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+using namespace engine::journal;
+
+namespace
+{
+    /// Journal path unique to the running test, removed on destruction
+    struct temp_journal
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                     (std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()} + ".qej");
+
+        ~temp_journal() { std::filesystem::remove(path); }
+    };
+
+    struct tick_source
+    {
+        struct tick
+        {
+            std::string symbol;
+            double price;
+            double qty;
+            int64_t timestamp_ms;
+            bool is_buyer_match;
+        };
+
+        std::vector<tick> ticks;
+        size_t index = 0;
+
+        std::optional<tick> next()
+        {
+            if (index < ticks.size())
+                return ticks[index++];
+            return std::nullopt;
+        }
+    };
+
+    // Buys one unit on every tick
+    struct buy_every_tick
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            q.push(order_event{ev.symbol_, ++next_id, 1, true, ev.price_, order_type::Market, order_flags::None});
+        }
+        void on_signal(const signal_event &, event_queue &) {}
+        void on_cancel(const cancel_event &) {}
+
+        order_id next_id = 0;
+    };
+
+    // Fills every order at its price
+    struct fill_all
+    {
+        void on_order(const order_event &order, event_queue &q)
+        {
+            q.push(fill_event{order.symbol_, order.order_id_, order.quantity_, order.quantity_, order.is_buy_, order.price_});
+        }
+        void on_market(const market_event &, event_queue &) {}
+    };
+
+    template <typename Streamer>
+    struct journal_engine : engine_base<journal_engine<Streamer>, Streamer, buy_every_tick, fill_all>
+    {
+        using engine_base<journal_engine<Streamer>, Streamer, buy_every_tick, fill_all>::engine_base;
+
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+} // namespace
+
+TEST(JournalTest, RoundTripsEveryEventKind)
+{
+    temp_journal tmp;
+    const std::vector<event> events{
+        market_event{0, 100.0, 2.0, 1'000, true},
+        signal_event{},
+        order_event{0, 7, 3, false, 101.5, order_type::Limit, order_flags::IOC},
+        fill_event{0, 7, 1, 3, false, 101.5},
+        cancel_event{order_event{0, 7, 3, false, 101.5, order_type::Limit, order_flags::IOC}}};
+    {
+        journal_writer writer{tmp.path};
+        writer.define_symbol(0, "BTCUSD");
+        for (const auto &ev : events)
+        {
+            writer.append(ev);
+        }
+    }
+
+    journal_reader reader{tmp.path};
+    EXPECT_TRUE(reader.complete());
+    EXPECT_EQ(reader.symbol_name(0), "BTCUSD");
+
+    event ev;
+    for (const auto &expected : events)
+    {
+        ASSERT_TRUE(reader.next(ev));
+        ASSERT_EQ(ev.index(), expected.index());
+    }
+    EXPECT_FALSE(reader.next(ev));
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(ev));
+    EXPECT_DOUBLE_EQ(std::get<market_event>(ev).price_, 100.0);
+    ASSERT_TRUE(reader.next(ev));
+    ASSERT_TRUE(reader.next(ev));
+    const auto &order = std::get<order_event>(ev);
+    EXPECT_EQ(order.order_id_, 7u);
+    EXPECT_EQ(order.type_, order_type::Limit);
+    EXPECT_EQ(order.flags_, order_flags::IOC);
+}
+
+TEST(JournalTest, RecordsReferencedPayloads)
+{
+    temp_journal tmp;
+    payload_store store;
+    const market_event tick{0, 100.0, 2.0, 1'000, true};
+    const order_event order{0, 7, 3, false, 101.5, order_type::Limit, order_flags::IOC, {}, store.retain(tick)};
+    const auto order_ref = store.retain(order);
+    {
+        journal_writer writer{tmp.path};
+        writer.define_symbol(0, "BTCUSD");
+        writer.append(order, store);
+        writer.append(fill_event{0, 7, 1, 3, false, 101.5, order_ref}, store);
+        writer.append(cancel_event{order, order_ref, store.intern_reason("expired")}, store);
+    }
+
+    const auto replay = [&](journal_reader &reader)
+    {
+        event ev;
+        ASSERT_TRUE(reader.next(ev));
+        const auto trigger_ref = std::get<order_event>(ev).trigger_;
+        const auto *trigger = reader.tick(trigger_ref);
+        ASSERT_NE(trigger, nullptr);
+        EXPECT_DOUBLE_EQ(trigger->price_, 100.0);
+        EXPECT_EQ(trigger->timestamp_ms_, 1'000);
+
+        ASSERT_TRUE(reader.next(ev));
+        const auto &fill = std::get<fill_event>(ev);
+        const auto *filled = reader.order(fill.originating_order_);
+        ASSERT_NE(filled, nullptr);
+        EXPECT_EQ(filled->order_id_, 7u);
+        EXPECT_EQ(filled->quantity_, 3);
+        EXPECT_EQ(reader.tick(trigger_ref), nullptr);
+
+        ASSERT_TRUE(reader.next(ev));
+        const auto &cancel = std::get<cancel_event>(ev);
+        const auto *cancelled = reader.order(cancel.originating_order_);
+        ASSERT_NE(cancelled, nullptr);
+        EXPECT_EQ(cancelled->order_id_, 7u);
+        EXPECT_EQ(cancelled->type_, order_type::Limit);
+        EXPECT_EQ(reader.reason(cancel.reason_), "expired");
+        EXPECT_FALSE(reader.next(ev));
+    };
+
+    {
+        journal_reader reader{tmp.path};
+        EXPECT_TRUE(reader.complete());
+        replay(reader);
+    }
+
+    // Reasons survive a rebuild by scan too
+    std::filesystem::resize_file(tmp.path, std::filesystem::file_size(tmp.path) - 1);
+    journal_reader reader{tmp.path};
+    EXPECT_FALSE(reader.complete());
+    replay(reader);
+}
+
+TEST(JournalTest, SeekUsesSparseIndex)
+{
+    temp_journal tmp;
+    {
+        journal_writer writer{tmp.path, {1024, 16, 1u << 12}};
+        writer.define_symbol(0, "BTCUSD");
+        for (int64_t t = 0; t < 1000; ++t)
+        {
+            writer.append(market_event{0, static_cast<double>(t), 1.0, t, false});
+        }
+    }
+
+    journal_streamer streamer{tmp.path};
+    EXPECT_GT(streamer.reader().index().size(), 1u);
+
+    streamer.seek(537);
+    auto tick = streamer.next();
+    ASSERT_TRUE(tick);
+    EXPECT_EQ(tick->timestamp_ms, 537);
+    EXPECT_EQ(tick->symbol, "BTCUSD");
+
+    // Past the end leaves nothing to replay
+    streamer.seek(5000);
+    EXPECT_FALSE(streamer.next());
+}
+
+TEST(JournalTest, MissingIndexIsRebuiltByScan)
+{
+    temp_journal tmp;
+    {
+        journal_writer writer{tmp.path};
+        writer.define_symbol(0, "ETHUSD");
+        for (int64_t t = 0; t < 100; ++t)
+        {
+            writer.append(market_event{0, 1.0, 1.0, t, false});
+        }
+    }
+
+    // Simulate a crash before the footer hit disk
+    std::filesystem::resize_file(tmp.path, std::filesystem::file_size(tmp.path) - 1);
+
+    journal_streamer streamer{tmp.path};
+    EXPECT_FALSE(streamer.reader().complete());
+    EXPECT_EQ(streamer.reader().symbol_name(0), "ETHUSD");
+
+    size_t count = 0;
+    while (streamer.next())
+    {
+        ++count;
+    }
+    EXPECT_EQ(count, 100u);
+}
+
+TEST(JournalTest, CorruptSymbolIdsAreRejected)
+{
+    temp_journal tmp;
+    {
+        journal_writer writer{tmp.path};
+        writer.define_symbol(0, "ETHUSD");
+        for (int64_t t = 0; t < 100; ++t)
+        {
+            writer.append(market_event{0, 1.0, 1.0, t, false});
+        }
+    }
+
+    // Overwrite the ID of the index's only symbol, after its kind byte and symbol count
+    auto patch_id = [&](uint64_t at)
+    {
+        std::fstream file{tmp.path, std::ios::in | std::ios::out | std::ios::binary};
+        const symbols::symbol_id corrupt = 0xFFFFFFF0u;
+        file.seekp(static_cast<std::streamoff>(at));
+        file.write(reinterpret_cast<const char *>(&corrupt), sizeof(corrupt));
+    };
+    file_footer footer;
+    {
+        std::ifstream file{tmp.path, std::ios::binary};
+        file.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios::end);
+        file.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+    }
+    patch_id(footer.index_offset_ + 1 + sizeof(uint32_t));
+
+    // The index is refused and the scan recovers the symbol from its definition record
+    {
+        journal_streamer streamer{tmp.path};
+        EXPECT_FALSE(streamer.reader().complete());
+        EXPECT_EQ(streamer.reader().symbol_name(0), "ETHUSD");
+        size_t count = 0;
+        while (streamer.next())
+        {
+            ++count;
+        }
+        EXPECT_EQ(count, 100u);
+    }
+
+    // A corrupt definition record ends the scan there
+    patch_id(sizeof(file_header) + 1);
+    journal_reader reader{tmp.path};
+    EXPECT_FALSE(reader.complete());
+    EXPECT_TRUE(reader.index().empty());
+}
+
+TEST(JournalTest, ReplayReproducesRecordedRun)
+{
+    temp_journal tmp;
+    tick_source source{{{"BTCUSD", 100.0, 1.0, 1, false},
+                        {"ETHUSD", 10.0, 1.0, 2, true},
+                        {"BTCUSD", 102.0, 1.0, 3, false}}};
+
+    journal_engine<tick_source> live{std::move(source), buy_every_tick{}, portfolio::portfolio_manager{1000.0}, fill_all{}};
+    {
+        journal_writer writer{tmp.path};
+        live.attach_journal(&writer);
+        live.run();
+        live.attach_journal(nullptr);
+    }
+
+    // Every dispatched event was recorded, ticks plus an order and fill per tick
+    {
+        journal_reader reader{tmp.path};
+        size_t count = 0;
+        event ev;
+        while (reader.next(ev))
+        {
+            ++count;
+        }
+        EXPECT_EQ(count, 9u);
+    }
+
+    journal_engine<journal_streamer> replay{journal_streamer{tmp.path}, buy_every_tick{}, portfolio::portfolio_manager{1000.0}, fill_all{}};
+    replay.run();
+
+    const auto &a = live.portfolio_manager();
+    const auto &b = replay.portfolio_manager();
+    EXPECT_DOUBLE_EQ(a.cash_balance(), b.cash_balance());
+    EXPECT_DOUBLE_EQ(a.total_equity(), b.total_equity());
+    EXPECT_EQ(b.position(replay.symbols().find("ETHUSD")).quantity, 1);
+    EXPECT_EQ(b.position(replay.symbols().find("BTCUSD")).quantity, 2);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "metrics/cycle_clock.hpp"
+#include "metrics/latency_histogram.hpp"
+#include "metrics/loop_metrics.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace engine::metrics;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    for (uint64_t v = 0; v < latency_histogram::linear_buckets; ++v)
+    {
+        EXPECT_EQ(latency_histogram::upper_bound(latency_histogram::index_of(v)), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreMonotoneWithBoundedError)
+{
+    size_t prev = 0;
+    for (uint64_t v = 1; v < (uint64_t{1} << 40); v = v * 3 / 2 + 1)
+    {
+        const auto i = latency_histogram::index_of(v);
+        EXPECT_GE(i, prev);
+        EXPECT_LT(i, latency_histogram::bucket_count);
+        prev = i;
+
+        const auto upper = latency_histogram::upper_bound(i);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(static_cast<double>(upper - v), static_cast<double>(v) * 0.04);
+    }
+    EXPECT_EQ(latency_histogram::index_of(UINT64_MAX), latency_histogram::bucket_count - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+    latency_histogram h;
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        h.record(v);
+    }
+    h.record(1'000'000);
+
+    const auto s = h.snapshot();
+    EXPECT_EQ(s.count(), 1001u);
+    EXPECT_EQ(s.max(), 1'000'000u);
+    EXPECT_NEAR(static_cast<double>(s.p50()), 501.0, 501.0 * 0.04);
+    EXPECT_NEAR(static_cast<double>(s.p99()), 991.0, 991.0 * 0.04);
+    EXPECT_EQ(s.percentile(1.0), 1'000'000u);
+    EXPECT_EQ(histogram_snapshot{}.p99(), 0u);
+}
+
+TEST(LatencyHistogramTest, SnapshotWhileWriting)
+{
+    latency_histogram h;
+    std::atomic<bool> done{false};
+    constexpr uint64_t count = 200'000;
+
+    std::thread writer([&]
+                       {
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            h.record(i & 1023);
+            if ((i & 4095) == 0)
+                std::this_thread::yield();
+        }
+        done.store(true); });
+
+    // Counts only ever grow under a reader
+    uint64_t last = 0;
+    while (!done.load())
+    {
+        const auto c = h.snapshot().count();
+        EXPECT_GE(c, last);
+        last = c;
+        std::this_thread::yield();
+    }
+    writer.join();
+    EXPECT_EQ(h.snapshot().count(), count);
+}
+
+TEST(LoopMetricsTest, SamplesOneInN)
+{
+    loop_metrics m;
+    m.set_sampling(4);
+    int sampled = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        sampled += m.sample() ? 1 : 0;
+    }
+    EXPECT_EQ(sampled, 10);
+
+    m.set_sampling(0);
+    EXPECT_FALSE(m.sample());
+}
+
+TEST(LoopMetricsTest, IdleIterationsAreNotRecorded)
+{
+    loop_metrics m;
+    m.record(1000, 0);
+    m.record(1000, 4);
+    EXPECT_EQ(m.iteration_ns().snapshot().count(), 1u);
+    EXPECT_EQ(m.tick_ns().snapshot().max(), 250u);
+}
+
+TEST(CycleClockTest, CalibratedAgainstWallTime)
+{
+    const auto start = cycle_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    const auto ns = cycle_clock::to_ns(cycle_clock::now() - start);
+    EXPECT_GE(ns, 15'000'000u);
+    EXPECT_LT(ns, 2'000'000'000u);
+}
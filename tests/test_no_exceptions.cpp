@@ -0,0 +1,87 @@
+// Built with -fno-exceptions, failures on the hot path are reported by error code
+#include <gtest/gtest.h>
+#include "engine_base.hpp"
+#include "execution_engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+
+#include <vector>
+
+#if ENGINE_EXCEPTIONS
+#error "test_no_exceptions.cpp must be compiled with -fno-exceptions"
+#endif
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    struct OrderPerTick
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            q.push(order_event{ev.symbol_, static_cast<order_id>(ev.timestamp_ms_ + 1), 10, true, ev.price_, order_type::Limit, order_flags::None});
+        }
+    };
+
+    // Overfills every other order and rejects orders above a price limit
+    struct Venue : execution_engine_base<Venue>
+    {
+        Venue() = default;
+
+        errors::errc on_order(const order_event &order, event_queue &q)
+        {
+            if (order.price_ > 105.0)
+            {
+                return errors::errc::rejected;
+            }
+            return emit_fill(order, order.order_id_ % 2 ? 12 : 10, order.price_, q);
+        }
+    };
+
+    struct NoExceptEngine : engine_base<NoExceptEngine, ingest::tick_buffer, OrderPerTick, Venue>
+    {
+        using engine_base<NoExceptEngine, ingest::tick_buffer, OrderPerTick, Venue>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+        void on_error_code(errors::errc ec, const event_type &ev)
+        {
+            reported.push_back(ec);
+            EXPECT_TRUE(std::holds_alternative<order_event>(ev));
+        }
+
+        std::vector<errors::errc> reported;
+    };
+} // namespace
+
+TEST(NoExceptionsTest, HandlerErrorCodesAreCountedAndForwarded)
+{
+    ingest::tick_buffer ticks;
+    for (int64_t i = 0; i < 8; ++i)
+    {
+        ticks.add("BTCUSD", 100.0 + static_cast<double>(i), 1.0, i, false);
+    }
+
+    NoExceptEngine engine{std::move(ticks), OrderPerTick{}, portfolio::portfolio_manager{100000.0}, Venue{}};
+    engine.run();
+
+    // Orders 1..6 priced 100..105 fill, odd IDs overfilled, 7 and 8 rejected
+    const auto &errors = engine.error_counts();
+    EXPECT_EQ(errors.count(errors::errc::overfill), 3u);
+    EXPECT_EQ(errors.count(errors::errc::rejected), 2u);
+    EXPECT_EQ(errors.total(), 5u);
+    EXPECT_EQ(errors.last, errors::errc::rejected);
+    EXPECT_EQ(engine.reported.size(), 5u);
+    EXPECT_EQ(engine.portfolio_manager().trade_log().size(), 6u);
+}
+
+TEST(NoExceptionsTest, EmptyQueueAndUnknownOrderAreCodes)
+{
+    event_queue q;
+    event ev;
+    EXPECT_EQ(q.pop(ev), errors::errc::queue_empty);
+
+    orders::order_queue book;
+    EXPECT_EQ(book.inactive(42), errors::errc::unknown_order);
+    book.emplace(order_event{0, 42, 1, true, 100.0, order_type::Limit, order_flags::None});
+    EXPECT_EQ(book.inactive(42), errors::errc::ok);
+}
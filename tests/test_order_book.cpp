@@ -0,0 +1,418 @@
+#include <gtest/gtest.h>
+#include "orders/order_queue.hpp"
+#include "orders/price_level_book.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+using namespace engine::orders;
+
+namespace
+{
+    order_state order(order_id id, bool is_buy, double price, int64_t ts_ms, symbols::symbol_id symbol = 0)
+    {
+        return order_state{order_event{symbol, id, 10, is_buy, price, order_type::Limit, order_flags::None,
+                                       std::chrono::system_clock::time_point{std::chrono::milliseconds{ts_ms}}}};
+    }
+
+    std::vector<order_id> side_ids(const price_level_book &book, bool is_buy)
+    {
+        std::vector<order_id> ids;
+        book.for_each(is_buy, [&](const order_state &st)
+                      { ids.push_back(st.order_.order_id_); return true; });
+        return ids;
+    }
+} // namespace
+
+TEST(PriceLevelBookTest, OrdersByPriceThenTime)
+{
+    order_pool pool;
+    price_level_book book{pool};
+    book.insert(order(1, true, 100.0, 5));
+    book.insert(order(2, true, 101.0, 6));
+    book.insert(order(3, true, 100.0, 1)); // earlier timestamp goes ahead at its level
+    book.insert(order(4, true, 100.0, 5)); // equal timestamp goes behind
+    book.insert(order(5, false, 103.0, 1));
+    book.insert(order(6, false, 102.0, 2));
+    book.insert(order(7, false, 103.0, 0));
+
+    EXPECT_EQ(side_ids(book, true), (std::vector<order_id>{2, 3, 1, 4}));
+    EXPECT_EQ(side_ids(book, false), (std::vector<order_id>{6, 7, 5}));
+    EXPECT_EQ(book.best_bid().order_.order_id_, 2u);
+    EXPECT_EQ(book.best_ask().order_.order_id_, 6u);
+    EXPECT_EQ(book.bid_levels(), 2u);
+    EXPECT_EQ(book.ask_levels(), 2u);
+    EXPECT_EQ(book.size(), 7u);
+}
+
+TEST(PriceLevelBookTest, EraseDropsEmptyLevelsAndReusesNodes)
+{
+    order_pool pool;
+    price_level_book book{pool};
+    const auto a = book.insert(order(1, true, 101.0, 1));
+    const auto b = book.insert(order(2, true, 100.0, 2));
+    const auto c = book.insert(order(3, true, 100.0, 3));
+
+    book.erase(a);
+    EXPECT_EQ(book.bid_levels(), 1u);
+    EXPECT_EQ(book.best_bid().order_.order_id_, 2u);
+
+    // Middle of a level, then the rest of it
+    const auto d = book.insert(order(4, true, 100.0, 4));
+    book.erase(c);
+    EXPECT_EQ(side_ids(book, true), (std::vector<order_id>{2, 4}));
+    book.erase(b);
+    book.erase(d);
+    EXPECT_TRUE(book.empty());
+    EXPECT_EQ(book.bid_levels(), 0u);
+
+    // Slab nodes are recycled in place
+    const auto e = book.insert(order(5, true, 99.0, 5));
+    EXPECT_TRUE(e == a || e == b || e == c || e == d);
+    book.insert(order(6, true, 99.5, 6));
+    EXPECT_EQ(book.best_bid().order_.order_id_, 6u);
+    EXPECT_EQ(side_ids(book, true), (std::vector<order_id>{6, 5}));
+}
+
+TEST(PriceLevelBookTest, WalkSurvivesErasingWorseLevels)
+{
+    order_pool pool;
+    price_level_book book{pool};
+    book.insert(order(1, true, 101.0, 1));
+    const auto own = book.insert(order(2, true, 100.0, 2));
+    const auto worse = book.insert(order(3, true, 99.0, 3));
+    book.insert(order(4, true, 98.0, 4));
+    const auto ask = book.insert(order(5, false, 102.0, 5));
+    const auto worse_ask = book.insert(order(6, false, 103.0, 6));
+    book.insert(order(7, false, 104.0, 7));
+
+    // The best level empties a worse one, the next drops itself, so the ladder shifts under the walk
+    std::vector<order_id> seen;
+    EXPECT_TRUE(book.for_each(true, [&](order_state &st)
+                              {
+                                  seen.push_back(st.order_.order_id_);
+                                  if (st.order_.order_id_ == 1) book.erase(worse);
+                                  if (st.order_.order_id_ == 2) book.erase(own);
+                                  return true; }));
+    EXPECT_EQ(seen, (std::vector<order_id>{1, 2, 4}));
+    EXPECT_EQ(side_ids(book, true), (std::vector<order_id>{1, 4}));
+
+    seen.clear();
+    EXPECT_TRUE(book.for_each_crossing(false, book.scale().to_ticks(104.0), [&](order_state &st)
+                                       {
+                                           seen.push_back(st.order_.order_id_);
+                                           if (st.order_.order_id_ == 5) { book.erase(worse_ask); book.erase(ask); }
+                                           return true; }));
+    EXPECT_EQ(seen, (std::vector<order_id>{5, 7}));
+    EXPECT_EQ(side_ids(book, false), (std::vector<order_id>{7}));
+}
+
+TEST(PriceLevelBookTest, AddressesSurviveGrowthAndClearKeepsCapacity)
+{
+    order_pool pool;
+    price_level_book book{pool};
+    const auto first = book.insert(order(1, false, 50.0, 0));
+    const auto *resting = &book.at(first);
+    for (order_id id = 2; id < 5000; ++id)
+    {
+        book.insert(order(id, id % 2 == 0, 50.0 + static_cast<double>(id % 97), static_cast<int64_t>(id)));
+    }
+    EXPECT_EQ(&book.at(first), resting);
+    EXPECT_EQ(resting->order_.order_id_, 1u);
+
+    book.clear();
+    EXPECT_TRUE(book.empty());
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(book.ask_levels(), 0u);
+    book.insert(order(9, false, 10.0, 0));
+    EXPECT_EQ(book.best_ask().order_.order_id_, 9u);
+}
+
+TEST(PriceLevelBookTest, OrderQueueReplacesAndInactivatesThroughBook)
+{
+    order_queue q;
+    q.emplace(order(1, true, 100.0, 1));
+    q.emplace(order(2, false, 101.0, 1));
+    q.emplace(order(1, true, 99.0, 2)); // replaces the resting order 1
+
+    ASSERT_NE(q.get(1), nullptr);
+    EXPECT_DOUBLE_EQ(q.get(1)->order_.price_, 99.0);
+    EXPECT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.book(0)->bid_levels(), 1u);
+
+    q.get(2)->filled_qty_ = 3;
+    EXPECT_EQ(q.inactive(2), errors::errc::ok);
+    EXPECT_EQ(q.inactive(2), errors::errc::unknown_order);
+    EXPECT_EQ(q.get(2), nullptr);
+    EXPECT_EQ(q.size(), 1u);
+    EXPECT_EQ(q.book(0)->ask_levels(), 0u);
+}
+
+TEST(PriceLevelBookTest, OrderQueueKeepsABookPerSymbol)
+{
+    order_queue q;
+    q.emplace(order(1, true, 100.0, 1, 0));
+    q.emplace(order(2, true, 50.0, 1, 1));
+    q.emplace(order(3, true, 101.0, 2, 0));
+    q.emplace(order(4, false, 51.0, 2, 1));
+    q.emplace(order(5, false, 7.0, 3, symbols::invalid_symbol));
+
+    EXPECT_EQ(q.size(), 5u);
+    EXPECT_EQ(q.size(0), 2u);
+    EXPECT_EQ(q.size(1), 2u);
+    EXPECT_EQ(q.size(2), 0u);
+    EXPECT_EQ(q.book(2), nullptr);
+    EXPECT_EQ(q.best_bid(0).order_.order_id_, 3u);
+    EXPECT_EQ(q.best_bid(1).order_.order_id_, 2u);
+    EXPECT_EQ(q.best_ask(1).order_.order_id_, 4u);
+
+    // A walk only sees its own instrument
+    std::vector<order_id> seen;
+    q.for_each_pruned(1, [&](const order_state &st)
+                      { seen.push_back(st.order_.order_id_); return true; });
+    EXPECT_EQ(seen, (std::vector<order_id>{2, 4}));
+
+    EXPECT_EQ(q.inactive(3), errors::errc::ok);
+    EXPECT_EQ(q.best_bid(0).order_.order_id_, 1u);
+    EXPECT_EQ(q.best_bid(1).order_.order_id_, 2u);
+
+    // Books come back per symbol from a snapshot
+    checkpoint::snapshot_writer out;
+    q.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    order_queue restored;
+    restored.emplace(order(9, true, 1.0, 0, 3));
+    restored.restore(in);
+    EXPECT_EQ(restored.size(), 4u);
+    EXPECT_EQ(restored.get(9), nullptr);
+    EXPECT_EQ(restored.size(3), 0u);
+    EXPECT_EQ(restored.size(0), 1u);
+    EXPECT_EQ(restored.size(1), 2u);
+    EXPECT_EQ(restored.size(symbols::invalid_symbol), 1u);
+    EXPECT_EQ(restored.best_ask(1).order_.order_id_, 4u);
+}
+
+TEST(PriceLevelBookTest, PricesRoundToTicksAndShareLevels)
+{
+    const tick_scale cents{0.01};
+    EXPECT_EQ(cents.to_ticks(100.01), 10001);
+    EXPECT_EQ(cents.to_ticks(0.1 + 0.2), cents.to_ticks(0.3));
+    EXPECT_EQ(cents.to_ticks(1.004), 100);
+    EXPECT_DOUBLE_EQ(cents.to_price(10001), 100.01);
+    EXPECT_THROW(tick_scale{0.0}, std::invalid_argument);
+
+    // Doubles that differ in the last bit still rest at one level
+    order_pool pool;
+    price_level_book book{pool, cents};
+    book.insert(order(1, true, 0.1 + 0.2, 1));
+    book.insert(order(2, true, 0.3, 2));
+    EXPECT_EQ(book.bid_levels(), 1u);
+    EXPECT_EQ(book.best_bid_ticks(), 30);
+    EXPECT_EQ(side_ids(book, true), (std::vector<order_id>{1, 2}));
+}
+
+TEST(PriceLevelBookTest, CrossingWalkStopsBeyondThePrice)
+{
+    order_pool pool;
+    price_level_book book{pool, tick_scale{0.5}};
+    book.insert(order(1, false, 101.0, 1));
+    book.insert(order(2, false, 100.5, 2));
+    book.insert(order(3, false, 102.0, 3));
+    book.insert(order(4, false, 101.0, 4));
+    book.insert(order(5, true, 99.0, 5));
+    book.insert(order(6, true, 100.0, 6));
+
+    std::vector<order_id> seen;
+    auto collect = [&](const order_state &st)
+    { seen.push_back(st.order_.order_id_); return true; };
+    EXPECT_TRUE(book.for_each_crossing(false, book.scale().to_ticks(101.0), collect));
+    EXPECT_EQ(seen, (std::vector<order_id>{2, 1, 4}));
+
+    seen.clear();
+    book.for_each_crossing(true, book.scale().to_ticks(99.5), collect);
+    EXPECT_EQ(seen, (std::vector<order_id>{6}));
+
+    seen.clear();
+    book.for_each_crossing(true, book.scale().to_ticks(100.5), collect);
+    EXPECT_TRUE(seen.empty());
+}
+
+TEST(PriceLevelBookTest, WalksSurviveCallbacksChangingTheLadder)
+{
+    order_pool pool;
+    price_level_book book{pool};
+    std::vector<price_level_book::handle> handles;
+    for (order_id id = 1; id <= 4; ++id)
+    {
+        handles.push_back(book.insert(order(id, false, 100.0 + static_cast<double>(id), 1)));
+    }
+
+    // Filling each order drops its level, the first also rests a better one, which the walk
+    // has already passed
+    std::vector<order_id> seen;
+    EXPECT_TRUE(book.for_each_crossing(false, book.scale().to_ticks(103.0), [&](const order_state &st)
+                                       {
+        const auto id = st.order_.order_id_;
+        seen.push_back(id);
+        book.erase(handles[id - 1]);
+        if (id == 1)
+            handles.push_back(book.insert(order(5, false, 100.0, 2)));
+        return true; }));
+    EXPECT_EQ(seen, (std::vector<order_id>{1, 2, 3}));
+    EXPECT_EQ(side_ids(book, false), (std::vector<order_id>{5, 4}));
+    EXPECT_EQ(book.ask_levels(), 2u);
+
+    seen.clear();
+    handles.push_back(book.insert(order(6, false, 99.0, 3)));
+    EXPECT_TRUE(book.for_each(false, [&](const order_state &st)
+                              {
+        seen.push_back(st.order_.order_id_);
+        if (st.order_.order_id_ != 5)
+            book.erase(handles[st.order_.order_id_ - 1]);
+        return true; }));
+    EXPECT_EQ(seen, (std::vector<order_id>{6, 5, 4}));
+    EXPECT_EQ(side_ids(book, false), (std::vector<order_id>{5}));
+}
+
+TEST(PriceLevelBookTest, OrderQueueTickSizesPerSymbolSurviveSnapshots)
+{
+    order_queue q;
+    q.set_tick_size(0, 0.25);
+    q.emplace(order(1, true, 100.1, 1, 0)); // rounds to 100.0
+    q.emplace(order(2, true, 100.0, 2, 0));
+    q.emplace(order(3, true, 100.1, 3, 1)); // default tick keeps the levels apart
+    q.emplace(order(4, true, 100.0, 4, 1));
+    EXPECT_EQ(q.book(0)->bid_levels(), 1u);
+    EXPECT_EQ(q.book(1)->bid_levels(), 2u);
+    EXPECT_THROW(q.set_tick_size(0, 0.5), std::logic_error);
+    q.set_tick_size(2, 0.5);
+
+    std::vector<order_id> seen;
+    q.for_each_crossing(0, true, 99.9, [&](const order_state &st)
+                        { seen.push_back(st.order_.order_id_); return true; });
+    EXPECT_EQ(seen, (std::vector<order_id>{1, 2}));
+
+    checkpoint::snapshot_writer out;
+    q.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    order_queue restored;
+    restored.restore(in);
+    EXPECT_DOUBLE_EQ(restored.book(0)->scale().tick_size(), 0.25);
+    EXPECT_DOUBLE_EQ(restored.book(2)->scale().tick_size(), 0.5);
+    EXPECT_EQ(restored.book(0)->bid_levels(), 1u);
+    EXPECT_EQ(restored.size(1), 2u);
+}
+
+TEST(PriceLevelBookTest, BooksShareOnePool)
+{
+    order_pool pool;
+    price_level_book a{pool};
+    price_level_book b{pool};
+    const auto first = a.insert(order(1, true, 10.0, 1));
+    const auto second = b.insert(order(2, true, 20.0, 1));
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool.size(), 2u);
+
+    // Unlinked orders stay pooled until released
+    a.unlink(first);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(pool.at(first).order_.order_id_, 1u);
+    pool.release(first);
+    EXPECT_EQ(pool.size(), 1u);
+
+    // The released slot is reused in place, and can be linked into another book
+    const auto *slot = &pool.at(first);
+    const auto third = pool.acquire(order(3, true, 21.0, 2));
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(&pool.at(third), slot);
+    b.link(third);
+    EXPECT_EQ(b.best_bid().order_.order_id_, 3u);
+    EXPECT_EQ(pool.capacity(), 2u);
+}
+
+TEST(PriceLevelBookTest, OrderQueueRetiresOrdersIntoLedger)
+{
+    order_queue q{order_queue::ledger_capacity};
+    q.emplace(order(1, true, 100.0, 1));
+    auto *resting = q.get(1);
+    resting->filled_qty_ = 10;
+
+    EXPECT_EQ(q.inactive(1), errors::errc::ok);
+    EXPECT_EQ(q.get(1), nullptr);
+    ASSERT_NE(q.retired(1), nullptr);
+    EXPECT_EQ(q.retired(1)->filled_qty_, 10);
+    EXPECT_EQ(q.ledger_size(), 1u);
+
+    // The retired order's slot is released at once, the next insert reuses it
+    q.emplace(order(5000, true, 99.0, 5000));
+    EXPECT_EQ(q.get(5000), resting);
+    EXPECT_EQ(q.retired(1)->filled_qty_, 10);
+    q.inactive(5000);
+
+    // A full ledger overwrites its oldest entry
+    for (order_id id = 2; id <= order_queue::ledger_capacity; ++id)
+    {
+        q.emplace(order(id, false, 101.0, static_cast<int64_t>(id)));
+        q.inactive(id);
+    }
+    EXPECT_EQ(q.ledger_size(), order_queue::ledger_capacity);
+    EXPECT_EQ(q.retired(1), nullptr);
+    EXPECT_NE(q.retired(5000), nullptr);
+
+    order_id oldest = 0;
+    q.for_each_retired([&](const order_state &st)
+                       { if (oldest == 0) { oldest = st.order_.order_id_; } });
+    EXPECT_EQ(oldest, 5000u);
+}
+
+TEST(PriceLevelBookTest, OrderQueueRestingOrderIsNotRetired)
+{
+    order_queue q{order_queue::ledger_capacity};
+    q.emplace(order(1, true, 100.0, 1));
+    q.inactive(1);
+    ASSERT_NE(q.retired(1), nullptr);
+
+    // Resting again under the same ID, e.g. after a restore, hides the retired state
+    q.emplace(order(1, true, 101.0, 2));
+    EXPECT_NE(q.get(1), nullptr);
+    EXPECT_EQ(q.retired(1), nullptr);
+
+    // Retiring it again finds the newer state, and the older ledger entry aging out keeps it
+    q.inactive(1);
+    ASSERT_NE(q.retired(1), nullptr);
+    EXPECT_DOUBLE_EQ(q.retired(1)->order_.price_, 101.0);
+    for (order_id id = 2; id < order_queue::ledger_capacity + 1; ++id)
+    {
+        q.emplace(order(id, false, 102.0, static_cast<int64_t>(id)));
+        q.inactive(id);
+    }
+    ASSERT_NE(q.retired(1), nullptr);
+    EXPECT_DOUBLE_EQ(q.retired(1)->order_.price_, 101.0);
+}
+
+TEST(PriceLevelBookTest, OrderQueueLedgerDepthIsBounded)
+{
+    // No ledger by default, an order leaving its book is gone
+    order_queue bare;
+    EXPECT_EQ(bare.ledger_depth(), 0u);
+    bare.emplace(order(1, true, 100.0, 1));
+    EXPECT_EQ(bare.inactive(1), errors::errc::ok);
+    EXPECT_EQ(bare.retired(1), nullptr);
+    EXPECT_EQ(bare.ledger_size(), 0u);
+
+    // A shallow ledger keeps only its newest orders
+    order_queue shallow{2};
+    for (order_id id = 1; id <= 3; ++id)
+    {
+        shallow.emplace(order(id, true, 100.0, static_cast<int64_t>(id)));
+        shallow.inactive(id);
+    }
+    EXPECT_EQ(shallow.ledger_size(), 2u);
+    EXPECT_EQ(shallow.retired(1), nullptr);
+    EXPECT_NE(shallow.retired(2), nullptr);
+    EXPECT_NE(shallow.retired(3), nullptr);
+
+    EXPECT_THROW(order_queue{order_queue::ledger_capacity + 1}, std::invalid_argument);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "orders/client_id_map.hpp"
+#include "orders/order_id_generator.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace engine::events;
+using namespace engine::orders;
+
+TEST(OrderIdGeneratorTest, IssuesIncreasingIdsOnOneThread)
+{
+    order_id_generator gen{4};
+    order_id prev = gen.next();
+    EXPECT_NE(prev, invalid_order_id);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        auto id = gen.next();
+        EXPECT_GT(id, prev);
+        prev = id;
+    }
+}
+
+TEST(OrderIdGeneratorTest, UniqueAcrossThreads)
+{
+    order_id_generator gen{16};
+    constexpr size_t threads = 4;
+    constexpr size_t per_thread = 5000;
+    std::vector<std::vector<order_id>> issued(threads);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]
+                             {
+            for (size_t i = 0; i < per_thread; ++i)
+            {
+                issued[t].push_back(gen.next());
+            } });
+    }
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+
+    std::vector<order_id> all;
+    for (const auto &v : issued)
+    {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+    EXPECT_EQ(std::count(all.begin(), all.end(), invalid_order_id), 0);
+}
+
+TEST(OrderIdGeneratorTest, SeparateGeneratorsDontShareRanges)
+{
+    order_id_generator a{1024, 1};
+    order_id_generator b{1024, 1'000'000};
+
+    EXPECT_EQ(a.next(), 1u);
+    EXPECT_EQ(b.next(), 1'000'000u);
+    EXPECT_EQ(a.next(), 1025u); // thread range was reclaimed after switching generator
+}
+
+TEST(ClientIdMapTest, BindAndLookupBothWays)
+{
+    client_id_map map;
+    EXPECT_TRUE(map.bind("client-1", 7));
+
+    EXPECT_EQ(map.find("client-1"), 7u);
+    EXPECT_EQ(map.client(7), "client-1");
+    EXPECT_EQ(map.find("missing"), invalid_order_id);
+    EXPECT_TRUE(map.client(8).empty());
+}
+
+TEST(ClientIdMapTest, RejectsDuplicateBindings)
+{
+    client_id_map map;
+    EXPECT_TRUE(map.bind("client-1", 7));
+    EXPECT_FALSE(map.bind("client-1", 8));
+    EXPECT_FALSE(map.bind("client-2", 7));
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(ClientIdMapTest, EraseRemovesBothSides)
+{
+    client_id_map map;
+    map.bind("client-1", 7);
+    map.erase(7);
+
+    EXPECT_EQ(map.find("client-1"), invalid_order_id);
+    EXPECT_TRUE(map.client(7).empty());
+    EXPECT_EQ(map.size(), 0u);
+}
@@ -1,24 +1,18 @@
 #include <gtest/gtest.h>
 #include "portfolio/portfolio_manager.hpp"
 #include "events/event.hpp"
+#include "events/payload_store.hpp"
 
 using namespace engine::events;
 using namespace engine::portfolio;
 
+// interned symbol id used throughout
+constexpr engine::symbols::symbol_id BTC = 0;
+
 // compare doubles with tolerance
 constexpr double EPS = 1e-9;
 #define EXPECT_NEAR_EQ(val, expected) EXPECT_NEAR((val), (expected), EPS)
 
-static order_event order{"BTCUSD",
-                     "order",
-                     2,
-                     false,
-                     200.0,
-                     order_type::Market,
-                     order_flags::None,
-                     std::chrono::system_clock::now(),
-                     market_event{"BTCUSD", 200.0, 2, 1, false}};
-
 TEST(PortfolioTest, InitialState)
 {
     portfolio_manager pf(100000.0);
@@ -33,22 +27,22 @@ TEST(PortfolioTest, InitialState)
 TEST(PortfolioTest, OpensLongCorrectly)
 {
     portfolio_manager pf(1000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, true, 100.0, order}); // buy 10 @ 100
+    pf.on_fill(fill_event{BTC, 1, 10, 10, true, 100.0}); // buy 10 @ 100
 
     EXPECT_NEAR_EQ(pf.cash_balance(), 0.0);
-    EXPECT_EQ(pf.position("BTCUSD").quantity, 10);
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 100.0);
+    EXPECT_EQ(pf.position(BTC).quantity, 10);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 100.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 0.0);
 }
 
 TEST(PortfolioTest, AddsToLongAveragesPrice)
 {
     portfolio_manager pf(3000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, true, 100.0, order});
-    pf.on_fill(fill_event{"BTCUSD", "2", 10, 10, true, 120.0, order}); // avg to 110
+    pf.on_fill(fill_event{BTC, 1, 10, 10, true, 100.0});
+    pf.on_fill(fill_event{BTC, 2, 10, 10, true, 120.0}); // avg to 110
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, 20);
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 110.0);
+    EXPECT_EQ(pf.position(BTC).quantity, 20);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 110.0);
     EXPECT_NEAR_EQ(pf.cash_balance(), 800.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 0.0);
 }
@@ -56,85 +50,85 @@ TEST(PortfolioTest, AddsToLongAveragesPrice)
 TEST(PortfolioTest, ReducesLongRealizesPnL)
 {
     portfolio_manager pf(5000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 20, 20, true, 100.0, order}); // long 20 @ 100
-    pf.on_fill(fill_event{"BTCUSD", "2", 5, 5, false, 130.0, order});  // sell 5 @ 130
+    pf.on_fill(fill_event{BTC, 1, 20, 20, true, 100.0}); // long 20 @ 100
+    pf.on_fill(fill_event{BTC, 2, 5, 5, false, 130.0});  // sell 5 @ 130
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, 15);
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 100.0);
+    EXPECT_EQ(pf.position(BTC).quantity, 15);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 100.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 150.0); // 5*(130-100)
 }
 
 TEST(PortfolioTest, ClosesLongResetsPosition)
 {
     portfolio_manager pf(2000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 20, 20, true, 100.0, order});
-    pf.on_fill(fill_event{"BTCUSD", "2", 20, 20, false, 90.0, order}); // sell all
+    pf.on_fill(fill_event{BTC, 1, 20, 20, true, 100.0});
+    pf.on_fill(fill_event{BTC, 2, 20, 20, false, 90.0}); // sell all
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, 0);
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 0.0);
+    EXPECT_EQ(pf.position(BTC).quantity, 0);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 0.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), -200.0); // 20*(90-100)
 }
 
 TEST(PortfolioTest, FlipsLongToShort)
 {
     portfolio_manager pf(2000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, true, 100.0, order});
-    pf.on_fill(fill_event{"BTCUSD", "2", 15, 15, false, 110.0, order}); // sell 15
+    pf.on_fill(fill_event{BTC, 1, 10, 10, true, 100.0});
+    pf.on_fill(fill_event{BTC, 2, 15, 15, false, 110.0}); // sell 15
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, -5); // now short 5
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 110.0);
+    EXPECT_EQ(pf.position(BTC).quantity, -5); // now short 5
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 110.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 100.0); // 10*(110-100)
 }
 
 TEST(PortfolioTest, OpensShortCorrectly)
 {
     portfolio_manager pf(2000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, false, 200.0, order}); // short 10 @ 200
+    pf.on_fill(fill_event{BTC, 1, 10, 10, false, 200.0}); // short 10 @ 200
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, -10);
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 200.0);
+    EXPECT_EQ(pf.position(BTC).quantity, -10);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 200.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 0.0);
 }
 
 TEST(PortfolioTest, CoversShortPartially)
 {
     portfolio_manager pf(4000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, false, 200.0, order}); // short 10
-    pf.on_fill(fill_event{"BTCUSD", "2", 5, 5, true, 180.0, order});    // buy 5
+    pf.on_fill(fill_event{BTC, 1, 10, 10, false, 200.0}); // short 10
+    pf.on_fill(fill_event{BTC, 2, 5, 5, true, 180.0});    // buy 5
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, -5);
+    EXPECT_EQ(pf.position(BTC).quantity, -5);
     EXPECT_NEAR_EQ(pf.realized_pnl(), 100.0); // 5*(200-180)
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 200.0);
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 200.0);
 }
 
 TEST(PortfolioTest, FlipsShortToLong)
 {
     portfolio_manager pf(4000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, false, 200.0, order}); // short 10
-    pf.on_fill(fill_event{"BTCUSD", "2", 15, 15, true, 210.0, order});  // buy 15
+    pf.on_fill(fill_event{BTC, 1, 10, 10, false, 200.0}); // short 10
+    pf.on_fill(fill_event{BTC, 2, 15, 15, true, 210.0});  // buy 15
 
-    EXPECT_EQ(pf.position("BTCUSD").quantity, 5); // now long 5
-    EXPECT_NEAR_EQ(pf.position("BTCUSD").avg_price, 210.0);
+    EXPECT_EQ(pf.position(BTC).quantity, 5); // now long 5
+    EXPECT_NEAR_EQ(pf.position(BTC).avg_price, 210.0);
     EXPECT_NEAR_EQ(pf.realized_pnl(), -100.0); // 10*(210-200)
 }
 
 TEST(PortfolioTest, AppliesCommission)
 {
     portfolio_manager pf(1000.0, 0.01);                 // 1% commission
-    pf.on_fill(fill_event{"BTCUSD", "1", 1, 1, true, 100.0, order});
+    pf.on_fill(fill_event{BTC, 1, 1, 1, true, 100.0});
 
     double trade_value = 100.0;
     double commission  = trade_value * 0.01; // 1.0
 
-    EXPECT_NEAR(pf.position("BTCUSD").avg_price, 100.0, 1e-9);
+    EXPECT_NEAR(pf.position(BTC).avg_price, 100.0, 1e-9);
     EXPECT_NEAR(pf.cash_balance(), 1000.0 - trade_value - commission, 1e-9);
 }
 
 TEST(PortfolioTest, UnrealizedPnLTracksMarket)
 {
     portfolio_manager pf(2000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 10, 10, true, 100.0, order});
-    pf.on_market("BTCUSD", 110.0, 1); // mark to market
+    pf.on_fill(fill_event{BTC, 1, 10, 10, true, 100.0});
+    pf.on_market(BTC, 110.0, 1); // mark to market
 
     EXPECT_NEAR_EQ(pf.unrealized_pnl(), 100.0); // 10*(110-100)
     EXPECT_NEAR_EQ(pf.total_equity(), 2100.0);  // cash=1000 + pos=1100
@@ -143,11 +137,11 @@ TEST(PortfolioTest, UnrealizedPnLTracksMarket)
 TEST(PortfolioTest, TradeLogRecordsFills)
 {
     portfolio_manager pf(1000.0);
-    pf.on_fill(fill_event{"BTCUSD", "1", 1, 1, true, 100.0, order});
-    pf.on_fill(fill_event{"BTCUSD", "2", 1, 1, false, 120.0, order});
+    pf.on_fill(fill_event{BTC, 1, 1, 1, true, 100.0});
+    pf.on_fill(fill_event{BTC, 2, 1, 1, false, 120.0});
 
     ASSERT_EQ(pf.trade_log().size(), 2);
-    EXPECT_EQ(pf.trade_log()[0].symbol_, "BTCUSD");
+    EXPECT_EQ(pf.trade_log()[0].symbol_, BTC);
     EXPECT_TRUE(pf.trade_log()[0].is_buy_);
     EXPECT_FALSE(pf.trade_log()[1].is_buy_);
 }
@@ -155,15 +149,31 @@ TEST(PortfolioTest, TradeLogRecordsFills)
 TEST(PortfolioTest, TracksCancels) {
     engine::portfolio::portfolio_manager pf(10000.0);
 
-    order_event order{"BTCUSD", "ord_cancel", 5, true, 100.0, order_type::Limit, order_flags::FOK};
+    payload_store payloads;
+    order_event order{BTC, 42, 5, true, 100.0, order_type::Limit, order_flags::FOK};
     cancel_event cancel{
         order,
-        "IOC remainder cancelled"};
+        payloads.retain(order),
+        payloads.intern_reason("IOC remainder cancelled")};
 
     pf.on_cancel(cancel);
 
     EXPECT_EQ(pf.cancel_count(), 1);
     const auto ids = pf.cancelled_order_ids();
     ASSERT_EQ(ids.size(), 1);
-    EXPECT_EQ(ids[0], "ord_cancel");
+    EXPECT_EQ(ids[0], 42u);
+}
+
+TEST(PortfolioTest, IgnoresInvalidSymbol)
+{
+    portfolio_manager pf(1000.0);
+    pf.on_market(engine::symbols::invalid_symbol, 110.0, 1);
+    pf.on_fill(fill_event{engine::symbols::invalid_symbol, 1, 10, 10, true, 100.0});
+
+    // Neither grows the symbol table nor touches cash
+    EXPECT_NEAR_EQ(pf.cash_balance(), 1000.0);
+    EXPECT_NEAR_EQ(pf.total_equity(), 1000.0);
+    EXPECT_EQ(pf.position(engine::symbols::invalid_symbol).quantity, 0);
+    EXPECT_NEAR_EQ(pf.last_price(engine::symbols::invalid_symbol), 0.0);
+    EXPECT_EQ(pf.trade_log().size(), 0);
 }
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+#include "engine_base.hpp"
+#include "reactor/reactor.hpp"
+
+#include <deque>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+using namespace std::chrono_literals;
+
+namespace
+{
+    reactor::task sleeper(reactor::reactor &r, std::chrono::milliseconds d, int id, std::vector<int> &order)
+    {
+        co_await r.sleep_for(d);
+        order.push_back(id);
+    }
+
+    reactor::task wait_signal(reactor::reactor &r, reactor::event_signal &sig, std::chrono::nanoseconds timeout, reactor::wait_result &out)
+    {
+        out = co_await r.readable(sig.poll_fd(), timeout);
+    }
+
+    struct live_tick
+    {
+        std::string symbol;
+        double price;
+        double qty;
+        int64_t timestamp_ms;
+        bool is_buyer_match;
+    };
+
+    // Live feed, readable while ticks are queued
+    struct SignalStreamer
+    {
+        std::deque<live_tick> *ticks;
+        reactor::event_signal *signal;
+
+        std::optional<live_tick> next()
+        {
+            if (ticks->empty())
+            {
+                signal->consume();
+                return std::nullopt;
+            }
+            auto t = ticks->front();
+            ticks->pop_front();
+            return t;
+        }
+
+        int poll_fd() const { return signal->poll_fd(); }
+    };
+
+    struct OrderPerTick
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            q.push(order_event{ev.symbol_, static_cast<order_id>(ev.timestamp_ms_ + 1), 1, true, ev.price_, order_type::Limit, order_flags::None});
+        }
+        void on_fill(const fill_event &) { ++fills; }
+
+        size_t fills = 0;
+    };
+
+    // Venue session, orders are acknowledged with a fill once the session becomes readable
+    struct AsyncVenue
+    {
+        reactor::event_signal *acks;
+        std::vector<order_event> pending;
+
+        void on_order(const order_event &order, event_queue &) { pending.push_back(order); }
+
+        int poll_fd() const { return acks->poll_fd(); }
+
+        void on_readable(event_queue &q)
+        {
+            acks->consume();
+            for (const auto &order : pending)
+            {
+                q.push(fill_event{order.symbol_, order.order_id_, order.quantity_, order.quantity_, order.is_buy_, order.price_, q.payloads().retain(order)});
+            }
+            pending.clear();
+        }
+    };
+
+    struct AsyncEngine : engine_base<AsyncEngine, SignalStreamer, OrderPerTick, AsyncVenue>
+    {
+        using engine_base<AsyncEngine, SignalStreamer, OrderPerTick, AsyncVenue>::engine_base;
+        bool should_stop() { return stop; }
+        bool handle_no_event() { return true; }
+
+        bool stop = false;
+    };
+
+    reactor::task cancel_after(reactor::reactor &r, std::chrono::milliseconds d, int fd)
+    {
+        co_await r.sleep_for(d);
+        EXPECT_TRUE(r.cancel(fd));
+        EXPECT_FALSE(r.cancel(fd));
+    }
+
+    reactor::task fail_after_yield(reactor::reactor &r)
+    {
+        co_await r.yield();
+        throw std::runtime_error("task failed");
+    }
+
+    // Feeds three ticks, acknowledges the orders they caused, then stops the engine
+    reactor::task drive_engine(reactor::reactor &r, AsyncEngine &engine, std::deque<live_tick> &ticks,
+                               reactor::event_signal &feed, reactor::event_signal &acks)
+    {
+        for (int64_t i = 0; i < 3; ++i)
+        {
+            co_await r.sleep_for(1ms);
+            ticks.push_back({"BTCUSD", 100.0, 1.0, i, false});
+            feed.notify();
+        }
+        co_await r.sleep_for(1ms);
+        EXPECT_EQ(engine.exec_handler().pending.size(), 3u);
+        EXPECT_EQ(engine.strategy().fills, 0u);
+
+        acks.notify();
+        co_await r.sleep_for(1ms);
+        engine.stop = true;
+    }
+
+    // Stops the engine with its feed and venue readable at once, so both wake in one poll
+    reactor::task stop_with_both_ready(reactor::reactor &r, AsyncEngine &engine, reactor::event_signal &feed,
+                                       reactor::event_signal &acks)
+    {
+        co_await r.sleep_for(1ms);
+        engine.stop = true;
+        feed.notify();
+        acks.notify();
+    }
+} // namespace
+
+TEST(ReactorTest, TimersFireInDeadlineOrder)
+{
+    reactor::reactor r;
+    std::vector<int> order;
+    r.spawn(sleeper(r, 6ms, 3, order));
+    r.spawn(sleeper(r, 2ms, 1, order));
+    r.spawn(sleeper(r, 4ms, 2, order));
+    r.spawn(sleeper(r, 0ms, 0, order));
+    r.run();
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(r.live_tasks(), 0u);
+}
+
+TEST(ReactorTest, ReadableWakesOnSignalFromAnotherThread)
+{
+    reactor::reactor r;
+    reactor::event_signal sig;
+    auto result = reactor::wait_result::timeout;
+    r.spawn(wait_signal(r, sig, std::chrono::nanoseconds::max(), result));
+
+    std::jthread notifier([&]
+                          {
+        std::this_thread::sleep_for(2ms);
+        sig.notify(); });
+    r.run();
+
+    EXPECT_EQ(result, reactor::wait_result::ready);
+    EXPECT_EQ(sig.consume(), 1u);
+}
+
+TEST(ReactorTest, ReadableOnReusedDescriptor)
+{
+    reactor::reactor r;
+    int reused = -1;
+    {
+        reactor::event_signal first;
+        auto result = reactor::wait_result::timeout;
+        first.notify();
+        r.spawn(wait_signal(r, first, std::chrono::nanoseconds::max(), result));
+        r.run();
+        EXPECT_EQ(result, reactor::wait_result::ready);
+        reused = first.poll_fd();
+    }
+
+    // The lowest free number is handed out again, unknown to epoll since the close
+    reactor::event_signal second;
+    ASSERT_EQ(second.poll_fd(), reused);
+    auto result = reactor::wait_result::timeout;
+    second.notify();
+    r.spawn(wait_signal(r, second, std::chrono::nanoseconds::max(), result));
+    r.run();
+    EXPECT_EQ(result, reactor::wait_result::ready);
+}
+
+TEST(ReactorTest, ReadableTimesOutAndCancels)
+{
+    reactor::reactor r;
+    reactor::event_signal a;
+    reactor::event_signal b;
+    auto timed_out = reactor::wait_result::ready;
+    auto cancelled = reactor::wait_result::ready;
+    r.spawn(wait_signal(r, a, 1ms, timed_out));
+    r.spawn(wait_signal(r, b, std::chrono::nanoseconds::max(), cancelled));
+    r.spawn(cancel_after(r, 3ms, b.poll_fd()));
+    r.run();
+
+    EXPECT_EQ(timed_out, reactor::wait_result::timeout);
+    EXPECT_EQ(cancelled, reactor::wait_result::cancelled);
+}
+
+TEST(ReactorTest, TaskErrorStopsRunAndIsRethrown)
+{
+    reactor::reactor r;
+    reactor::event_signal never;
+    auto result = reactor::wait_result::ready;
+    r.spawn(wait_signal(r, never, std::chrono::nanoseconds::max(), result));
+    r.spawn(fail_after_yield(r));
+
+    EXPECT_THROW(r.run(), std::runtime_error);
+    EXPECT_EQ(r.live_tasks(), 1u);
+}
+
+TEST(ReactorTest, StopFromAnotherThread)
+{
+    reactor::reactor r;
+    reactor::event_signal never;
+    auto result = reactor::wait_result::ready;
+    r.spawn(wait_signal(r, never, std::chrono::nanoseconds::max(), result));
+
+    std::jthread stopper([&]
+                         {
+        std::this_thread::sleep_for(2ms);
+        r.stop(); });
+    r.run();
+    EXPECT_EQ(r.live_tasks(), 1u);
+}
+
+TEST(ReactorTest, EngineMultiplexesFeedVenueAndTimer)
+{
+    reactor::reactor r;
+    reactor::event_signal feed;
+    reactor::event_signal acks;
+    std::deque<live_tick> ticks;
+
+    AsyncEngine engine{SignalStreamer{&ticks, &feed}, OrderPerTick{}, portfolio::portfolio_manager{1000.0}, AsyncVenue{&acks, {}}};
+    r.spawn(engine.run_async(r));
+
+    // Timer coroutine on the same thread drives the feed and the venue
+    r.spawn(drive_engine(r, engine, ticks, feed, acks));
+
+    r.run();
+
+    EXPECT_EQ(r.live_tasks(), 0u);
+    EXPECT_EQ(engine.strategy().fills, 3u);
+    EXPECT_EQ(engine.portfolio_manager().position(engine.symbols().find("BTCUSD")).quantity, 3);
+    EXPECT_TRUE(engine.exec_handler().pending.empty());
+}
+
+TEST(ReactorTest, EngineStopsWithFeedAndVenueReadableTogether)
+{
+    reactor::reactor r;
+    reactor::event_signal feed;
+    reactor::event_signal acks;
+    std::deque<live_tick> ticks;
+
+    AsyncEngine engine{SignalStreamer{&ticks, &feed}, OrderPerTick{}, portfolio::portfolio_manager{1000.0}, AsyncVenue{&acks, {}}};
+    r.spawn(engine.run_async(r, 1s));
+    r.spawn(stop_with_both_ready(r, engine, feed, acks));
+
+    // Ends the run if the venue coroutine is left waiting
+    std::jthread watchdog([&](std::stop_token st)
+                          {
+        for (int i = 0; i < 200 && !st.stop_requested(); ++i)
+            std::this_thread::sleep_for(5ms);
+        if (!st.stop_requested())
+            r.stop(); });
+    r.run();
+    watchdog.request_stop();
+
+    EXPECT_EQ(r.live_tasks(), 0u);
+}
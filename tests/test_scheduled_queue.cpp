@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "events/scheduled_queue.hpp"
+
+#include <limits>
+#include <map>
+#include <random>
+
+using namespace engine::events;
+
+namespace
+{
+    market_event tick_at(int64_t ts)
+    {
+        return market_event{0, 0.0, 0.0, ts, false};
+    }
+
+    int64_t ts_of(const event &ev)
+    {
+        return std::get<market_event>(ev).timestamp_ms_;
+    }
+} // namespace
+
+TEST(ScheduledQueueTest, InitiallyEmpty)
+{
+    scheduled_queue q;
+    event ev;
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.pop(ev));
+}
+
+TEST(ScheduledQueueTest, PopsInTimestampOrder)
+{
+    scheduled_queue q;
+    for (int64_t due : {50, 10, 1000, 30, 7, 999999})
+    {
+        q.push(static_cast<uint64_t>(due), tick_at(due));
+    }
+
+    event ev;
+    int64_t last = 0;
+    size_t popped = 0;
+    while (q.pop(ev))
+    {
+        EXPECT_GE(ts_of(ev), last);
+        last = ts_of(ev);
+        ++popped;
+    }
+    EXPECT_EQ(popped, 6u);
+}
+
+TEST(ScheduledQueueTest, TiesPopInPushOrder)
+{
+    scheduled_queue q;
+    q.push(100, tick_at(1));
+    q.push(100, tick_at(2));
+    q.push(50, tick_at(0));
+    q.push(100, tick_at(3));
+
+    event ev;
+    for (int64_t expected = 0; expected < 4; ++expected)
+    {
+        ASSERT_TRUE(q.pop(ev));
+        EXPECT_EQ(ts_of(ev), expected);
+    }
+}
+
+TEST(ScheduledQueueTest, PopUntilRespectsDueTime)
+{
+    scheduled_queue q;
+    q.push(10, tick_at(10));
+    q.push(20, tick_at(20));
+
+    event ev;
+    EXPECT_FALSE(q.pop_until(5, ev));
+    EXPECT_EQ(q.next_due(), 10u);
+    ASSERT_TRUE(q.pop_until(15, ev));
+    EXPECT_EQ(ts_of(ev), 10);
+    EXPECT_FALSE(q.pop_until(15, ev));
+    EXPECT_EQ(q.size(), 1u);
+}
+
+TEST(ScheduledQueueTest, PastDueIsClampedToNow)
+{
+    scheduled_queue q;
+    q.push(100, tick_at(100));
+
+    event ev;
+    ASSERT_TRUE(q.pop(ev));
+    EXPECT_EQ(q.now(), 100u);
+
+    // Scheduling in the past delivers at now
+    q.push(40, tick_at(40));
+    EXPECT_EQ(q.next_due(), 100u);
+    ASSERT_TRUE(q.pop(ev));
+    EXPECT_EQ(ts_of(ev), 40);
+}
+
+TEST(ScheduledQueueTest, LookingAheadDoesNotDelayEarlierEvents)
+{
+    scheduled_queue q;
+    q.push(1000, tick_at(1000));
+
+    // Checking a later event, without popping it, leaves now() where it was
+    event ev;
+    EXPECT_FALSE(q.pop_until(500, ev));
+    EXPECT_EQ(q.next_due(), 1000u);
+    EXPECT_EQ(q.now(), 0u);
+
+    // So an event scheduled afterwards, before it, is due at its own time
+    q.push(600, tick_at(600));
+    EXPECT_EQ(q.next_due(), 600u);
+    ASSERT_TRUE(q.pop_until(700, ev));
+    EXPECT_EQ(ts_of(ev), 600);
+    EXPECT_EQ(q.now(), 600u);
+    EXPECT_FALSE(q.pop_until(700, ev));
+
+    // Repeated looks between pops stay consistent
+    q.push(800, tick_at(800));
+    q.push(600, tick_at(601));
+    EXPECT_EQ(q.next_due(), 600u);
+    ASSERT_TRUE(q.pop_until(700, ev));
+    EXPECT_EQ(ts_of(ev), 601);
+    EXPECT_EQ(q.next_due(), 800u);
+    ASSERT_TRUE(q.pop(ev));
+    EXPECT_EQ(ts_of(ev), 800);
+    ASSERT_TRUE(q.pop(ev));
+    EXPECT_EQ(ts_of(ev), 1000);
+    EXPECT_EQ(q.next_due(), std::numeric_limits<uint64_t>::max());
+}
+
+TEST(ScheduledQueueTest, MatchesReferenceWithLookAheads)
+{
+    scheduled_queue q;
+    std::multimap<uint64_t, int64_t> reference;
+    std::mt19937_64 rng{3};
+    uint64_t now = 0;
+    int64_t serial = 0;
+    event ev;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        const auto op = rng() % 3;
+        if (op == 0)
+        {
+            const auto due = now + rng() % 1000;
+            q.push(due, tick_at(serial));
+            reference.emplace(due, serial++);
+        }
+        else
+        {
+            // Advance a clock that may stop short of the next event, as ticks do
+            const auto until = now + rng() % 200;
+            const bool due = !reference.empty() && reference.begin()->first <= until;
+            ASSERT_EQ(q.pop_until(until, ev), due);
+            if (due)
+            {
+                EXPECT_EQ(ts_of(ev), reference.begin()->second);
+                now = reference.begin()->first;
+                reference.erase(reference.begin());
+            }
+            else
+            {
+                now = until;
+            }
+            EXPECT_EQ(q.next_due(), reference.empty() ? std::numeric_limits<uint64_t>::max() : reference.begin()->first);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "engine_base.hpp"
+#include "execution_engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "sharding/sharded_runner.hpp"
+
+#include <set>
+#include <stdexcept>
+
+using namespace engine;
+using namespace engine::events;
+using namespace engine::sharding;
+
+namespace
+{
+    // Buys one unit per tick
+    struct BuyEveryTick
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            q.push(order_event{ev.symbol_, ++next_id, 1, true, ev.price_, order_type::Market, order_flags::None});
+        }
+
+        order_id next_id = 0;
+    };
+
+    // Fills every order in full at its price
+    struct FillAll : execution_engine_base<FillAll>
+    {
+        FillAll() = default;
+
+        void on_order(const order_event &order, event_queue &q)
+        {
+            ++orders_seen;
+            emit_fill(order, order.quantity_, order.price_, q);
+        }
+
+        size_t orders_seen = 0;
+    };
+
+    struct ShardEngine : engine_base<ShardEngine, shard_feed, BuyEveryTick, FillAll>
+    {
+        using engine_base<ShardEngine, shard_feed, BuyEveryTick, FillAll>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    auto make_shard(double cash)
+    {
+        return [cash](size_t, shard_feed feed)
+        {
+            return std::make_unique<ShardEngine>(std::move(feed), BuyEveryTick{}, portfolio::portfolio_manager{cash}, FillAll{});
+        };
+    }
+
+    ingest::tick_buffer make_ticks(size_t symbols, size_t per_symbol)
+    {
+        ingest::tick_buffer buffer;
+        for (size_t i = 0; i < per_symbol; ++i)
+        {
+            for (size_t s = 0; s < symbols; ++s)
+            {
+                buffer.add("SYM" + std::to_string(s), 10.0, 1.0, static_cast<int64_t>(i), false);
+            }
+        }
+        return buffer;
+    }
+} // namespace
+
+TEST(ShardedRunnerTest, EverySymbolRunsOnExactlyOneShard)
+{
+    constexpr size_t symbols = 8;
+    constexpr size_t per_symbol = 500;
+    auto ticks = make_ticks(symbols, per_symbol);
+
+    sharded_runner<ShardEngine> runner{shard_config{.shards = 3, .ring_capacity = 64}, make_shard(1000.0)};
+    runner.run(ticks);
+
+    std::set<std::string> seen;
+    size_t orders = 0;
+    for (size_t i = 0; i < runner.shard_count(); ++i)
+    {
+        const auto &engine = runner.shard(i);
+        orders += engine.exec_handler().orders_seen;
+        for (symbols::symbol_id id = 0; id < engine.symbols().size(); ++id)
+        {
+            const auto &name = engine.symbols().name(id);
+            EXPECT_TRUE(seen.insert(name).second) << name << " ran on two shards";
+            EXPECT_EQ(runner.shard_of(name), i);
+            EXPECT_EQ(engine.portfolio_manager().position(id).quantity, static_cast<int64_t>(per_symbol));
+        }
+    }
+    EXPECT_EQ(seen.size(), symbols);
+    EXPECT_EQ(orders, symbols * per_symbol);
+    EXPECT_EQ(runner.shard_of("UNKNOWN"), runner.shard_count());
+}
+
+TEST(ShardedRunnerTest, RoundRobinBalancesSymbols)
+{
+    auto ticks = make_ticks(9, 10);
+    sharded_runner<ShardEngine> runner{shard_config{.shards = 3}, make_shard(1000.0)};
+    runner.run(ticks);
+
+    for (size_t i = 0; i < runner.shard_count(); ++i)
+    {
+        EXPECT_EQ(runner.shard(i).symbols().size(), 3u);
+    }
+}
+
+TEST(ShardedRunnerTest, AssignPinsSymbols)
+{
+    auto ticks = make_ticks(4, 10);
+    sharded_runner<ShardEngine> runner{shard_config{.shards = 2}, make_shard(1000.0)};
+    for (size_t s = 0; s < 4; ++s)
+    {
+        runner.assign("SYM" + std::to_string(s), 1);
+    }
+    runner.run(ticks);
+
+    EXPECT_EQ(runner.shard(0).symbols().size(), 0u);
+    EXPECT_EQ(runner.shard(1).symbols().size(), 4u);
+    EXPECT_THROW(runner.assign("SYM0", 2), std::out_of_range);
+}
+
+TEST(ShardedRunnerTest, ConsolidatedPortfolioSumsShards)
+{
+    constexpr size_t symbols = 4;
+    constexpr size_t per_symbol = 100;
+    auto ticks = make_ticks(symbols, per_symbol);
+
+    sharded_runner<ShardEngine> runner{shard_config{.shards = 2, .publish_interval = 3}, make_shard(5000.0)};
+
+    // Published at construction, before any tick
+    EXPECT_DOUBLE_EQ(runner.portfolio().cash, 10000.0);
+
+    runner.run(ticks);
+
+    portfolio_totals expected;
+    for (size_t i = 0; i < runner.shard_count(); ++i)
+    {
+        const auto &pm = runner.shard(i).portfolio_manager();
+        EXPECT_DOUBLE_EQ(runner.shard_portfolio(i).equity, pm.total_equity());
+        expected += {pm.cash_balance(), pm.realized_pnl(), pm.unrealized_pnl(), pm.total_equity()};
+    }
+
+    const auto total = runner.portfolio();
+    EXPECT_DOUBLE_EQ(total.cash, expected.cash);
+    EXPECT_DOUBLE_EQ(total.equity, expected.equity);
+    EXPECT_DOUBLE_EQ(total.cash, 10000.0 - 10.0 * symbols * per_symbol);
+    EXPECT_DOUBLE_EQ(total.equity, 10000.0);
+}
+
+TEST(ShardedRunnerTest, ShardErrorIsRethrownAfterJoin)
+{
+    struct Throwing
+    {
+        void on_market(const market_event &ev)
+        {
+            if (ev.timestamp_ms_ == 5)
+                throw std::runtime_error("strategy failed");
+        }
+    };
+    struct ThrowingEngine : engine_base<ThrowingEngine, shard_feed, Throwing, FillAll>
+    {
+        using engine_base<ThrowingEngine, shard_feed, Throwing, FillAll>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    // Small rings so the router must skip the failed shard to finish
+    auto ticks = make_ticks(2, 1000);
+    sharded_runner<ThrowingEngine> runner{shard_config{.shards = 2, .ring_capacity = 8}, [](size_t, shard_feed feed)
+                                          { return std::make_unique<ThrowingEngine>(std::move(feed), Throwing{}, portfolio::portfolio_manager{}, FillAll{}); }};
+    EXPECT_THROW(runner.run(ticks), std::runtime_error);
+}
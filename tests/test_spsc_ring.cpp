@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "concurrency/spsc_ring.hpp"
+
+#include <thread>
+
+using namespace engine::concurrency;
+
+TEST(SpscRingTest, CapacityRoundsToPowerOfTwo)
+{
+    spsc_ring<int> ring{5};
+    EXPECT_EQ(ring.capacity(), 8u);
+}
+
+TEST(SpscRingTest, FullRingCountsProducerStall)
+{
+    spsc_ring<int> ring{2};
+    EXPECT_TRUE(ring.try_push(1));
+    EXPECT_TRUE(ring.try_push(2));
+    EXPECT_FALSE(ring.try_push(3));
+    EXPECT_EQ(ring.producer_stalls(), 1u);
+
+    int v;
+    EXPECT_TRUE(ring.try_pop(v));
+    EXPECT_EQ(v, 1);
+    EXPECT_TRUE(ring.try_push(3));
+}
+
+TEST(SpscRingTest, TransfersAcrossThreadsInOrder)
+{
+    spsc_ring<int64_t> ring{8};
+    constexpr int64_t count = 10000;
+
+    std::thread producer([&]
+                         {
+        for (int64_t i = 0; i < count; ++i)
+        {
+            while (!ring.try_push(i))
+            {
+                std::this_thread::yield();
+            }
+        } });
+
+    int64_t expected = 0;
+    while (expected < count)
+    {
+        int64_t v;
+        if (ring.try_pop(v))
+        {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ring.empty());
+    int64_t v;
+    EXPECT_FALSE(ring.try_pop(v));
+    EXPECT_GT(ring.consumer_idle_spins(), 0u);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "concurrency/work_stealing.hpp"
+#include "engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "journal/journal_streamer.hpp"
+#include "journal/journal_writer.hpp"
+#include "sweep/sweep_runner.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+
+namespace
+{
+    // Buys a fixed size every n ticks
+    struct EveryNth
+    {
+        struct params
+        {
+            int64_t every;
+            int64_t size;
+        };
+
+        explicit EveryNth(const params &p) : p_(p) {}
+
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            if (++seen_ % p_.every == 0)
+            {
+                q.push(order_event{ev.symbol_, static_cast<order_id>(seen_), p_.size, true, ev.price_, order_type::Market, order_flags::None});
+            }
+        }
+
+        params p_;
+        int64_t seen_ = 0;
+    };
+
+    struct FillAtPrice
+    {
+        void on_order(const order_event &order, event_queue &q)
+        {
+            q.push(fill_event{order.symbol_, order.order_id_, order.quantity_, order.quantity_, order.is_buy_, order.price_, q.payloads().retain(order)});
+        }
+    };
+
+    struct SweepEngine : engine_base<SweepEngine, ingest::tick_cursor, EveryNth, FillAtPrice, timing::sim_clock>
+    {
+        using engine_base<SweepEngine, ingest::tick_cursor, EveryNth, FillAtPrice, timing::sim_clock>::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+
+    ingest::tick_buffer make_ticks(size_t count)
+    {
+        ingest::tick_buffer buffer;
+        for (size_t i = 0; i < count; ++i)
+        {
+            buffer.add(i % 2 ? "ETHUSD" : "BTCUSD", 10.0, 1.0, static_cast<int64_t>(i), false);
+        }
+        return buffer;
+    }
+} // namespace
+
+TEST(WorkStealingTest, RunsEveryIndexOnce)
+{
+    constexpr size_t count = 10'000;
+    std::vector<std::atomic<int>> hits(count);
+    concurrency::parallel_for(count, 4, [&](size_t i, size_t)
+                              {
+        hits[i].fetch_add(1);
+        if (i % 512 == 0)
+            std::this_thread::yield(); });
+
+    for (const auto &h : hits)
+    {
+        EXPECT_EQ(h.load(), 1);
+    }
+}
+
+TEST(WorkStealingTest, IdleWorkersStealFromBusyOnes)
+{
+    // Worker 0's initial share is slow, the others must take part of it
+    constexpr size_t count = 64;
+    std::vector<size_t> ran_on(count);
+    concurrency::parallel_for(count, 4, [&](size_t i, size_t worker)
+                              {
+        ran_on[i] = worker;
+        if (i < count / 4)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1}); });
+
+    size_t stolen = 0;
+    for (size_t i = 0; i < count / 4; ++i)
+    {
+        stolen += ran_on[i] != 0 ? 1u : 0u;
+    }
+    EXPECT_GT(stolen, 0u);
+}
+
+TEST(WorkStealingTest, FirstErrorIsRethrown)
+{
+    // Jobs past the failing one wait for it and then take a while, so the pool cannot finish
+    // everything while the exception unwinds
+    std::atomic<size_t> ran{0};
+    std::atomic<bool> thrown{false};
+    EXPECT_THROW(concurrency::parallel_for(1000, 3, [&](size_t i, size_t)
+                                           {
+        ++ran;
+        if (i == 10)
+        {
+            thrown = true;
+            throw std::runtime_error("job failed");
+        }
+        while (i > 10 && !thrown)
+            std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::microseconds{100}); }),
+                 std::runtime_error);
+    EXPECT_LT(ran.load(), 1000u);
+    EXPECT_NO_THROW(concurrency::parallel_for(0, 3, [](size_t, size_t) {}));
+}
+
+TEST(SweepRunnerTest, OneResultPerParameterSetInOrder)
+{
+    const auto ticks = make_ticks(1000);
+    std::vector<EveryNth::params> params;
+    for (int64_t every = 1; every <= 20; ++every)
+    {
+        params.push_back({every, every % 3 + 1});
+    }
+
+    sweep::sweep_runner<SweepEngine> runner{ticks, 3};
+    const auto results = runner.run(params, [](const EveryNth::params &p, ingest::tick_cursor cursor)
+                                    { return std::make_unique<SweepEngine>(std::move(cursor), EveryNth{p}, portfolio::portfolio_manager{100000.0}, FillAtPrice{}); });
+
+    ASSERT_EQ(results.size(), params.size());
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        const auto fills = 1000 / static_cast<size_t>(params[i].every);
+        EXPECT_EQ(results[i].job, i);
+        EXPECT_EQ(results[i].fills, fills);
+        EXPECT_DOUBLE_EQ(results[i].cash, 100000.0 - 10.0 * static_cast<double>(fills * static_cast<size_t>(params[i].size)));
+        EXPECT_DOUBLE_EQ(results[i].equity, 100000.0);
+    }
+}
+
+TEST(SweepRunnerTest, CursorsShareTheBuffer)
+{
+    auto ticks = make_ticks(10);
+    auto a = ticks.cursor();
+    auto b = ticks.cursor();
+
+    std::array<ingest::tick_view, 4> batch;
+    EXPECT_EQ(a.next_batch(batch), 4u);
+    EXPECT_EQ(b.next_view()->timestamp_ms, 0);
+    EXPECT_EQ(a.next_view()->timestamp_ms, 4);
+    EXPECT_EQ(a.symbol_name(a.next_view()->symbol), "ETHUSD");
+    EXPECT_EQ(b.size(), 10u);
+}
+
+TEST(SweepRunnerTest, LoadsDatasetFromJournal)
+{
+    const auto path = std::filesystem::temp_directory_path() / "sweep_dataset.journal";
+    {
+        journal::journal_writer writer{path};
+        writer.define_symbol(0, "BTCUSD");
+        writer.define_symbol(1, "ETHUSD");
+        for (int64_t i = 0; i < 6; ++i)
+        {
+            writer.append(market_event{static_cast<symbols::symbol_id>(i % 2), 10.0 + static_cast<double>(i), 1.0, i, false});
+        }
+    }
+
+    journal::journal_streamer replay{path};
+    ingest::tick_buffer ticks;
+    ticks.load(replay);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(ticks.size(), 6u);
+    auto cursor = ticks.cursor();
+    const auto *first = cursor.next_view();
+    EXPECT_EQ(cursor.symbol_name(first->symbol), "BTCUSD");
+    EXPECT_DOUBLE_EQ(first->price, 10.0);
+    EXPECT_EQ(cursor.symbol_name(cursor.next_view()->symbol), "ETHUSD");
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "symbols/symbol_registry.hpp"
+
+using namespace engine::symbols;
+
+TEST(SymbolRegistryTest, InternAssignsDenseIds)
+{
+    symbol_registry reg;
+
+    EXPECT_EQ(reg.intern("BTCUSD"), 0u);
+    EXPECT_EQ(reg.intern("ETHUSD"), 1u);
+    EXPECT_EQ(reg.intern("SOLUSD"), 2u);
+    EXPECT_EQ(reg.size(), 3u);
+}
+
+TEST(SymbolRegistryTest, InternIsIdempotent)
+{
+    symbol_registry reg;
+
+    auto id = reg.intern("BTCUSD");
+    EXPECT_EQ(reg.intern(std::string("BTCUSD")), id);
+    EXPECT_EQ(reg.size(), 1u);
+}
+
+TEST(SymbolRegistryTest, NameRoundTrips)
+{
+    symbol_registry reg;
+
+    auto btc = reg.intern("BTCUSD");
+    auto eth = reg.intern("ETHUSD");
+    EXPECT_EQ(reg.name(btc), "BTCUSD");
+    EXPECT_EQ(reg.name(eth), "ETHUSD");
+}
+
+TEST(SymbolRegistryTest, FindDoesNotIntern)
+{
+    symbol_registry reg;
+    reg.intern("BTCUSD");
+
+    EXPECT_EQ(reg.find("BTCUSD"), 0u);
+    EXPECT_EQ(reg.find("DOGEUSD"), invalid_symbol);
+    EXPECT_EQ(reg.size(), 1u);
+}
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "engine_base.hpp"
+#include "ingest/tick_buffer.hpp"
+#include "timing/timer_wheel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace engine;
+using namespace engine::events;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Tags and due times fired by one advance
+    using firings = std::vector<std::pair<uint64_t, uint64_t>>;
+
+    firings advance(timing::timer_wheel &wheel, uint64_t now_ns)
+    {
+        firings out;
+        wheel.advance(now_ns, [&](timer_id, uint64_t tag, uint64_t due_ns)
+                      { out.emplace_back(tag, due_ns); });
+        return out;
+    }
+
+    // Arms a one shot timer on the first tick and a periodic one on the second
+    struct TimedStrategy
+    {
+        void on_market(const market_event &ev, event_queue &q)
+        {
+            const auto now_ns = static_cast<uint64_t>(ev.timestamp_ms_) * 1'000'000u;
+            if (++seen == 1)
+            {
+                q.timers().schedule(now_ns + 5'000'000u, 1);
+            }
+            else if (seen == 2)
+            {
+                periodic = q.timers().schedule(now_ns + 4'000'000u, 2, 4'000'000u);
+            }
+        }
+
+        void on_timer(const timer_event &ev, event_queue &q)
+        {
+            fired.push_back({ev.tag_, seen, ev.timestamp});
+            if (ev.tag_ == 2 && ++periodic_fired == 3)
+            {
+                q.timers().cancel(periodic);
+            }
+        }
+
+        struct firing
+        {
+            uint64_t tag;
+            int64_t ticks_seen;
+            timing::time_point due;
+        };
+
+        int64_t seen = 0;
+        int periodic_fired = 0;
+        timer_id periodic = invalid_timer;
+        std::vector<firing> fired;
+    };
+
+    struct NoExec
+    {
+    };
+
+    struct TimedEngine : engine_base<TimedEngine, ingest::tick_buffer, TimedStrategy, NoExec, timing::sim_clock>
+    {
+        using engine_base::engine_base;
+        bool should_stop() { return false; }
+        bool handle_no_event() { return false; }
+    };
+} // namespace
+
+TEST(TimerWheelTest, FiresDueTimersInDueOrder)
+{
+    timing::timer_wheel wheel{1ms};
+    for (uint64_t due_ms : {30u, 5u, 700u, 12u, 5u, 70000u})
+    {
+        wheel.schedule(due_ms * 1'000'000u, due_ms);
+    }
+    EXPECT_EQ(wheel.size(), 6u);
+
+    EXPECT_TRUE(advance(wheel, 4'999'999).empty());
+    EXPECT_EQ(advance(wheel, 12'000'000), (firings{{5, 5'000'000}, {5, 5'000'000}, {12, 12'000'000}}));
+    EXPECT_EQ(advance(wheel, 100'000'000'000), (firings{{30, 30'000'000}, {700, 700'000'000}, {70000, 70'000'000'000}}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, DueTimesRoundUpToResolution)
+{
+    timing::timer_wheel wheel{1ms};
+    wheel.schedule(2'000'001);
+    EXPECT_TRUE(advance(wheel, 2'999'999).empty());
+    EXPECT_EQ(advance(wheel, 3'000'000).size(), 1u);
+
+    // Already passed fires on the next tick
+    wheel.schedule(0);
+    EXPECT_TRUE(advance(wheel, 3'999'999).empty());
+    EXPECT_EQ(advance(wheel, 4'000'000).size(), 1u);
+}
+
+TEST(TimerWheelTest, CancelledAndStaleHandlesDoNotFire)
+{
+    timing::timer_wheel wheel{1ms};
+    const auto a = wheel.schedule(10'000'000, 1);
+    const auto b = wheel.schedule(10'000'000, 2);
+    const auto far = wheel.schedule(5'000'000'000'000, 3);
+    EXPECT_TRUE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.cancel(a));
+    EXPECT_TRUE(wheel.cancel(far));
+    EXPECT_FALSE(wheel.cancel(invalid_timer));
+
+    EXPECT_EQ(advance(wheel, 20'000'000), (firings{{2, 10'000'000}}));
+    EXPECT_FALSE(wheel.cancel(b));
+
+    // Reused nodes get fresh handles
+    const auto c = wheel.schedule(30'000'000, 4);
+    EXPECT_NE(c, a);
+    EXPECT_NE(c, b);
+    EXPECT_FALSE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.cancel(b));
+    EXPECT_EQ(wheel.size(), 1u);
+    EXPECT_EQ(advance(wheel, 6'000'000'000'000).size(), 1u);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PeriodicTimerRearmsUntilCancelled)
+{
+    timing::timer_wheel wheel{1ms};
+    const auto id = wheel.schedule(10'000'000, 7, 10'000'000);
+
+    // Fires once for the periods it slept through and keeps its phase
+    EXPECT_EQ(advance(wheel, 35'000'000), (firings{{7, 10'000'000}}));
+    EXPECT_EQ(wheel.size(), 1u);
+    EXPECT_EQ(advance(wheel, 39'000'000), firings{});
+    EXPECT_EQ(advance(wheel, 40'000'000), (firings{{7, 40'000'000}}));
+
+    // Cancelling from its own callback stops it
+    size_t fired = wheel.advance(100'000'000, [&](timer_id fired_id, uint64_t, uint64_t)
+                                 { EXPECT_TRUE(wheel.cancel(fired_id)); });
+    EXPECT_EQ(fired, 1u);
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PeriodicTimerSkipsPeriodsMissedInAJump)
+{
+    timing::timer_wheel wheel{1ms};
+    wheel.schedule(0, 1, 1'000'000);
+    wheel.schedule(5'000'000, 2, 1'000'000);
+
+    // Hours of missed 1 ms periods, from epoch 0, are one firing each
+    const uint64_t later = uint64_t{3} * 3600 * 1'000'000'000 + 500'000;
+    EXPECT_EQ(advance(wheel, later), (firings{{1, 0}, {2, 5'000'000}}));
+    EXPECT_EQ(wheel.size(), 2u);
+
+    // Then on the next period boundary after the jump, together in no set order
+    auto next = advance(wheel, later + 500'000);
+    std::sort(next.begin(), next.end());
+    EXPECT_EQ(next, (firings{{1, later + 500'000}, {2, later + 500'000}}));
+}
+
+TEST(TimerWheelTest, CascadesMatchSortedDueTimes)
+{
+    // Nanosecond ticks spread over every level
+    timing::timer_wheel wheel{1ns};
+    std::mt19937_64 rng{42};
+    std::vector<std::pair<uint64_t, uint64_t>> due;
+    for (uint64_t tag = 0; tag < 5000; ++tag)
+    {
+        const auto bits = rng() % 56;
+        const uint64_t at = 1 + rng() % (uint64_t{1} << bits);
+        due.emplace_back(at, tag);
+        wheel.schedule(at, tag);
+    }
+    std::sort(due.begin(), due.end());
+
+    // Advance in uneven steps, each firing exactly what fell due
+    uint64_t now = 0;
+    size_t next = 0;
+    while (!wheel.empty())
+    {
+        now = now * 3 + rng() % 1000;
+        wheel.advance(now, [&](timer_id, uint64_t tag, uint64_t due_ns)
+                      {
+            ASSERT_LT(next, due.size());
+            EXPECT_LE(due_ns, now);
+            EXPECT_EQ(due_ns, due[next].first);
+            if (due_ns == due[next].first && tag != due[next].second)
+            {
+                // Ties fire in any order, check the tag is among them
+                auto tie = std::find(due.begin() + static_cast<std::ptrdiff_t>(next), due.end(), std::pair{due_ns, tag});
+                ASSERT_NE(tie, due.end());
+                std::iter_swap(due.begin() + static_cast<std::ptrdiff_t>(next), tie);
+            }
+            ++next; });
+        for (size_t i = next; i < due.size(); ++i)
+        {
+            ASSERT_GT(due[i].first, now);
+        }
+    }
+    EXPECT_EQ(next, due.size());
+}
+
+TEST(TimerWheelTest, RoundTripKeepsPendingTimersAndHandles)
+{
+    timing::timer_wheel wheel{1ms};
+    const auto a = wheel.schedule(10'000'000, 1);
+    const auto b = wheel.schedule(400'000'000, 2, 100'000'000);
+    wheel.schedule(90'000'000'000, 3);
+    const auto gone = wheel.schedule(50'000'000, 4);
+    wheel.cancel(gone);
+    advance(wheel, 20'000'000);
+
+    checkpoint::snapshot_writer out;
+    wheel.save(out);
+    checkpoint::snapshot_reader in{out.bytes()};
+    timing::timer_wheel restored{1s};
+    restored.schedule(1, 9);
+    restored.restore(in);
+
+    EXPECT_EQ(restored.size(), 2u);
+    EXPECT_EQ(restored.resolution(), 1'000'000u);
+    EXPECT_FALSE(restored.cancel(a));
+    EXPECT_FALSE(restored.cancel(gone));
+    EXPECT_EQ(advance(restored, 450'000'000), (firings{{2, 400'000'000}}));
+    EXPECT_EQ(advance(restored, 550'000'000), (firings{{2, 500'000'000}}));
+    EXPECT_TRUE(restored.cancel(b));
+    EXPECT_EQ(advance(restored, 100'000'000'000), (firings{{3, 90'000'000'000}}));
+}
+
+TEST(TimerWheelTest, CorruptSnapshotIsRejectedAndLeavesWheelAsItWas)
+{
+    timing::timer_wheel wheel{1ms};
+    wheel.schedule(10'000'000, 1);
+    wheel.schedule(400'000'000, 2);
+    advance(wheel, 20'000'000);
+
+    checkpoint::snapshot_writer out;
+    wheel.save(out);
+    const auto bytes = out.bytes();
+    // Header and section tag, then resolution, current tick, count and free list head
+    const auto resolution_at = sizeof(checkpoint::snapshot_header) + sizeof(uint32_t);
+    const auto count_at = resolution_at + 2 * sizeof(uint64_t);
+    const auto free_at = count_at + sizeof(uint64_t);
+
+    timing::timer_wheel restored{1s};
+    restored.schedule(1, 9);
+    const auto corrupt = [&](size_t at, auto value)
+    {
+        std::vector<std::byte> copy(bytes.begin(), bytes.end());
+        std::memcpy(copy.data() + at, &value, sizeof(value));
+        checkpoint::snapshot_reader in{copy};
+        EXPECT_THROW(restored.restore(in), std::runtime_error);
+    };
+    corrupt(resolution_at, uint64_t{0});
+    corrupt(count_at, uint64_t{5});
+    corrupt(free_at, uint32_t{1000});
+
+    EXPECT_EQ(restored.resolution(), 1'000'000'000u);
+    EXPECT_EQ(advance(restored, 1'000'000'000), (firings{{9, 1}}));
+
+    checkpoint::snapshot_reader in{bytes};
+    restored.restore(in);
+    EXPECT_EQ(advance(restored, 1'000'000'000), (firings{{2, 400'000'000}}));
+}
+
+TEST(TimerWheelTest, EngineDeliversTimersInTickTime)
+{
+    ingest::tick_buffer ticks;
+    for (int64_t ms = 0; ms < 20; ++ms)
+    {
+        ticks.add("BTCUSD", 100.0, 1.0, ms, false);
+    }
+
+    TimedEngine engine{std::move(ticks), TimedStrategy{}, portfolio::portfolio_manager{1000.0}, NoExec{}};
+    engine.run();
+
+    // One shot armed at 0ms for 5ms, periodic armed at 1ms every 4ms and cancelled after three
+    const auto &fired = engine.strategy().fired;
+    ASSERT_EQ(fired.size(), 4u);
+    EXPECT_EQ(fired[0].tag + fired[1].tag, 3u);
+    EXPECT_EQ(fired[0].due, timing::time_point{5ms});
+    EXPECT_EQ(fired[1].due, timing::time_point{5ms});
+    EXPECT_EQ(fired[2].due, timing::time_point{9ms});
+    EXPECT_EQ(fired[3].tag, 2u);
+    EXPECT_EQ(fired[3].due, timing::time_point{13ms});
+
+    // Each fires ahead of the first tick at its due time
+    EXPECT_EQ(fired[0].ticks_seen, 5);
+    EXPECT_EQ(fired[1].ticks_seen, 5);
+    EXPECT_EQ(fired[2].ticks_seen, 9);
+    EXPECT_EQ(fired[3].ticks_seen, 13);
+    EXPECT_TRUE(engine.timers().empty());
+}